@@ -5,7 +5,8 @@
 #include <iomanip>  // Added for debug output
 
 AIController::AIController()
-    : fitness(0.0), isAlive(true), checkpointsHit(0), timeAlive(0.0f)
+    : fitness(0.0), isAlive(true), finished(false), checkpointsHit(0), timeAlive(0.0f),
+      lapsCompleted(0), totalLapTime(0.0f)
 {
 }
 
@@ -15,7 +16,7 @@ void AIController::initialize(int numInputs, int numOutputs, int numHidden)
     resetFitness();
 }
 
-void AIController::controlCar(Car &car, const std::vector<float> &rayDistances)
+void AIController::controlCar(Car &car, const std::vector<float> &rayDistances, float sensorRange)
 {
     if (!isAlive)
         return;
@@ -26,8 +27,8 @@ void AIController::controlCar(Car &car, const std::vector<float> &rayDistances)
     // Add ray distances as inputs (normalized to 0-1 range)
     for (float distance : rayDistances)
     {
-        // Normalize distance (0 = close, 1 = far)
-        double normalizedDistance = std::min(1.0, distance / 200.0); // 200 is max ray length
+        // Normalize distance (0 = close, 1 = a ray that reaches its full range)
+        double normalizedDistance = std::min(1.0, static_cast<double>(distance) / sensorRange);
         inputs.push_back(normalizedDistance);
     }
 
@@ -76,6 +77,13 @@ void AIController::updateFitness(float deltaTime)
         double speedBonus = ((checkpointsHit * checkpointsHit) / timeAlive) * 100.0;
 
         fitness = checkpointReward + speedBonus;
+
+        // Race mode reward: completed laps weighted by the average lap pace
+        if (lapsCompleted > 0 && totalLapTime > 0.0f)
+        {
+            double averageLapTime = totalLapTime / lapsCompleted;
+            fitness += lapsCompleted * (1.0e7 / averageLapTime);
+        }
     }
     else
     {
@@ -89,6 +97,9 @@ void AIController::resetFitness()
     checkpointsHit = 0;
     timeAlive = 0.0f;
     isAlive = true;
+    finished = false;
+    lapsCompleted = 0;
+    totalLapTime = 0.0f;
 }
 
 void AIController::reset(const sf::Vector2f &position, float rotation)
@@ -10,8 +10,11 @@ private:
     NeuralNetwork brain;
     double fitness;
     bool isAlive;
+    bool finished; // Completed every lap of the race
     int checkpointsHit;
     float timeAlive;
+    int lapsCompleted;
+    float totalLapTime;
     sf::Vector2f startPosition;
     float startRotation;
 
@@ -21,8 +24,8 @@ public:
     // Initialize the AI with a neural network
     void initialize(int numInputs, int numOutputs, int numHidden = 4);
 
-    // Control the car based on sensor inputs
-    void controlCar(Car &car, const std::vector<float> &rayDistances);
+    // Control the car based on sensor inputs (ray distances of at most sensorRange pixels)
+    void controlCar(Car &car, const std::vector<float> &rayDistances, float sensorRange);
 
     // Fitness evaluation
     void updateFitness(float deltaTime);
@@ -32,6 +35,8 @@ public:
     // Life management
     bool isCarAlive() const { return isAlive; }
     void kill() { isAlive = false; }
+    void markFinished() { finished = true; isAlive = false; }
+    bool hasFinished() const { return finished; }
     void reset(const sf::Vector2f &position, float rotation);
 
     // Checkpoint tracking
@@ -40,6 +45,11 @@ public:
     void setCheckpointsHit(int count) { checkpointsHit = count; }
     float getTimeAlive() const { return timeAlive; }
 
+    // Lap tracking (race mode)
+    void setLapStats(int laps, float lapTimeTotal) { lapsCompleted = laps; totalLapTime = lapTimeTotal; }
+    int getLapsCompleted() const { return lapsCompleted; }
+    float getAverageLapTime() const { return lapsCompleted > 0 ? totalLapTime / lapsCompleted : 0.0f; }
+
     // Genetic operations
     void mutate() { brain.mutate(); }
     AIController crossover(const AIController &other) const;
@@ -0,0 +1,202 @@
+#include "FrozenNetwork.h"
+#include "NeuralNetwork.h"
+#include "../Persistence/BinaryIO.h"
+#include "../Persistence/CheckpointWriter.h"
+#include <algorithm>
+#include <cmath>
+
+FrozenNetwork::FrozenNetwork() : inputCount(0), outputCount(0)
+{
+}
+
+FrozenNetwork FrozenNetwork::fromGenome(const NeuralNetwork &genome)
+{
+    FrozenNetwork frozen;
+    const auto &inputNodes = genome.getInputNodes();
+    const auto &hiddenNodes = genome.getHiddenNodes();
+    const auto &outputNodes = genome.getOutputNodes();
+    frozen.inputCount = static_cast<std::uint32_t>(inputNodes.size());
+    frozen.outputCount = static_cast<std::uint32_t>(outputNodes.size());
+
+    // Value slot of every node that has been evaluated so far (-1 reads as 0 in NeuralNetwork::process)
+    int maxNodeId = -1;
+    for (const std::vector<int> *ids : {&inputNodes, &hiddenNodes, &outputNodes})
+    {
+        for (int id : *ids)
+            maxNodeId = std::max(maxNodeId, id);
+    }
+    std::vector<int> slotOf(maxNodeId + 1, -1);
+    for (std::size_t i = 0; i < inputNodes.size(); ++i)
+    {
+        slotOf[inputNodes[i]] = static_cast<int>(i);
+    }
+
+    // Same order as process(): hidden nodes in genome order, then the outputs
+    // A connection from a node that isn't evaluated yet always reads 0 there, so it's dropped
+    auto addNode = [&frozen, &genome, &slotOf](int nodeId)
+    {
+        Node node;
+        node.activation = Activation::Tanh;
+        node.bias = static_cast<float>(genome.getNodeBias(nodeId));
+        node.firstConnection = static_cast<std::uint32_t>(frozen.weights.size());
+        for (const auto &conn : genome.getConnections())
+        {
+            if (conn.enabled && conn.toNode == nodeId && conn.fromNode >= 0 &&
+                conn.fromNode < static_cast<int>(slotOf.size()) && slotOf[conn.fromNode] >= 0)
+            {
+                frozen.sources.push_back(static_cast<std::uint32_t>(slotOf[conn.fromNode]));
+                frozen.weights.push_back(static_cast<float>(conn.weight));
+            }
+        }
+        node.connectionCount = static_cast<std::uint32_t>(frozen.weights.size()) - node.firstConnection;
+        frozen.nodes.push_back(node);
+    };
+
+    for (int hiddenId : hiddenNodes)
+    {
+        addNode(hiddenId);
+        slotOf[hiddenId] = static_cast<int>(frozen.inputCount + frozen.nodes.size() - 1);
+    }
+
+    // Outputs only become readable after all of them are computed (outputs never feed each other)
+    for (int outputId : outputNodes)
+    {
+        addNode(outputId);
+    }
+
+    frozen.scratch.resize(frozen.getScratchSize());
+    return frozen;
+}
+
+bool FrozenNetwork::saveToFile(const std::string &path) const
+{
+    std::vector<char> data;
+    BinaryWriter writer(data);
+    writer.writeU32(Magic);
+    writer.writeU32(Version);
+    writer.writeU32(inputCount);
+    writer.writeU32(outputCount);
+
+    writer.writeU32(static_cast<std::uint32_t>(nodes.size()));
+    for (const auto &node : nodes)
+    {
+        writer.writeU8(static_cast<std::uint8_t>(node.activation));
+        writer.writeF32(node.bias);
+        writer.writeU32(node.firstConnection);
+        writer.writeU32(node.connectionCount);
+    }
+
+    writer.writeU32(static_cast<std::uint32_t>(weights.size()));
+    for (std::size_t i = 0; i < weights.size(); ++i)
+    {
+        writer.writeU32(sources[i]);
+        writer.writeF32(weights[i]);
+    }
+
+    return CheckpointWriter::writeFileAtomically(path, data);
+}
+
+bool FrozenNetwork::loadFromFile(const std::string &path)
+{
+    std::vector<char> data;
+    if (!CheckpointWriter::readFile(path, data))
+        return false;
+    return loadFromMemory(data.data(), data.size());
+}
+
+bool FrozenNetwork::loadFromMemory(const void *data, std::size_t size)
+{
+    BinaryReader reader(data, size);
+    if (reader.readU32() != Magic || reader.readU32() != Version)
+        return false;
+
+    FrozenNetwork loaded;
+    loaded.inputCount = reader.readU32();
+    loaded.outputCount = reader.readU32();
+
+    std::uint32_t nodeCount = reader.readCount(13);
+    loaded.nodes.resize(nodeCount);
+    for (auto &node : loaded.nodes)
+    {
+        std::uint8_t activation = reader.readU8();
+        if (activation > static_cast<std::uint8_t>(Activation::Identity))
+            reader.fail();
+        node.activation = static_cast<Activation>(activation);
+        node.bias = reader.readF32();
+        node.firstConnection = reader.readU32();
+        node.connectionCount = reader.readU32();
+    }
+
+    std::uint32_t connectionCount = reader.readCount(8);
+    loaded.sources.resize(connectionCount);
+    loaded.weights.resize(connectionCount);
+    for (std::uint32_t i = 0; i < connectionCount; ++i)
+    {
+        loaded.sources[i] = reader.readU32();
+        loaded.weights[i] = reader.readF32();
+    }
+
+    // The input limit is far above any sensor count, it only guards the scratch allocation
+    const std::uint32_t maxInputs = 1u << 20;
+    if (!reader.ok() || loaded.outputCount > nodeCount || loaded.inputCount > maxInputs)
+        return false;
+
+    // Every connection must stay inside the arrays and read a slot that is already computed,
+    // then evaluate() needs no checks of its own
+    for (std::uint32_t i = 0; i < nodeCount; ++i)
+    {
+        const Node &node = loaded.nodes[i];
+        if (node.firstConnection > connectionCount || node.connectionCount > connectionCount - node.firstConnection)
+            return false;
+        for (std::uint32_t c = node.firstConnection; c < node.firstConnection + node.connectionCount; ++c)
+        {
+            if (loaded.sources[c] >= loaded.inputCount + i)
+                return false;
+        }
+    }
+
+    loaded.scratch.resize(loaded.getScratchSize());
+    *this = std::move(loaded);
+    return true;
+}
+
+void FrozenNetwork::evaluate(const float *inputs, float *outputs, float *scratchValues) const
+{
+    std::copy(inputs, inputs + inputCount, scratchValues);
+
+    float *nodeValues = scratchValues + inputCount;
+    for (std::size_t i = 0; i < nodes.size(); ++i)
+    {
+        const Node &node = nodes[i];
+        float sum = node.bias;
+        const std::uint32_t end = node.firstConnection + node.connectionCount;
+        for (std::uint32_t c = node.firstConnection; c < end; ++c)
+        {
+            sum += scratchValues[sources[c]] * weights[c];
+        }
+
+        switch (node.activation)
+        {
+        case Activation::Tanh:
+            nodeValues[i] = std::tanh(sum);
+            break;
+        case Activation::Sigmoid:
+            nodeValues[i] = 1.0f / (1.0f + std::exp(-sum));
+            break;
+        case Activation::ReLU:
+            nodeValues[i] = std::max(0.0f, sum);
+            break;
+        case Activation::Identity:
+            nodeValues[i] = sum;
+            break;
+        }
+    }
+
+    // The outputs are the last nodes
+    std::copy(nodeValues + nodes.size() - outputCount, nodeValues + nodes.size(), outputs);
+}
+
+void FrozenNetwork::evaluate(const float *inputs, float *outputs)
+{
+    evaluate(inputs, outputs, scratch.data());
+}
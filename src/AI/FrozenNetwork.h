@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class NeuralNetwork;
+
+// Activation function of a node in a frozen network (stored as one byte per node)
+enum class Activation : std::uint8_t
+{
+    Tanh = 0,
+    Sigmoid = 1,
+    ReLU = 2,
+    Identity = 3
+};
+
+// Inference-only copy of a genome for embedding trained drivers in other tools
+// Nodes are stored in evaluation order with their incoming weights packed into one float array,
+// disabled connections and innovation numbers are dropped. Evaluating never allocates.
+//
+// File (.rcnet, little endian): magic "RCFN", u32 version, u32 inputs, u32 outputs, u32 node count,
+// per node: u8 activation, f32 bias, u32 first connection, u32 connection count,
+// u32 connection count, per connection: u32 source slot, f32 weight.
+// Slots 0..inputs-1 are the inputs, then one slot per node; the last `outputs` nodes are the outputs.
+class FrozenNetwork
+{
+private:
+    struct Node
+    {
+        Activation activation;
+        float bias;
+        std::uint32_t firstConnection;
+        std::uint32_t connectionCount;
+    };
+
+    std::uint32_t inputCount;
+    std::uint32_t outputCount;
+    std::vector<Node> nodes;
+    std::vector<std::uint32_t> sources; // Value slot read by each connection
+    std::vector<float> weights;         // Parallel to sources
+    std::vector<float> scratch;         // Slot values for evaluate() without a caller buffer
+
+public:
+    static constexpr std::uint32_t Magic = 0x4E464352; // "RCFN" in file order
+    static constexpr std::uint32_t Version = 1;
+
+    FrozenNetwork();
+
+    // Freeze a genome, evaluating gives the same outputs as NeuralNetwork::process (in float precision)
+    static FrozenNetwork fromGenome(const NeuralNetwork &genome);
+
+    bool saveToFile(const std::string &path) const;
+    bool loadFromFile(const std::string &path); // Leaves the network unchanged on failure
+    bool loadFromMemory(const void *data, std::size_t size);
+
+    // Run the network: inputs has getInputCount() values, outputs receives getOutputCount() values
+    // The scratch version is const and thread safe (scratch holds getScratchSize() floats)
+    void evaluate(const float *inputs, float *outputs, float *scratchValues) const;
+    void evaluate(const float *inputs, float *outputs);
+
+    std::uint32_t getInputCount() const { return inputCount; }
+    std::uint32_t getOutputCount() const { return outputCount; }
+    std::size_t getNodeCount() const { return nodes.size(); }
+    std::size_t getConnectionCount() const { return weights.size(); }
+    std::size_t getScratchSize() const { return inputCount + nodes.size(); }
+};
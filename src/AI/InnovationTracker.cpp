@@ -1,4 +1,5 @@
 #include "InnovationTracker.h"
+#include "../Persistence/BinaryIO.h"
 #include <algorithm>
 
 InnovationTracker::InnovationTracker() : nextInnovationNumber(0)
@@ -60,4 +61,43 @@ void InnovationTracker::reset()
 {
     innovations.clear();
     nextInnovationNumber = 0;
-} 
\ No newline at end of file
+} 
+
+void InnovationTracker::serialize(BinaryWriter &writer) const
+{
+    writer.writeI32(nextInnovationNumber);
+    writer.writeU32(static_cast<std::uint32_t>(innovations.size()));
+    for (const auto& innovation : innovations)
+    {
+        writer.writeI32(innovation.innovationNumber);
+        writer.writeI32(innovation.fromNode);
+        writer.writeI32(innovation.toNode);
+        writer.writeBool(innovation.isNode);
+        writer.writeI32(innovation.nodeId);
+    }
+}
+
+bool InnovationTracker::deserialize(BinaryReader &reader)
+{
+    int loadedNext = reader.readI32();
+    std::uint32_t count = reader.readCount(17);
+
+    std::vector<Innovation> loaded;
+    loaded.reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        int number = reader.readI32();
+        int from = reader.readI32();
+        int to = reader.readI32();
+        bool isNode = reader.readBool();
+        int nodeId = reader.readI32();
+        loaded.emplace_back(number, from, to, isNode, nodeId);
+    }
+
+    if (!reader.ok())
+        return false;
+
+    innovations = std::move(loaded);
+    nextInnovationNumber = loadedNext;
+    return true;
+}
\ No newline at end of file
@@ -3,6 +3,9 @@
 #include <unordered_map>
 #include <string>
 
+class BinaryWriter;
+class BinaryReader;
+
 struct Innovation
 {
     int innovationNumber;
@@ -38,6 +41,10 @@ public:
     
     // Reset for new generation
     void reset();
+
+    // Binary history (returns false and keeps the current history if the data is invalid)
+    void serialize(BinaryWriter &writer) const;
+    bool deserialize(BinaryReader &reader);
     
     // Getters
     int getNextInnovationNumber() const { return nextInnovationNumber; }
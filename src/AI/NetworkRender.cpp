@@ -1,10 +1,10 @@
 #include "NetworkRender.h"
-#include <iostream>
-#include <sstream>
-#include <iomanip>
+#include <algorithm>
+#include <cmath>
 
 NetworkRender::NetworkRender()
-    : nodeRadius(12.0f), connectionWidth(2.0f), nodeSpacing(35.0f), layerSpacing(80.0f),
+    : connectionVertices(sf::PrimitiveType::Triangles), nodeVertices(sf::PrimitiveType::Triangles),
+      nodeRadius(12.0f), connectionWidth(2.0f), nodeSpacing(35.0f), layerSpacing(80.0f), circleSegments(16),
       inputNodeColor(100, 150, 255), hiddenNodeColor(255, 200, 100), outputNodeColor(100, 255, 150),
       connectionColor(200, 200, 200), position(0, 0), size(400, 300)
 {
@@ -12,168 +12,143 @@ NetworkRender::NetworkRender()
 
 void NetworkRender::setNetwork(const NeuralNetwork &network)
 {
-    // Clear existing visuals
-    nodes.clear();
-    connections.clear();
-
-    // Create new visuals
-    createNodeVisuals(network);
-    createConnectionVisuals(network);
-
-    // Layout everything
-    layoutNodes();
-    layoutConnections();
-
-    // Update text
-    updateValues(network);
-}
-
-void NetworkRender::updateValues(const NeuralNetwork &network)
-{
-    // Update connection colors based on weights
-    for (auto &conn : connections)
+    // Nodes only change when a hidden node was added (or a different sized network is shown)
+    bool nodesChanged = !hasSameNodes(network);
+    if (nodesChanged)
     {
-        conn.shape.setFillColor(getWeightColor(conn.weight));
+        createNodeVisuals(network);
+        layoutNodes();
     }
-}
 
-void NetworkRender::createNodeVisuals(const NeuralNetwork &network)
-{
-    // Get actual network structure from the neural network
-    int numInputs = network.getNumInputs();
-    int numOutputs = network.getNumOutputs();
-    int numHidden = network.getNumHidden();
+    collectConnections(network);
 
-    // Create input nodes
-    for (int i = 0; i < numInputs; ++i)
+    // Same connections in the same order (by innovation number) means the geometry can stay
+    bool topologyChanged = nodesChanged || incoming.size() != connections.size();
+    for (std::size_t i = 0; !topologyChanged && i < incoming.size(); ++i)
     {
-        NodeVisual node;
-        node.shape.setRadius(nodeRadius);
-        node.shape.setFillColor(inputNodeColor);
-        node.shape.setOutlineColor(sf::Color::Black);
-        node.shape.setOutlineThickness(2.0f);
-
-        node.nodeId = i;
-        node.isInput = true;
-        node.isOutput = false;
-        node.isHidden = false;
-
-        nodes.push_back(node);
+        topologyChanged = incoming[i].innovationNumber != connections[i].innovationNumber ||
+                          incoming[i].fromNode != connections[i].fromNode ||
+                          incoming[i].toNode != connections[i].toNode;
     }
 
-    // Create hidden nodes (if any exist)
-    // Note: We'll need to add a getter for hidden nodes in NeuralNetwork
-    // For now, we'll calculate based on total nodes minus inputs and outputs
-    // int totalNodes = numInputs + numOutputs; // This will be updated when we add hidden node getter
-    // int numHidden = totalNodes - numInputs - numOutputs;
-
-    for (int i = 0; i < numHidden; ++i)
+    if (topologyChanged)
     {
-        NodeVisual node;
-        node.shape.setRadius(nodeRadius);
-        node.shape.setFillColor(hiddenNodeColor);
-        node.shape.setOutlineColor(sf::Color::Black);
-        node.shape.setOutlineThickness(2.0f);
-
-        node.nodeId = numInputs + i; // Start after input nodes
-        node.isInput = false;
-        node.isOutput = false;
-        node.isHidden = true;
-
-        nodes.push_back(node);
+        connections.swap(incoming);
+        layoutConnections();
+        return;
     }
 
-    // Create output nodes
-    for (int i = 0; i < numOutputs; ++i)
+    // Only recolor connections whose weight or enabled state changed
+    for (std::size_t i = 0; i < connections.size(); ++i)
     {
-        NodeVisual node;
-        node.shape.setRadius(nodeRadius);
-        node.shape.setFillColor(outputNodeColor);
-        node.shape.setOutlineColor(sf::Color::Black);
-        node.shape.setOutlineThickness(2.0f);
-
-        node.nodeId = numInputs + numHidden + i; // Start after input and hidden nodes
-        node.isInput = false;
-        node.isOutput = true;
-        node.isHidden = false;
-
-        nodes.push_back(node);
+        if (incoming[i].weight != connections[i].weight || incoming[i].enabled != connections[i].enabled)
+        {
+            connections[i].weight = incoming[i].weight;
+            connections[i].enabled = incoming[i].enabled;
+            colorConnection(i);
+        }
     }
 }
 
-void NetworkRender::createConnectionVisuals(const NeuralNetwork &network)
+void NetworkRender::updateValues(const NeuralNetwork &network)
 {
-    // We need to add getters to NeuralNetwork to access actual connections
-    // For now, we'll create a simple visualization based on the network structure
-    // This will be updated when we add connection getters to NeuralNetwork
-    
-    int numInputs = network.getNumInputs();
-    int numHidden = network.getNumHidden();
-    int numOutputs = network.getNumOutputs();
-    
-    // Create connections from inputs to hidden nodes (if hidden nodes exist)
-    if (numHidden > 0)
-    {
-        for (int input = 0; input < numInputs; ++input)
-        {
-            for (int hidden = 0; hidden < numHidden; ++hidden)
-            {
-                ConnectionVisual conn;
-                conn.shape.setSize(sf::Vector2f(connectionWidth, 0)); // Will be set in layoutConnections
-                conn.shape.setFillColor(connectionColor);
+    // Same as showing it again, unchanged connections aren't touched
+    setNetwork(network);
+}
 
-                conn.fromNode = input;
-                conn.toNode = numInputs + hidden;
-                conn.weight = 0.1; // Default weight
+void NetworkRender::updateActivations(const std::vector<double> &values)
+{
+    for (auto &node : nodes)
+    {
+        if (node.nodeId < 0 || node.nodeId >= static_cast<int>(values.size()))
+            continue;
 
-                connections.push_back(conn);
-            }
+        double activation = values[node.nodeId];
+        if (activation != node.activation)
+        {
+            node.activation = activation;
+            colorNode(node);
         }
+    }
+}
 
-        // Create connections from hidden nodes to outputs
-        for (int hidden = 0; hidden < numHidden; ++hidden)
-        {
-            for (int output = 0; output < numOutputs; ++output)
-            {
-                ConnectionVisual conn;
-                conn.shape.setSize(sf::Vector2f(connectionWidth, 0)); // Will be set in layoutConnections
-                conn.shape.setFillColor(connectionColor);
+bool NetworkRender::hasSameNodes(const NeuralNetwork &network) const
+{
+    const std::vector<int> &inputIds = network.getInputNodes();
+    const std::vector<int> &hiddenIds = network.getHiddenNodes();
+    const std::vector<int> &outputIds = network.getOutputNodes();
 
-                conn.fromNode = numInputs + hidden;
-                conn.toNode = numInputs + numHidden + output;
-                conn.weight = 0.1; // Default weight
+    if (nodes.size() != inputIds.size() + hiddenIds.size() + outputIds.size())
+        return false;
 
-                connections.push_back(conn);
-            }
+    // Nodes are stored inputs first, then hidden, then outputs
+    std::size_t index = 0;
+    for (const std::vector<int> *ids : {&inputIds, &hiddenIds, &outputIds})
+    {
+        for (int id : *ids)
+        {
+            if (nodes[index++].nodeId != id)
+                return false;
         }
     }
-    else
+    return true;
+}
+
+void NetworkRender::createNodeVisuals(const NeuralNetwork &network)
+{
+    nodes.clear();
+    nodeIndexById.clear();
+
+    auto addNodes = [this](const std::vector<int> &ids, bool isInput, bool isHidden, bool isOutput)
     {
-        // Direct connections from inputs to outputs (no hidden layer)
-        for (int input = 0; input < numInputs; ++input)
+        for (int id : ids)
         {
-            for (int output = 0; output < numOutputs; ++output)
-            {
-                ConnectionVisual conn;
-                conn.shape.setSize(sf::Vector2f(connectionWidth, 0)); // Will be set in layoutConnections
-                conn.shape.setFillColor(connectionColor);
+            NodeVisual node;
+            node.nodeId = id;
+            node.isInput = isInput;
+            node.isHidden = isHidden;
+            node.isOutput = isOutput;
 
-                conn.fromNode = input;
-                conn.toNode = numInputs + output;
-                conn.weight = 0.1; // Default weight
-
-                connections.push_back(conn);
+            if (id >= static_cast<int>(nodeIndexById.size()))
+            {
+                nodeIndexById.resize(id + 1, -1);
             }
+            nodeIndexById[id] = static_cast<int>(nodes.size());
+            nodes.push_back(node);
         }
+    };
+
+    addNodes(network.getInputNodes(), true, false, false);
+    addNodes(network.getHiddenNodes(), false, true, false);
+    addNodes(network.getOutputNodes(), false, false, true);
+}
+
+void NetworkRender::collectConnections(const NeuralNetwork &network)
+{
+    incoming.clear();
+    for (const auto &connection : network.getConnections())
+    {
+        ConnectionVisual conn;
+        conn.innovationNumber = connection.innovationNumber;
+        conn.fromNode = connection.fromNode;
+        conn.toNode = connection.toNode;
+        conn.weight = connection.weight;
+        conn.enabled = connection.enabled;
+        incoming.push_back(conn);
     }
+
+    // Genomes keep connections in insertion order, compare them by innovation number
+    std::stable_sort(incoming.begin(), incoming.end(),
+                     [](const ConnectionVisual &a, const ConnectionVisual &b)
+                     { return a.innovationNumber < b.innovationNumber; });
 }
 
 void NetworkRender::layoutNodes()
 {
     float currentX = position.x + 30.0f; // Start with some margin
-    
+
     int numInputs = 0, numHidden = 0, numOutputs = 0;
-    
+
     // Count nodes by type
     for (const auto& node : nodes)
     {
@@ -187,80 +162,147 @@ void NetworkRender::layoutNodes()
     float totalHiddenHeight = (numHidden > 1) ? (numHidden - 1) * nodeSpacing : 0;
     float totalOutputHeight = (numOutputs > 1) ? (numOutputs - 1) * nodeSpacing : 0;
 
-    // Layout input nodes (vertical column, centered)
+    // Columns: inputs, hidden (if any), outputs, each centered vertically
+    float inputX = currentX;
+    float hiddenX = numHidden > 0 ? currentX + layerSpacing : currentX;
+    float outputX = hiddenX + layerSpacing;
     float inputY = position.y + (size.y - totalInputHeight) / 2.0f;
-    int inputIndex = 0;
+    float hiddenY = position.y + (size.y - totalHiddenHeight) / 2.0f;
+    float outputY = position.y + (size.y - totalOutputHeight) / 2.0f;
+
+    int inputIndex = 0, hiddenIndex = 0, outputIndex = 0;
     for (auto& node : nodes)
     {
+        sf::Vector2f topLeft;
         if (node.isInput)
-        {
-            node.shape.setPosition(sf::Vector2f(currentX, inputY + inputIndex * nodeSpacing));
-            inputIndex++;
-        }
+            topLeft = sf::Vector2f(inputX, inputY + inputIndex++ * nodeSpacing);
+        else if (node.isHidden)
+            topLeft = sf::Vector2f(hiddenX, hiddenY + hiddenIndex++ * nodeSpacing);
+        else
+            topLeft = sf::Vector2f(outputX, outputY + outputIndex++ * nodeSpacing);
+
+        node.center = topLeft + sf::Vector2f(nodeRadius, nodeRadius);
     }
 
-    // Layout hidden nodes (vertical column, centered) - if any exist
-    if (numHidden > 0)
+    // Each node is a black outline disc with the fill disc on top
+    const std::size_t verticesPerDisc = static_cast<std::size_t>(circleSegments) * 3;
+    nodeVertices.resize(nodes.size() * verticesPerDisc * 2);
+
+    const float outlineThickness = 2.0f;
+    std::size_t vertex = 0;
+    for (auto &node : nodes)
     {
-        currentX += layerSpacing;
-        float hiddenY = position.y + (size.y - totalHiddenHeight) / 2.0f;
-        int hiddenIndex = 0;
-        for (auto& node : nodes)
+        for (int pass = 0; pass < 2; ++pass)
         {
-            if (node.isHidden)
+            float radius = pass == 0 ? nodeRadius + outlineThickness : nodeRadius;
+            if (pass == 1)
             {
-                node.shape.setPosition(sf::Vector2f(currentX, hiddenY + hiddenIndex * nodeSpacing));
-                hiddenIndex++;
+                node.firstFillVertex = vertex;
             }
-        }
-    }
 
-    // Layout output nodes (vertical column, centered)
-    currentX += layerSpacing;
-    float outputY = position.y + (size.y - totalOutputHeight) / 2.0f;
-    int outputIndex = 0;
-    for (auto& node : nodes)
-    {
-        if (node.isOutput)
-        {
-            node.shape.setPosition(sf::Vector2f(currentX, outputY + outputIndex * nodeSpacing));
-            outputIndex++;
+            for (int s = 0; s < circleSegments; ++s)
+            {
+                float angle0 = s * 2.0f * 3.14159f / circleSegments;
+                float angle1 = (s + 1) * 2.0f * 3.14159f / circleSegments;
+                nodeVertices[vertex].position = node.center;
+                nodeVertices[vertex + 1].position = node.center + sf::Vector2f(std::cos(angle0), std::sin(angle0)) * radius;
+                nodeVertices[vertex + 2].position = node.center + sf::Vector2f(std::cos(angle1), std::sin(angle1)) * radius;
+                for (int k = 0; k < 3; ++k)
+                {
+                    nodeVertices[vertex + k].color = sf::Color::Black;
+                }
+                vertex += 3;
+            }
         }
+        colorNode(node);
     }
 }
 
 void NetworkRender::layoutConnections()
 {
-    for (auto &conn : connections)
+    connectionVertices.resize(connections.size() * 6);
+
+    for (std::size_t i = 0; i < connections.size(); ++i)
     {
+        const auto &conn = connections[i];
+
         // Find the positions of the connected nodes
         sf::Vector2f fromPos(0, 0);
         sf::Vector2f toPos(0, 0);
-
-        for (const auto &node : nodes)
+        if (conn.fromNode >= 0 && conn.fromNode < static_cast<int>(nodeIndexById.size()) && nodeIndexById[conn.fromNode] >= 0)
         {
-            if (node.nodeId == conn.fromNode)
-            {
-                fromPos = node.shape.getPosition() + sf::Vector2f(nodeRadius, nodeRadius);
-            }
-            if (node.nodeId == conn.toNode)
-            {
-                toPos = node.shape.getPosition() + sf::Vector2f(nodeRadius, nodeRadius);
-            }
+            fromPos = nodes[nodeIndexById[conn.fromNode]].center;
+        }
+        if (conn.toNode >= 0 && conn.toNode < static_cast<int>(nodeIndexById.size()) && nodeIndexById[conn.toNode] >= 0)
+        {
+            toPos = nodes[nodeIndexById[conn.toNode]].center;
         }
 
-        // Calculate connection properties
+        // A quad of connectionWidth along the line between the node centers
         sf::Vector2f direction = toPos - fromPos;
         float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
-        float angle = std::atan2(direction.y, direction.x) * 180.0f / 3.14159f;
+        sf::Vector2f normal(0.0f, 0.0f);
+        if (length > 0.0f)
+        {
+            normal = sf::Vector2f(-direction.y, direction.x) * (connectionWidth / 2.0f / length);
+        }
+
+        sf::Vertex *quad = &connectionVertices[i * 6];
+        quad[0].position = fromPos - normal;
+        quad[1].position = toPos - normal;
+        quad[2].position = toPos + normal;
+        quad[3].position = fromPos - normal;
+        quad[4].position = toPos + normal;
+        quad[5].position = fromPos + normal;
+
+        colorConnection(i);
+    }
+}
+
+void NetworkRender::colorConnection(std::size_t index)
+{
+    const auto &conn = connections[index];
+
+    // Disabled connections stay in the batch but are invisible
+    sf::Color color = conn.enabled ? getWeightColor(conn.weight) : sf::Color::Transparent;
+    for (std::size_t k = 0; k < 6; ++k)
+    {
+        connectionVertices[index * 6 + k].color = color;
+    }
+}
 
-        // Set connection shape
-        conn.shape.setSize(sf::Vector2f(length, connectionWidth));
-        conn.shape.setPosition(fromPos);
-        conn.shape.setRotation(sf::degrees(angle));
+void NetworkRender::colorNode(const NodeVisual &node)
+{
+    sf::Color color = getNodeColor(node);
+    std::size_t count = static_cast<std::size_t>(circleSegments) * 3;
+    for (std::size_t k = 0; k < count; ++k)
+    {
+        nodeVertices[node.firstFillVertex + k].color = color;
+    }
+}
+
+void NetworkRender::recolorNodes()
+{
+    if (nodeVertices.getVertexCount() == 0)
+        return;
+
+    for (const auto &node : nodes)
+    {
+        colorNode(node);
     }
 }
 
+sf::Color NetworkRender::getNodeColor(const NodeVisual &node) const
+{
+    sf::Color base = node.isInput ? inputNodeColor : (node.isHidden ? hiddenNodeColor : outputNodeColor);
+
+    // Brighten towards white the stronger the node fires
+    float strength = std::min(1.0f, static_cast<float>(std::abs(node.activation)));
+    return sf::Color(static_cast<unsigned char>(base.r + (255 - base.r) * strength),
+                     static_cast<unsigned char>(base.g + (255 - base.g) * strength),
+                     static_cast<unsigned char>(base.b + (255 - base.b) * strength));
+}
+
 sf::Color NetworkRender::getWeightColor(double weight) const
 {
     // Color based on weight: red for negative, green for positive, intensity based on magnitude
@@ -291,10 +333,6 @@ void NetworkRender::setSize(float width, float height)
 void NetworkRender::setNodeRadius(float radius)
 {
     nodeRadius = radius;
-    for (auto &node : nodes)
-    {
-        node.shape.setRadius(radius);
-    }
     layoutNodes();
     layoutConnections();
 }
@@ -302,10 +340,7 @@ void NetworkRender::setNodeRadius(float radius)
 void NetworkRender::setConnectionWidth(float width)
 {
     connectionWidth = width;
-    for (auto &conn : connections)
-    {
-        conn.shape.setSize(sf::Vector2f(conn.shape.getSize().x, width));
-    }
+    layoutConnections();
 }
 
 void NetworkRender::setNodeSpacing(float spacing)
@@ -325,59 +360,36 @@ void NetworkRender::setLayerSpacing(float spacing)
 void NetworkRender::setInputNodeColor(const sf::Color &color)
 {
     inputNodeColor = color;
-    for (auto &node : nodes)
-    {
-        if (node.isInput)
-        {
-            node.shape.setFillColor(color);
-        }
-    }
+    recolorNodes();
 }
 
 void NetworkRender::setHiddenNodeColor(const sf::Color &color)
 {
     hiddenNodeColor = color;
-    for (auto &node : nodes)
-    {
-        if (node.isHidden)
-        {
-            node.shape.setFillColor(color);
-        }
-    }
+    recolorNodes();
 }
 
 void NetworkRender::setOutputNodeColor(const sf::Color &color)
 {
     outputNodeColor = color;
-    for (auto &node : nodes)
-    {
-        if (node.isOutput)
-        {
-            node.shape.setFillColor(color);
-        }
-    }
+    recolorNodes();
 }
 
 void NetworkRender::setConnectionColor(const sf::Color &color)
 {
+    // Connections are colored by weight, the base color is kept for reference only
     connectionColor = color;
-    for (auto &conn : connections)
-    {
-        conn.shape.setFillColor(color);
-    }
 }
 
-void NetworkRender::draw(sf::RenderWindow &window) const
+void NetworkRender::draw(sf::RenderTarget &target) const
 {
-    // Draw connections first (behind nodes)
-    for (const auto &conn : connections)
+    // Draw connections first (behind nodes), each batch is one draw call
+    if (connectionVertices.getVertexCount() > 0)
     {
-        window.draw(conn.shape);
+        target.draw(connectionVertices);
     }
-
-    // Draw nodes
-    for (const auto &node : nodes)
+    if (nodeVertices.getVertexCount() > 0)
     {
-        window.draw(node.shape);
+        target.draw(nodeVertices);
     }
-}
\ No newline at end of file
+}
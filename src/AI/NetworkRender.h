@@ -4,58 +4,73 @@
 #include <vector>
 #include <memory>
 
+// Draws a genome as two vertex arrays (all connections, then all nodes)
+// setNetwork diffs the new genome against the shown one by innovation number:
+// only changed weights are recolored, the geometry is rebuilt only when the topology changes
 class NetworkRender
 {
 private:
     struct NodeVisual
     {
-        sf::CircleShape shape;
+        sf::Vector2f center;
         int nodeId;
         bool isInput;
         bool isOutput;
         bool isHidden;
-        
-        NodeVisual() : nodeId(0), isInput(false), isOutput(false), isHidden(false) {}
+        std::size_t firstFillVertex; // Start of this node's fill triangles in nodeVertices
+        double activation;           // Last shown activation
+
+        NodeVisual() : nodeId(0), isInput(false), isOutput(false), isHidden(false), firstFillVertex(0), activation(0.0) {}
     };
 
     struct ConnectionVisual
     {
-        sf::RectangleShape shape;
+        int innovationNumber;
         int fromNode;
         int toNode;
         double weight;
-        
-        ConnectionVisual() : fromNode(0), toNode(0), weight(0.0) {}
+        bool enabled;
+
+        ConnectionVisual() : innovationNumber(0), fromNode(0), toNode(0), weight(0.0), enabled(true) {}
     };
 
     std::vector<NodeVisual> nodes;
-    std::vector<ConnectionVisual> connections;
-    
+    std::vector<int> nodeIndexById;            // Node id -> index into nodes (-1 if not shown)
+    std::vector<ConnectionVisual> connections; // Sorted by innovation number, connection i owns vertices [6i, 6i + 6)
+    std::vector<ConnectionVisual> incoming;    // Scratch list for diffing (keeps its capacity)
+
+    sf::VertexArray connectionVertices;
+    sf::VertexArray nodeVertices;
+
     // Visual properties
     float nodeRadius;
     float connectionWidth;
     float nodeSpacing;
     float layerSpacing;
-    
+    int circleSegments;
+
     // Colors
     sf::Color inputNodeColor;
     sf::Color hiddenNodeColor;
     sf::Color outputNodeColor;
     sf::Color connectionColor;
-    
+
     // Position and size
     sf::Vector2f position;
     sf::Vector2f size;
 
 public:
     NetworkRender();
-    
-    // Set up the network visualization
+
+    // Show a network, only the parts that differ from the shown one are updated
     void setNetwork(const NeuralNetwork& network);
-    
-    // Update the visualization with current network values
+
+    // Update the visualization with current network values (weights)
     void updateValues(const NeuralNetwork& network);
-    
+
+    // Color the nodes by their activation (values indexed by node id), doesn't allocate
+    void updateActivations(const std::vector<double>& values);
+
     // Set visual properties
     void setPosition(float x, float y);
     void setSize(float width, float height);
@@ -63,25 +78,30 @@ public:
     void setConnectionWidth(float width);
     void setNodeSpacing(float spacing);
     void setLayerSpacing(float spacing);
-    
+
     // Set colors
     void setInputNodeColor(const sf::Color& color);
     void setHiddenNodeColor(const sf::Color& color);
     void setOutputNodeColor(const sf::Color& color);
     void setConnectionColor(const sf::Color& color);
-    
+
     // Draw the network
-    void draw(sf::RenderWindow& window) const;
-    
+    void draw(sf::RenderTarget& target) const;
+
     // Getters
     sf::Vector2f getPosition() const { return position; }
     sf::Vector2f getSize() const { return size; }
 
 private:
     // Helper methods
+    bool hasSameNodes(const NeuralNetwork& network) const;
     void createNodeVisuals(const NeuralNetwork& network);
-    void createConnectionVisuals(const NeuralNetwork& network);
+    void collectConnections(const NeuralNetwork& network);
     void layoutNodes();
     void layoutConnections();
+    void colorConnection(std::size_t index);
+    void colorNode(const NodeVisual& node);
+    void recolorNodes();
+    sf::Color getNodeColor(const NodeVisual& node) const;
     sf::Color getWeightColor(double weight) const;
-}; 
\ No newline at end of file
+};
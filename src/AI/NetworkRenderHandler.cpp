@@ -27,11 +27,19 @@ void NetworkRenderHandler::update()
     }
 }
 
-void NetworkRenderHandler::draw(sf::RenderWindow &window) const
+void NetworkRenderHandler::updateActivations(const std::vector<double> &values)
+{
+    if (networkRender && isVisible)
+    {
+        networkRender->updateActivations(values);
+    }
+}
+
+void NetworkRenderHandler::draw(sf::RenderTarget &target) const
 {
     if (isVisible && networkRender)
     {
-        networkRender->draw(window);
+        networkRender->draw(target);
     }
 }
 
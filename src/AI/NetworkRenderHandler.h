@@ -24,9 +24,12 @@ public:
     
     // Update the visualization
     void update();
+
+    // Show live node activations (indexed by node id)
+    void updateActivations(const std::vector<double>& values);
     
     // Draw the network
-    void draw(sf::RenderWindow& window) const;
+    void draw(sf::RenderTarget& target) const;
     
     // Visibility control
     void setVisible(bool visible) { isVisible = visible; }
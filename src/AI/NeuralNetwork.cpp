@@ -1,5 +1,7 @@
 #include "NeuralNetwork.h"
 #include "InnovationTracker.h"
+#include "Random.h"
+#include "../Persistence/BinaryIO.h"
 #include <algorithm>
 #include <cmath>
 #include <random>
@@ -31,8 +33,7 @@ void NeuralNetwork::initializeSimple(int numInputs, int numOutputs, int numHidde
     hiddenNodes.clear();
 
     // Random number generator for weight initialization
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+    std::mt19937 &gen = Random::engine();
     static std::uniform_real_distribution<> weightDis(-1.0, 1.0);
     static std::uniform_real_distribution<> biasDis(-0.5, 0.5);
     static std::uniform_real_distribution<> probDis(0.0, 1.0);
@@ -45,11 +46,11 @@ void NeuralNetwork::initializeSimple(int numInputs, int numOutputs, int numHidde
         inputNodes.push_back(nodeId);
     }
 
-    // Randomly add 0-3 hidden nodes for structural diversity
-    int randomHiddenNodes = static_cast<int>(probDis(gen) * 4); // 0, 1, 2, or 3 hidden nodes
+    // A negative count adds 0-3 hidden nodes at random for structural diversity
+    int hiddenCount = numHidden >= 0 ? numHidden : static_cast<int>(probDis(gen) * 4);
 
     // Create hidden nodes (if any)
-    for (int i = 0; i < randomHiddenNodes; ++i)
+    for (int i = 0; i < hiddenCount; ++i)
     {
         int nodeId = numInputs + i;
         addNode(nodeId, biasDis(gen)); // Random bias
@@ -59,13 +60,13 @@ void NeuralNetwork::initializeSimple(int numInputs, int numOutputs, int numHidde
     // Create output nodes
     for (int i = 0; i < numOutputs; ++i)
     {
-        int nodeId = numInputs + randomHiddenNodes + i;
+        int nodeId = numInputs + hiddenCount + i;
         addNode(nodeId, biasDis(gen)); // Random bias
         outputNodes.push_back(nodeId);
     }
 
     // Create connections with structural randomness
-    if (randomHiddenNodes == 0)
+    if (hiddenCount == 0)
     {
         // Direct connections from inputs to outputs (basic structure)
         for (int input : inputNodes)
@@ -169,13 +170,110 @@ std::vector<double> NeuralNetwork::process(const std::vector<double> &inputs)
         outputs.push_back(std::tanh(sum)); // Activation function
     }
 
+    // Keep the output activations for visualization (after the loop, so outputs never feed each other)
+    for (size_t i = 0; i < outputs.size(); ++i)
+    {
+        nodes[outputNodes[i]].value = outputs[i];
+    }
+
     return outputs;
 }
 
+void NeuralNetwork::copyNodeValues(std::vector<double> &values) const
+{
+    values.resize(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        values[i] = nodes[i].value;
+    }
+}
+
+void NeuralNetwork::serialize(BinaryWriter &writer) const
+{
+    writer.writeI32(nextNodeId);
+
+    // Node ids are their index in nodes, so only the biases are stored
+    writer.writeU32(static_cast<std::uint32_t>(nodes.size()));
+    for (const auto &node : nodes)
+    {
+        writer.writeF64(node.bias);
+    }
+
+    for (const std::vector<int> *ids : {&inputNodes, &hiddenNodes, &outputNodes})
+    {
+        writer.writeU32(static_cast<std::uint32_t>(ids->size()));
+        for (int id : *ids)
+        {
+            writer.writeI32(id);
+        }
+    }
+
+    writer.writeU32(static_cast<std::uint32_t>(connections.size()));
+    for (const auto &conn : connections)
+    {
+        writer.writeI32(conn.fromNode);
+        writer.writeI32(conn.toNode);
+        writer.writeF64(conn.weight);
+        writer.writeBool(conn.enabled);
+        writer.writeI32(conn.innovationNumber);
+    }
+}
+
+bool NeuralNetwork::deserialize(BinaryReader &reader)
+{
+    NeuralNetwork loaded;
+    loaded.nextNodeId = reader.readI32();
+
+    std::uint32_t nodeCount = reader.readCount(8);
+    for (std::uint32_t i = 0; i < nodeCount; ++i)
+    {
+        loaded.addNode(static_cast<int>(i), reader.readF64());
+    }
+
+    // Every id must point at a node, process() indexes nodes by id
+    auto validNode = [nodeCount](int id)
+    { return id >= 0 && static_cast<std::uint32_t>(id) < nodeCount; };
+
+    for (std::vector<int> *ids : {&loaded.inputNodes, &loaded.hiddenNodes, &loaded.outputNodes})
+    {
+        std::uint32_t count = reader.readCount(4);
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            int id = reader.readI32();
+            if (!validNode(id))
+                reader.fail();
+            ids->push_back(id);
+        }
+    }
+
+    std::uint32_t connectionCount = reader.readCount(21);
+    loaded.connections.reserve(connectionCount);
+    for (std::uint32_t i = 0; i < connectionCount; ++i)
+    {
+        Connection conn;
+        conn.fromNode = reader.readI32();
+        conn.toNode = reader.readI32();
+        conn.weight = reader.readF64();
+        conn.enabled = reader.readBool();
+        conn.innovationNumber = reader.readI32();
+        if (!validNode(conn.fromNode) || !validNode(conn.toNode))
+            reader.fail();
+        loaded.connections.push_back(conn);
+    }
+
+    if (loaded.nextNodeId < static_cast<int>(nodeCount))
+        reader.fail();
+
+    if (!reader.ok())
+        return false;
+
+    *this = std::move(loaded);
+    return true;
+}
+
 void NeuralNetwork::mutate()
 {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+    std::mt19937 &gen = Random::engine();
     static std::uniform_real_distribution<> dis(0.0, 1.0);
 
     double mutationChance = dis(gen);
@@ -223,8 +321,7 @@ void NeuralNetwork::addConnection(int fromNode, int toNode, double weight, bool
 
 void NeuralNetwork::mutateWeights()
 {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+    std::mt19937 &gen = Random::engine();
     static std::uniform_real_distribution<> dis(-0.1, 0.1);
 
     for (auto &conn : connections)
@@ -238,8 +335,7 @@ void NeuralNetwork::mutateWeights()
 
 void NeuralNetwork::mutateBias()
 {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+    std::mt19937 &gen = Random::engine();
     static std::uniform_real_distribution<> dis(-0.1, 0.1);
 
     for (auto &node : nodes)
@@ -285,8 +381,7 @@ int NeuralNetwork::getRandomNode() const
     if (nodes.empty())
         return -1;
 
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+    std::mt19937 &gen = Random::engine();
     std::uniform_int_distribution<> dis(0, nodes.size() - 1);
 
     return nodes[dis(gen)].id;
@@ -297,8 +392,7 @@ int NeuralNetwork::getRandomHiddenNode() const
     if (hiddenNodes.empty())
         return -1;
 
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+    std::mt19937 &gen = Random::engine();
     std::uniform_int_distribution<> dis(0, hiddenNodes.size() - 1);
 
     return hiddenNodes[dis(gen)];
@@ -306,8 +400,7 @@ int NeuralNetwork::getRandomHiddenNode() const
 
 void NeuralNetwork::mutateAddConnection()
 {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+    std::mt19937 &gen = Random::engine();
     static std::uniform_real_distribution<> weightDis(-1.0, 1.0);
 
     if (nodes.size() < 2)
@@ -342,9 +435,8 @@ void NeuralNetwork::mutateAddNode()
     if (connections.empty())
         return;
 
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_int_distribution<> connDis(0, connections.size() - 1);
+    std::mt19937 &gen = Random::engine();
+    std::uniform_int_distribution<> connDis(0, connections.size() - 1); // Per call, the connection count differs between genomes
 
     int connIndex = connDis(gen);
     Connection &conn = connections[connIndex];
@@ -475,8 +567,7 @@ NeuralNetwork NeuralNetwork::crossover(const NeuralNetwork &other) const
     child = *this;
 
     // Crossover weights and biases
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+    std::mt19937 &gen = Random::engine();
     static std::uniform_real_distribution<> dis(0.0, 1.0);
 
     for (size_t i = 0; i < child.connections.size() && i < other.connections.size(); ++i)
@@ -5,6 +5,8 @@
 
 // Forward declaration
 class InnovationTracker;
+class BinaryWriter;
+class BinaryReader;
 
 class NeuralNetwork
 {
@@ -39,7 +41,7 @@ private:
 public:
     NeuralNetwork();
 
-    // Initialize a simple feedforward network
+    // Initialize a simple feedforward network (a negative numHidden picks 0-3 hidden nodes at random)
     void initializeSimple(int numInputs, int numOutputs, int numHidden = 0);
 
     // Process inputs through the network
@@ -63,6 +65,18 @@ public:
     int getNumOutputs() const { return outputNodes.size(); }
     int getNumHidden() const { return hiddenNodes.size(); }
     const std::vector<Connection>& getConnections() const { return connections; }
+    const std::vector<int>& getInputNodes() const { return inputNodes; }
+    const std::vector<int>& getHiddenNodes() const { return hiddenNodes; }
+    const std::vector<int>& getOutputNodes() const { return outputNodes; }
+    double getNodeBias(int nodeId) const { return nodes[nodeId].bias; }
+
+    // Copy the node values from the last process() call, indexed by node id (reuses the vector's capacity)
+    void copyNodeValues(std::vector<double> &values) const;
+
+    // Binary genome: nodes, biases, connections and weights (not the node values)
+    void serialize(BinaryWriter &writer) const;
+    // Returns false and leaves the network unchanged if the data is invalid
+    bool deserialize(BinaryReader &reader);
 
 private:
     void addNode(int nodeId, double bias = 0.0);
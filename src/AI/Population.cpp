@@ -1,11 +1,15 @@
 #include "Population.h"
-#include <iostream>
+#include "Random.h"
+#include "../Persistence/BinaryIO.h"
+#include "../Logging/Logger.h"
 #include <algorithm>
 #include <random>
+#include <limits>
 #include <numeric> // Required for std::accumulate
+#include <unordered_map>
 
 Population::Population(int size, int numInputs, int numOutputs, int numHidden)
-    : generation(0), populationSize(size), compatibilityThreshold(3.0), // Increased from 1.0 to 3.0
+    : nextSpeciesId(0), generation(0), populationSize(size), compatibilityThreshold(3.0), // Increased from 1.0 to 3.0
       bestFitness(0.0), generationsWithoutImprovement(0),
       c1(1.0), c2(1.0), c3(0.4),
       weightMutationRate(0.8), weightMutationPower(0.1),
@@ -46,14 +50,13 @@ void Population::evolve()
     innovationTracker->reset();
 
     generation++;
-
-    // Print statistics
-    printStatistics();
 }
 
 void Population::speciate()
 {
-    species.clear();
+    // The previous species only decide which ids continue
+    std::vector<std::shared_ptr<Species>> previousSpecies;
+    previousSpecies.swap(species);
 
     // Adaptive speciation: adjust compatibility threshold based on target species count
     const int targetSpeciesCount = std::max(1, populationSize / 5); // Target ~5 individuals per species
@@ -78,21 +81,37 @@ void Population::speciate()
         speciateWithThreshold(compatibilityThreshold);
     }
 
-    // Debug output for speciation
-    std::cout << "Speciation: " << species.size() << " species created (threshold: " << compatibilityThreshold << ")" << std::endl;
-    for (size_t i = 0; i < species.size(); ++i)
+    // Merge very small species (less than 2 members) with larger ones
+    mergeSmallSpecies();
+
+    assignSpeciesIds(previousSpecies);
+
+    // Members keep their genome object when species merge, so it identifies each controller's final species
+    std::unordered_map<const NeuralNetwork *, int> speciesOfMember;
+    for (const auto &s : species)
     {
-        std::cout << "  Species " << i << ": " << species[i]->getSize() << " members" << std::endl;
+        for (const auto &member : s->getMembers())
+        {
+            speciesOfMember[member.get()] = s->getId();
+        }
     }
 
-    // Merge very small species (less than 2 members) with larger ones
-    mergeSmallSpecies();
+    controllerSpeciesIds.assign(controllers.size(), -1);
+    for (size_t i = 0; i < speciatedMembers.size() && i < controllers.size(); ++i)
+    {
+        auto found = speciesOfMember.find(speciatedMembers[i]);
+        if (found != speciesOfMember.end())
+            controllerSpeciesIds[i] = found->second;
+    }
 }
 
 void Population::speciateWithThreshold(double threshold)
 {
+    speciatedMembers.clear();
     for (auto &controller : controllers)
     {
+        auto member = std::make_shared<NeuralNetwork>(controller->getBrain());
+        speciatedMembers.push_back(member.get());
         bool placed = false;
 
         // Try to place in existing species
@@ -101,7 +120,7 @@ void Population::speciateWithThreshold(double threshold)
             double distance = species->getRepresentative()->calculateDistance(controller->getBrain());
             if (distance <= threshold)
             {
-                species->addMember(std::make_shared<NeuralNetwork>(controller->getBrain()));
+                species->addMember(member);
                 placed = true;
                 break;
             }
@@ -110,12 +129,44 @@ void Population::speciateWithThreshold(double threshold)
         // Create new species if not placed
         if (!placed)
         {
-            auto newSpecies = std::make_shared<Species>(std::make_shared<NeuralNetwork>(controller->getBrain()));
+            auto newSpecies = std::make_shared<Species>(member);
             species.push_back(newSpecies);
         }
     }
 }
 
+void Population::assignSpeciesIds(const std::vector<std::shared_ptr<Species>> &previousSpecies)
+{
+    std::vector<bool> continued(previousSpecies.size(), false);
+    for (auto &s : species)
+    {
+        int closest = -1;
+        double closestDistance = std::numeric_limits<double>::max();
+        for (size_t i = 0; i < previousSpecies.size(); ++i)
+        {
+            if (continued[i] || previousSpecies[i]->getId() < 0 || !previousSpecies[i]->getRepresentative())
+                continue;
+
+            double distance = previousSpecies[i]->getRepresentative()->calculateDistance(*s->getRepresentative());
+            if (distance <= compatibilityThreshold && distance < closestDistance)
+            {
+                closestDistance = distance;
+                closest = static_cast<int>(i);
+            }
+        }
+
+        if (closest >= 0)
+        {
+            continued[closest] = true;
+            s->setId(previousSpecies[closest]->getId());
+        }
+        else
+        {
+            s->setId(nextSpeciesId++);
+        }
+    }
+}
+
 void Population::mergeSmallSpecies()
 {
     const int minSpeciesSize = 2;
@@ -221,9 +272,12 @@ void Population::calculateAdjustedFitness()
     speciate();
 
     // Now calculate adjusted fitness for each species using actual controller fitness values
+    evaluatedSpecies.clear();
     for (auto &species : species)
     {
         species->calculateAdjustedFitness(controllers);
+        evaluatedSpecies.push_back(SpeciesSnapshot{species->getId(), species->getSize(), species->getAverageFitness(),
+                                                   species->getBestFitness(), species->getStaleness()});
     }
 
     // Update the population's best fitness
@@ -357,8 +411,7 @@ void Population::reproduce()
         else
         {
             // Fallback: select random species
-            static std::random_device rd;
-            static std::mt19937 gen(rd());
+            std::mt19937 &gen = Random::engine();
             std::uniform_int_distribution<> dis(0, species.size() - 1);
 
             int speciesIndex = dis(gen);
@@ -413,7 +466,7 @@ void Population::reproduce()
 
         if (!bestPreserved)
         {
-            std::cout << "WARNING: Best individual was lost! Restoring..." << std::endl;
+            LOG_WARNING("Best individual was lost! Restoring...");
             // Replace the worst individual with the best one
             auto worstController = controllers[0];
             double worstFitness = worstController->getFitness();
@@ -478,50 +531,114 @@ void Population::resetControllers()
     }
 }
 
-void Population::printStatistics() const
+void Population::serialize(BinaryWriter &writer) const
 {
-    std::cout << "Generation " << generation << ":" << std::endl;
-    std::cout << "  Species count: " << species.size() << " (threshold: " << compatibilityThreshold << ")" << std::endl;
-    std::cout << "  Population size: " << controllers.size() << std::endl;
-    std::cout << "  Best fitness: " << bestFitness << std::endl;
-    std::cout << "  Generations without improvement: " << generationsWithoutImprovement << std::endl;
-
-    // Calculate species size distribution
-    std::vector<int> sizeDistribution;
-    for (const auto &species : species)
+    writer.writeI32(generation);
+    writer.writeI32(populationSize);
+    writer.writeF64(compatibilityThreshold);
+    writer.writeF64(bestFitness);
+    writer.writeI32(generationsWithoutImprovement);
+    writer.writeI32(nextSpeciesId);
+
+    for (double parameter : {c1, c2, c3, weightMutationRate, weightMutationPower, addConnectionRate,
+                             addNodeRate, disableConnectionRate, enableConnectionRate})
     {
-        sizeDistribution.push_back(species->getSize());
+        writer.writeF64(parameter);
     }
 
-    if (!sizeDistribution.empty())
+    innovationTracker->serialize(writer);
+
+    writer.writeU32(static_cast<std::uint32_t>(controllers.size()));
+    for (const auto &controller : controllers)
     {
-        std::sort(sizeDistribution.begin(), sizeDistribution.end());
-        std::cout << "  Species size distribution: ";
-        std::cout << "min=" << sizeDistribution.front()
-                  << ", max=" << sizeDistribution.back()
-                  << ", avg=" << (controllers.size() / species.size()) << std::endl;
+        controller->getBrain().serialize(writer);
     }
 
-    // Show fitness distribution
-    std::vector<double> fitnessValues;
-    for (const auto &controller : controllers)
+    writer.writeU32(static_cast<std::uint32_t>(species.size()));
+    for (const auto &s : species)
     {
-        fitnessValues.push_back(controller->getFitness());
+        s->serialize(writer);
     }
+}
 
-    if (!fitnessValues.empty())
+bool Population::deserialize(BinaryReader &reader)
+{
+    int loadedGeneration = reader.readI32();
+    int loadedPopulationSize = reader.readI32();
+    double loadedThreshold = reader.readF64();
+    double loadedBestFitness = reader.readF64();
+    int loadedWithoutImprovement = reader.readI32();
+    int loadedNextSpeciesId = reader.readI32();
+
+    double parameters[9];
+    for (double &parameter : parameters)
     {
-        std::sort(fitnessValues.begin(), fitnessValues.end(), std::greater<double>());
-        std::cout << "  Fitness distribution: ";
-        std::cout << "best=" << fitnessValues.front()
-                  << ", worst=" << fitnessValues.back()
-                  << ", avg=" << (std::accumulate(fitnessValues.begin(), fitnessValues.end(), 0.0) / fitnessValues.size()) << std::endl;
+        parameter = reader.readF64();
     }
 
-    for (size_t i = 0; i < species.size(); ++i)
+    InnovationTracker loadedTracker;
+    if (!loadedTracker.deserialize(reader))
+        return false;
+
+    // Genomes must fit the sensors and outputs the cars use now
+    const int numInputs = controllers.empty() ? -1 : controllers[0]->getBrain().getNumInputs();
+    const int numOutputs = controllers.empty() ? -1 : controllers[0]->getBrain().getNumOutputs();
+
+    std::uint32_t controllerCount = reader.readCount(20);
+    std::vector<std::shared_ptr<AIController>> loadedControllers;
+    for (std::uint32_t i = 0; i < controllerCount; ++i)
     {
-        std::cout << "  Species " << i << ": " << species[i]->getSize()
-                  << " members, avg fitness: " << species[i]->getAverageFitness() << std::endl;
+        auto controller = std::make_shared<AIController>();
+        if (!controller->getBrain().deserialize(reader))
+            return false;
+        if (numInputs >= 0 && (controller->getBrain().getNumInputs() != numInputs ||
+                               controller->getBrain().getNumOutputs() != numOutputs))
+        {
+            LOG_WARNING("Population: saved networks have " << controller->getBrain().getNumInputs() << " inputs and "
+                     << controller->getBrain().getNumOutputs() << " outputs, expected " << numInputs << " and " << numOutputs);
+            return false;
+        }
+        loadedControllers.push_back(controller);
     }
-    std::cout << std::endl;
-}
\ No newline at end of file
+
+    std::uint32_t speciesCount = reader.readCount(36);
+    std::vector<std::shared_ptr<Species>> loadedSpecies;
+    for (std::uint32_t i = 0; i < speciesCount; ++i)
+    {
+        auto s = Species::deserialize(reader);
+        if (!s)
+            return false;
+        // Ids continue the saved lineages, a later species must never reuse one
+        if (s->getId() < 0 || s->getId() >= loadedNextSpeciesId)
+            return false;
+        loadedSpecies.push_back(s);
+    }
+
+    if (!reader.ok() || loadedControllers.empty() || loadedPopulationSize <= 0)
+        return false;
+
+    generation = loadedGeneration;
+    populationSize = loadedPopulationSize;
+    compatibilityThreshold = loadedThreshold;
+    bestFitness = loadedBestFitness;
+    generationsWithoutImprovement = loadedWithoutImprovement;
+    nextSpeciesId = loadedNextSpeciesId;
+    c1 = parameters[0];
+    c2 = parameters[1];
+    c3 = parameters[2];
+    weightMutationRate = parameters[3];
+    weightMutationPower = parameters[4];
+    addConnectionRate = parameters[5];
+    addNodeRate = parameters[6];
+    disableConnectionRate = parameters[7];
+    enableConnectionRate = parameters[8];
+
+    // Keep the tracker object, the networks hold a pointer to it
+    *innovationTracker = loadedTracker;
+    controllers = std::move(loadedControllers);
+    species = std::move(loadedSpecies);
+    speciatedMembers.clear();
+    controllerSpeciesIds.clear();
+    evaluatedSpecies.clear();
+    return true;
+}
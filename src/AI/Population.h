@@ -5,12 +5,34 @@
 #include <vector>
 #include <memory>
 
+class BinaryWriter;
+class BinaryReader;
+
+// A species as it was when its generation was evaluated (reproduction culls the species afterwards)
+struct SpeciesSnapshot
+{
+    int id;
+    int size;
+    double averageFitness;
+    double bestFitness;
+    int staleness;
+};
+
 class Population
 {
 private:
     std::vector<std::shared_ptr<Species>> species;
     std::vector<std::shared_ptr<AIController>> controllers;
     std::shared_ptr<InnovationTracker> innovationTracker;
+
+    // Species tracking for telemetry, filled by speciate() and calculateAdjustedFitness()
+    int nextSpeciesId;
+    std::vector<const NeuralNetwork *> speciatedMembers; // Member genome of each controller, parallel to controllers
+    std::vector<int> controllerSpeciesIds;               // Species id of each evaluated controller
+    std::vector<SpeciesSnapshot> evaluatedSpecies;
+
+    // Give each new species the id of the previous species whose representative is closest (within the threshold)
+    void assignSpeciesIds(const std::vector<std::shared_ptr<Species>> &previousSpecies);
     
     int generation;
     int populationSize;
@@ -53,6 +75,10 @@ public:
     const std::vector<std::shared_ptr<AIController>>& getControllers() const { return controllers; }
     std::vector<std::shared_ptr<AIController>>& getControllers() { return controllers; }
     std::shared_ptr<AIController> getBestController() const;
+
+    // Species of the generation evaluated by the last evolve(), ids are parallel to that generation's controllers
+    const std::vector<int> &getEvaluatedSpeciesIds() const { return controllerSpeciesIds; }
+    const std::vector<SpeciesSnapshot> &getEvaluatedSpecies() const { return evaluatedSpecies; }
     
     // Setters
     void setCompatibilityThreshold(double threshold) { compatibilityThreshold = threshold; }
@@ -60,7 +86,10 @@ public:
     void setAddConnectionRate(double rate) { addConnectionRate = rate; }
     void setAddNodeRate(double rate) { addNodeRate = rate; }
     void setBestFitness(double fitness) { bestFitness = fitness; }
-    
-    // Statistics
-    void printStatistics() const;
+
+    // Binary population state: counters, NEAT parameters, innovation history, genomes and species
+    void serialize(BinaryWriter &writer) const;
+    // Returns false and leaves the population unchanged if the data is invalid
+    // or its networks have a different number of inputs or outputs than this population
+    bool deserialize(BinaryReader &reader);
 }; 
\ No newline at end of file
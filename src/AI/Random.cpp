@@ -0,0 +1,33 @@
+#include "Random.h"
+#include <sstream>
+
+std::mt19937 &Random::engine()
+{
+    static std::mt19937 gen(std::random_device{}());
+    return gen;
+}
+
+void Random::seed(unsigned int value)
+{
+    engine().seed(value);
+}
+
+std::string Random::getState()
+{
+    std::ostringstream stream;
+    stream << engine();
+    return stream.str();
+}
+
+bool Random::setState(const std::string &state)
+{
+    // Parse into a copy so a bad state leaves the engine untouched
+    std::istringstream stream(state);
+    std::mt19937 restored;
+    stream >> restored;
+    if (stream.fail())
+        return false;
+
+    engine() = restored;
+    return true;
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <random>
+#include <string>
+
+// The one random engine used by evolution (mutation, crossover, selection)
+// Keeping it in one place lets a checkpoint store its state, so a resumed run continues the same sequence.
+// Only the simulation thread may use it.
+class Random
+{
+public:
+    static std::mt19937 &engine();
+
+    // Restart the sequence from a seed
+    static void seed(unsigned int value);
+
+    // Engine state as text (the standard library's portable format)
+    static std::string getState();
+    static bool setState(const std::string &state);
+};
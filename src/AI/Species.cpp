@@ -1,11 +1,13 @@
 #include "Species.h"
 #include "AIController.h"
+#include "Random.h"
+#include "../Persistence/BinaryIO.h"
 #include <algorithm>
 #include <random>
 #include <numeric>
 
 Species::Species(std::shared_ptr<NeuralNetwork> firstMember)
-    : averageFitness(0.0), bestFitness(0.0), staleness(0), maxStaleness(15)
+    : averageFitness(0.0), bestFitness(0.0), staleness(0), maxStaleness(15), id(-1)
 {
     representative = firstMember;
     addMember(firstMember);
@@ -110,8 +112,7 @@ std::shared_ptr<NeuralNetwork> Species::selectParent(const std::vector<std::shar
         return nullptr;
 
     // Tournament selection
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+    std::mt19937 &gen = Random::engine();
     std::uniform_int_distribution<> dis(0, members.size() - 1);
 
     const int tournamentSize = 3;
@@ -204,4 +205,79 @@ void Species::cullToBest()
     members.clear();
     members.push_back(best);
     representative = best;
-}
\ No newline at end of file
+}
+
+void Species::serialize(BinaryWriter &writer) const
+{
+    writer.writeI32(id);
+    writer.writeF64(averageFitness);
+    writer.writeF64(bestFitness);
+    writer.writeI32(staleness);
+    writer.writeI32(maxStaleness);
+
+    // The representative is usually one of the members, then only its index is stored
+    int representativeIndex = -1;
+    for (size_t i = 0; i < members.size(); ++i)
+    {
+        if (members[i] == representative)
+        {
+            representativeIndex = static_cast<int>(i);
+            break;
+        }
+    }
+    writer.writeI32(representativeIndex);
+    if (representativeIndex < 0)
+    {
+        representative->serialize(writer);
+    }
+
+    writer.writeU32(static_cast<std::uint32_t>(members.size()));
+    for (const auto &member : members)
+    {
+        member->serialize(writer);
+    }
+}
+
+std::shared_ptr<Species> Species::deserialize(BinaryReader &reader)
+{
+    int loadedId = reader.readI32();
+    double loadedAverage = reader.readF64();
+    double loadedBest = reader.readF64();
+    int loadedStaleness = reader.readI32();
+    int loadedMaxStaleness = reader.readI32();
+
+    int representativeIndex = reader.readI32();
+    auto loadedRepresentative = std::make_shared<NeuralNetwork>();
+    if (representativeIndex < 0 && !loadedRepresentative->deserialize(reader))
+        return nullptr;
+
+    // A genome takes at least 20 bytes (next node id and four empty counts)
+    std::uint32_t memberCount = reader.readCount(20);
+    std::vector<std::shared_ptr<NeuralNetwork>> loadedMembers;
+    for (std::uint32_t i = 0; i < memberCount; ++i)
+    {
+        auto member = std::make_shared<NeuralNetwork>();
+        if (!member->deserialize(reader))
+            return nullptr;
+        loadedMembers.push_back(member);
+    }
+
+    if (representativeIndex >= 0)
+    {
+        if (static_cast<std::uint32_t>(representativeIndex) >= memberCount)
+            return nullptr;
+        loadedRepresentative = loadedMembers[representativeIndex];
+    }
+
+    if (!reader.ok())
+        return nullptr;
+
+    auto species = std::make_shared<Species>(loadedRepresentative);
+    species->id = loadedId;
+    species->members = std::move(loadedMembers);
+    species->averageFitness = loadedAverage;
+    species->bestFitness = loadedBest;
+    species->staleness = loadedStaleness;
+    species->maxStaleness = loadedMaxStaleness;
+    return species;
+}
@@ -4,6 +4,9 @@
 #include <vector>
 #include <memory>
 
+class BinaryWriter;
+class BinaryReader;
+
 class Species
 {
 private:
@@ -12,6 +15,7 @@ private:
     double bestFitness;
     int staleness; // generations without improvement
     int maxStaleness;
+    int id;        // Assigned by the population, kept by the species that continues this one next generation
 
     // Representative member (first member added)
     std::shared_ptr<NeuralNetwork> representative;
@@ -46,6 +50,11 @@ public:
     // Clear all members except the best one
     void cullToBest();
 
+    // Binary species state: statistics, representative and member genomes
+    void serialize(BinaryWriter &writer) const;
+    // Returns nullptr if the data is invalid
+    static std::shared_ptr<Species> deserialize(BinaryReader &reader);
+
     // Getters
     int getSize() const { return members.size(); }
     double getAverageFitness() const { return averageFitness; }
@@ -53,7 +62,9 @@ public:
     int getStaleness() const { return staleness; }
     const std::vector<std::shared_ptr<NeuralNetwork>> &getMembers() const { return members; }
     std::shared_ptr<NeuralNetwork> getRepresentative() const { return representative; }
+    int getId() const { return id; }
 
     // Setters
     void setMaxStaleness(int max) { maxStaleness = max; }
+    void setId(int newId) { id = newId; }
 };
\ No newline at end of file
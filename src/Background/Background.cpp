@@ -1,38 +1,46 @@
 #include "Background.h"
+#include <cmath>
 
-Background::Background(unsigned int width, unsigned int height, unsigned int grid)
-    : windowWidth(width), windowHeight(height), gridSize(grid)
+Background::Background(unsigned int grid)
+    : gridSize(grid), gridLines(sf::PrimitiveType::Lines)
 {
 }
 
-void Background::draw(sf::RenderWindow& window) const
+void Background::draw(sf::RenderTarget& target) const
 {
-    // Clear the window with a dark gray color
-    window.clear(sf::Color(64, 64, 64));
+    // Clear the target with a dark gray color
+    target.clear(sf::Color(64, 64, 64));
 
-    // Draw a grid pattern
-    sf::RectangleShape line;
-    line.setFillColor(sf::Color(96, 96, 96));
+    // Visible world area (views are never rotated)
+    const sf::View &view = target.getView();
+    sf::Vector2f topLeft = view.getCenter() - view.getSize() / 2.0f;
+    sf::Vector2f bottomRight = view.getCenter() + view.getSize() / 2.0f;
+
+    // Use a coarser grid when zoomed out so lines stay at least a few pixels apart
+    float spacing = static_cast<float>(gridSize);
+    float pixelsPerUnit = static_cast<float>(target.getSize().x) / view.getSize().x;
+    while (spacing * pixelsPerUnit < 8.0f)
+    {
+        spacing *= 2.0f;
+    }
+
+    // Draw a grid pattern (one pixel wide lines at any zoom)
+    const sf::Color lineColor(96, 96, 96);
+    gridLines.clear();
 
     // Draw vertical lines
-    for (unsigned int x = 0; x <= windowWidth; x += gridSize)
+    for (float x = std::floor(topLeft.x / spacing) * spacing; x <= bottomRight.x; x += spacing)
     {
-        line.setSize(sf::Vector2f(1, windowHeight));
-        line.setPosition(sf::Vector2f(x, 0));
-        window.draw(line);
+        gridLines.append(sf::Vertex{sf::Vector2f(x, topLeft.y), lineColor});
+        gridLines.append(sf::Vertex{sf::Vector2f(x, bottomRight.y), lineColor});
     }
 
     // Draw horizontal lines
-    for (unsigned int y = 0; y <= windowHeight; y += gridSize)
+    for (float y = std::floor(topLeft.y / spacing) * spacing; y <= bottomRight.y; y += spacing)
     {
-        line.setSize(sf::Vector2f(windowWidth, 1));
-        line.setPosition(sf::Vector2f(0, y));
-        window.draw(line);
+        gridLines.append(sf::Vertex{sf::Vector2f(topLeft.x, y), lineColor});
+        gridLines.append(sf::Vertex{sf::Vector2f(bottomRight.x, y), lineColor});
     }
-}
 
-void Background::setWindowSize(unsigned int width, unsigned int height)
-{
-    windowWidth = width;
-    windowHeight = height;
-}
\ No newline at end of file
+    target.draw(gridLines);
+}
@@ -5,12 +5,12 @@
 class Background : public IRenderable
 {
 private:
-    unsigned int windowWidth;
-    unsigned int windowHeight;
     unsigned int gridSize;
+    mutable sf::VertexArray gridLines; // Rebuilt for the visible area on every draw
 
 public:
-    Background(unsigned int width, unsigned int height, unsigned int grid = 32);
-    void draw(sf::RenderWindow &window) const override;
-    void setWindowSize(unsigned int width, unsigned int height);
-};
\ No newline at end of file
+    Background(unsigned int grid = 32);
+
+    // Clear the target and draw the grid over the part of the world its view shows
+    void draw(sf::RenderTarget &target) const override;
+};
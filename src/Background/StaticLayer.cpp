@@ -0,0 +1,58 @@
+#include "StaticLayer.h"
+#include "Background.h"
+#include "../Track/track.h"
+
+StaticLayer::StaticLayer()
+    : valid(false), available(true), viewCenter(0.0f, 0.0f), viewSize(0.0f, 0.0f),
+      lastCenter(0.0f, 0.0f), lastSize(0.0f, 0.0f)
+{
+}
+
+bool StaticLayer::update(const sf::RenderTarget &target, const Background &background, const Track &track)
+{
+    if (!available)
+        return false;
+
+    const sf::View &view = target.getView();
+    if (valid && view.getCenter() == viewCenter && view.getSize() == viewSize)
+        return true;
+
+    // The camera is still moving, redrawing the composite every frame would cost more than drawing directly
+    bool moving = view.getCenter() != lastCenter || view.getSize() != lastSize;
+    lastCenter = view.getCenter();
+    lastSize = view.getSize();
+    if (moving)
+        return false;
+
+    // Match the window size (only reallocates when the size changed)
+    sf::Vector2u windowSize = target.getSize();
+    if (texture.getSize() != windowSize)
+    {
+        if (!texture.resize(windowSize))
+        {
+            // Fall back to drawing the background and track directly
+            available = false;
+            return false;
+        }
+    }
+
+    // Render the static scene with the window's view so it lines up with the dynamic objects
+    texture.setView(view);
+    background.draw(texture);
+    track.draw(texture);
+    texture.display();
+
+    viewCenter = view.getCenter();
+    viewSize = view.getSize();
+    valid = true;
+    return true;
+}
+
+void StaticLayer::draw(sf::RenderTarget &target) const
+{
+    // The texture covers the whole target, blit it in pixel coordinates
+    sf::View view = target.getView();
+    target.setView(sf::View(sf::FloatRect(sf::Vector2f(0.0f, 0.0f), sf::Vector2f(target.getSize()))));
+    target.draw(sf::Sprite(texture.getTexture()));
+    target.setView(view);
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+
+// Forward declarations
+class Background;
+class Track;
+
+// Background grid and baked track composited into one cached texture
+// The layer is only redrawn when invalidated (window resized) or when the view changes,
+// every other frame the static scene costs a single blit.
+// While the camera moves the layer steps aside and the scene is drawn directly (no redraw + blit per frame).
+class StaticLayer
+{
+private:
+    sf::RenderTexture texture;
+    bool valid;     // Texture holds an up to date composite
+    bool available; // False if the render texture couldn't be created
+
+    // View the composite was rendered with
+    sf::Vector2f viewCenter;
+    sf::Vector2f viewSize;
+
+    // View seen by the last update, the composite is only rebuilt once the view stops changing
+    sf::Vector2f lastCenter;
+    sf::Vector2f lastSize;
+
+public:
+    StaticLayer();
+
+    // Force a redraw on the next update (call on resize)
+    void invalidate() { valid = false; }
+
+    // Redraw the composite if it is out of date, returns false if the layer can't be used this frame
+    bool update(const sf::RenderTarget &target, const Background &background, const Track &track);
+
+    // Blit the composite to the target
+    void draw(sf::RenderTarget &target) const;
+};
@@ -1,7 +1,6 @@
 #include "BezierShape.h"
+#include <algorithm>
 #include <cmath>
-#include <fstream>  // Added for file operations
-#include <iostream> // Added for console output
 
 BezierShape::BezierShape(sf::Vector2f start, sf::Vector2f control, sf::Vector2f end, float w, int segments, sf::Color c)
     : startPoint(start), controlPoint(control), endPoint(end), width(w), numSegments(segments), color(c)
@@ -9,23 +8,44 @@ BezierShape::BezierShape(sf::Vector2f start, sf::Vector2f control, sf::Vector2f
     generateSegments();
 }
 
-void BezierShape::draw(sf::RenderWindow &window) const
+void BezierShape::appendSegments(sf::VertexArray &vertices) const
 {
     for (const auto &segment : segments)
     {
-        window.draw(segment);
+        // Transform the rectangle corners exactly like drawing the shape would
+        const sf::Transform &transform = segment.getTransform();
+        sf::Vector2f corners[4];
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            corners[i] = transform.transformPoint(segment.getPoint(i));
+        }
+
+        // Two triangles per rectangle
+        sf::Color fill = segment.getFillColor();
+        vertices.append(sf::Vertex{corners[0], fill});
+        vertices.append(sf::Vertex{corners[1], fill});
+        vertices.append(sf::Vertex{corners[2], fill});
+        vertices.append(sf::Vertex{corners[0], fill});
+        vertices.append(sf::Vertex{corners[2], fill});
+        vertices.append(sf::Vertex{corners[3], fill});
     }
 }
 
-void BezierShape::drawEdgeCircles(sf::RenderWindow &window) const
+void BezierShape::appendEdgeCircles(sf::VertexArray &vertices) const
 {
-    // Create a small black circle
-    sf::CircleShape circle;
-    circle.setRadius(5.0f);
-    circle.setFillColor(sf::Color::Black);
-    circle.setOrigin({5.0f, 5.0f}); // Center the origin
+    // Small black circle as a triangle fan around its center
+    const float radius = 5.0f;
+    const int circlePoints = 16;
+    const sf::Color circleColor = sf::Color::Black;
+
+    sf::Vector2f circleOffsets[circlePoints];
+    for (int k = 0; k < circlePoints; ++k)
+    {
+        float angle = k * 2.0f * 3.14159f / circlePoints;
+        circleOffsets[k] = sf::Vector2f(std::cos(angle) * radius, std::sin(angle) * radius);
+    }
 
-    // Draw circles at each end of every 5th rectangle
+    // Circles at each end of every 5th rectangle
     for (size_t i = 0; i < segments.size(); ++i)
     {
         if (i % 5 != 0)
@@ -42,38 +62,106 @@ void BezierShape::drawEdgeCircles(sf::RenderWindow &window) const
         float cosRot = std::cos(rotation);
         float sinRot = std::sin(rotation);
 
-        // Top-left corner
-        sf::Vector2f topLeft = pos + sf::Vector2f(
-                                         -size.x / 2.0f * cosRot - size.y / 2.0f * sinRot,
-                                         -size.x / 2.0f * sinRot + size.y / 2.0f * cosRot);
+        sf::Vector2f corners[4] = {
+            // Top-left corner
+            pos + sf::Vector2f(-size.x / 2.0f * cosRot - size.y / 2.0f * sinRot,
+                               -size.x / 2.0f * sinRot + size.y / 2.0f * cosRot),
+            // Top-right corner
+            pos + sf::Vector2f(size.x / 2.0f * cosRot - size.y / 2.0f * sinRot,
+                               size.x / 2.0f * sinRot + size.y / 2.0f * cosRot),
+            // Bottom-left corner
+            pos + sf::Vector2f(-size.x / 2.0f * cosRot + size.y / 2.0f * sinRot,
+                               -size.x / 2.0f * sinRot - size.y / 2.0f * cosRot),
+            // Bottom-right corner
+            pos + sf::Vector2f(size.x / 2.0f * cosRot + size.y / 2.0f * sinRot,
+                               size.x / 2.0f * sinRot - size.y / 2.0f * cosRot)};
+
+        // Add a circle at each of the four corners
+        for (const auto &center : corners)
+        {
+            for (int k = 0; k < circlePoints; ++k)
+            {
+                vertices.append(sf::Vertex{center, circleColor});
+                vertices.append(sf::Vertex{center + circleOffsets[k], circleColor});
+                vertices.append(sf::Vertex{center + circleOffsets[(k + 1) % circlePoints], circleColor});
+            }
+        }
+    }
+}
 
-        // Top-right corner
-        sf::Vector2f topRight = pos + sf::Vector2f(
-                                          size.x / 2.0f * cosRot - size.y / 2.0f * sinRot,
-                                          size.x / 2.0f * sinRot + size.y / 2.0f * cosRot);
+void BezierShape::appendSimplifiedSegments(sf::VertexArray &vertices, int step) const
+{
+    if (segments.empty())
+        return;
+    step = std::max(step, 1);
 
-        // Bottom-left corner
-        sf::Vector2f bottomLeft = pos + sf::Vector2f(
-                                            -size.x / 2.0f * cosRot + size.y / 2.0f * sinRot,
-                                            -size.x / 2.0f * sinRot - size.y / 2.0f * cosRot);
+    // Keep every step-th segment center, always including both ends of the curve
+    std::vector<std::size_t> kept;
+    for (std::size_t i = 0; i < segments.size(); i += step)
+    {
+        kept.push_back(i);
+    }
+    if (kept.back() != segments.size() - 1)
+    {
+        kept.push_back(segments.size() - 1);
+    }
 
-        // Bottom-right corner
-        sf::Vector2f bottomRight = pos + sf::Vector2f(
-                                             size.x / 2.0f * cosRot + size.y / 2.0f * sinRot,
-                                             size.x / 2.0f * sinRot - size.y / 2.0f * cosRot);
+    // Left and right edge of the strip at a segment center (across the segment's direction)
+    auto edges = [this](const sf::RectangleShape &segment, sf::Vector2f center, sf::Vector2f &left, sf::Vector2f &right)
+    {
+        float rotation = segment.getRotation().asRadians();
+        sf::Vector2f across(-std::sin(rotation) * width / 2.0f, std::cos(rotation) * width / 2.0f);
+        left = center + across;
+        right = center - across;
+    };
+
+    sf::Vector2f previousLeft, previousRight;
+    edges(segments[kept[0]], segments[kept[0]].getPosition(), previousLeft, previousRight);
 
-        // Draw circles at the four corners
-        circle.setPosition(topLeft);
-        window.draw(circle);
-        circle.setPosition(topRight);
-        window.draw(circle);
-        circle.setPosition(bottomLeft);
-        window.draw(circle);
-        circle.setPosition(bottomRight);
-        window.draw(circle);
+    // The last point is the end of the curve, so the strip covers it like the full detail segments do
+    for (std::size_t k = 1; k <= kept.size(); ++k)
+    {
+        sf::Vector2f left, right;
+        if (k < kept.size())
+            edges(segments[kept[k]], segments[kept[k]].getPosition(), left, right);
+        else
+            edges(segments.back(), endPoint, left, right);
+
+        vertices.append(sf::Vertex{previousLeft, color});
+        vertices.append(sf::Vertex{left, color});
+        vertices.append(sf::Vertex{right, color});
+        vertices.append(sf::Vertex{previousLeft, color});
+        vertices.append(sf::Vertex{right, color});
+        vertices.append(sf::Vertex{previousRight, color});
+
+        previousLeft = left;
+        previousRight = right;
     }
 }
 
+sf::FloatRect BezierShape::getBounds() const
+{
+    if (segments.empty())
+        return sf::FloatRect(startPoint, sf::Vector2f(0.0f, 0.0f));
+
+    sf::Vector2f minCorner = segments.front().getPosition();
+    sf::Vector2f maxCorner = minCorner;
+    for (const auto &segment : segments)
+    {
+        sf::Vector2f pos = segment.getPosition();
+        minCorner.x = std::min(minCorner.x, pos.x);
+        minCorner.y = std::min(minCorner.y, pos.y);
+        maxCorner.x = std::max(maxCorner.x, pos.x);
+        maxCorner.y = std::max(maxCorner.y, pos.y);
+    }
+
+    // Every rectangle and edge circle stays within the track width (plus the circle radius) of its center
+    float margin = width + 5.0f;
+    minCorner -= sf::Vector2f(margin, margin);
+    maxCorner += sf::Vector2f(margin, margin);
+    return sf::FloatRect(minCorner, maxCorner - minCorner);
+}
+
 std::vector<sf::Vector2f> BezierShape::getEdgePoints() const
 {
     std::vector<sf::Vector2f> edgePoints;
@@ -305,31 +393,3 @@ const std::vector<SegmentData> &BezierShape::getCheckpointSegments() const
 {
     return checkpointSegments;
 }
-
-void BezierShape::saveCheckpointSegmentsToBinaryFile(const std::string &filename) const
-{
-    std::ofstream file(filename, std::ios::binary);
-    if (!file.is_open())
-    {
-        std::cout << "Failed to open binary file: " << filename << std::endl;
-        return;
-    }
-
-    // Write number of segments
-    size_t numSegments = checkpointSegments.size();
-    file.write(reinterpret_cast<const char *>(&numSegments), sizeof(numSegments));
-
-    // Write each segment
-    for (const auto &segment : checkpointSegments)
-    {
-        file.write(reinterpret_cast<const char *>(&segment.position.x), sizeof(float));
-        file.write(reinterpret_cast<const char *>(&segment.position.y), sizeof(float));
-        file.write(reinterpret_cast<const char *>(&segment.size.x), sizeof(float));
-        file.write(reinterpret_cast<const char *>(&segment.size.y), sizeof(float));
-        file.write(reinterpret_cast<const char *>(&segment.rotation), sizeof(float));
-        file.write(reinterpret_cast<const char *>(&segment.segmentIndex), sizeof(int));
-    }
-
-    file.close();
-    std::cout << "Checkpoint segments saved to binary file: " << filename << std::endl;
-}
\ No newline at end of file
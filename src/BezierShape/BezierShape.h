@@ -28,11 +28,17 @@ private:
 public:
     BezierShape(sf::Vector2f start, sf::Vector2f control, sf::Vector2f end, float w, int segments = 40, sf::Color c = sf::Color(32, 32, 32));
 
-    // Draw the shape
-    void draw(sf::RenderWindow &window) const;
+    // Append the segment rectangles as triangles (for baking into one vertex buffer)
+    void appendSegments(sf::VertexArray &vertices) const;
 
-    // Draw black circles at the edges of each rectangle
-    void drawEdgeCircles(sf::RenderWindow &window) const;
+    // Append black circles at the edges of every 5th rectangle as triangles
+    void appendEdgeCircles(sf::VertexArray &vertices) const;
+
+    // Append a simplified surface (one quad strip through every step-th segment center) for zoomed out views
+    void appendSimplifiedSegments(sf::VertexArray &vertices, int step) const;
+
+    // World space bounds of the drawn shape, including the edge circles
+    sf::FloatRect getBounds() const;
 
     // Get the tangent at the start of the curve
     sf::Vector2f getStartTangent() const;
@@ -59,9 +65,6 @@ public:
     // Get checkpoint segments data
     const std::vector<SegmentData> &getCheckpointSegments() const;
 
-    // Save checkpoint segments to binary file (more efficient)
-    void saveCheckpointSegmentsToBinaryFile(const std::string &filename) const;
-
 private:
     // Generate the segments from the Bezier curve
     void generateSegments();
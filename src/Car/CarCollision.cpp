@@ -0,0 +1,193 @@
+#include "CarCollision.h"
+#include "car.h"
+#include <cmath>
+
+CarCollision::CarCollision()
+    : candidatePairs(0)
+{
+}
+
+CarBox CarCollision::makeBox(float x, float y, float rotationDegrees, float length, float width)
+{
+    CarBox box;
+    float radians = rotationDegrees * 3.14159f / 180.0f;
+    box.x = x;
+    box.y = y;
+    box.axisX = std::cos(radians);
+    box.axisY = std::sin(radians);
+    box.halfLength = length / 2.0f;
+    box.halfWidth = width / 2.0f;
+
+    // Extents of the rotated box on the world axes
+    float extentX = std::abs(box.axisX) * box.halfLength + std::abs(box.axisY) * box.halfWidth;
+    float extentY = std::abs(box.axisY) * box.halfLength + std::abs(box.axisX) * box.halfWidth;
+    box.minX = x - extentX;
+    box.maxX = x + extentX;
+    box.minY = y - extentY;
+    box.maxY = y + extentY;
+    box.active = true;
+    return box;
+}
+
+void CarCollision::updateBoxes(const std::vector<std::unique_ptr<Car>> &cars, const std::vector<bool> &active)
+{
+    // Keep the previous order when the car count doesn't change, it is nearly sorted already
+    if (boxes.size() != cars.size())
+    {
+        boxes.resize(cars.size());
+        sortedOrder.resize(cars.size());
+        for (size_t i = 0; i < sortedOrder.size(); ++i)
+            sortedOrder[i] = static_cast<int>(i);
+    }
+
+    for (size_t i = 0; i < cars.size(); ++i)
+    {
+        const VehicleState &state = cars[i]->getVehicleState();
+        sf::Vector2f size = cars[i]->getSize();
+        boxes[i] = makeBox(state.x, state.y, state.rotation, size.x, size.y);
+        boxes[i].active = i < active.size() && active[i];
+    }
+}
+
+const std::vector<CarContact> &CarCollision::findContacts()
+{
+    contacts.clear();
+    candidatePairs = 0;
+
+    // Insertion sort by minX: cars move little between frames so this is close to linear
+    for (size_t i = 1; i < sortedOrder.size(); ++i)
+    {
+        int index = sortedOrder[i];
+        float key = boxes[index].minX;
+        size_t j = i;
+        while (j > 0 && boxes[sortedOrder[j - 1]].minX > key)
+        {
+            sortedOrder[j] = sortedOrder[j - 1];
+            --j;
+        }
+        sortedOrder[j] = index;
+    }
+
+    // Sweep: only boxes whose x ranges overlap are compared
+    for (size_t i = 0; i < sortedOrder.size(); ++i)
+    {
+        const CarBox &a = boxes[sortedOrder[i]];
+        if (!a.active)
+            continue;
+
+        for (size_t j = i + 1; j < sortedOrder.size(); ++j)
+        {
+            const CarBox &b = boxes[sortedOrder[j]];
+            if (b.minX > a.maxX)
+                break; // Everything after this starts even further right
+
+            if (!b.active || b.minY > a.maxY || b.maxY < a.minY)
+                continue;
+
+            candidatePairs++;
+
+            CarContact contact;
+            if (testBoxes(a, b, contact))
+            {
+                contact.a = sortedOrder[i];
+                contact.b = sortedOrder[j];
+                contacts.push_back(contact);
+            }
+        }
+    }
+
+    return contacts;
+}
+
+bool CarCollision::testBoxes(const CarBox &a, const CarBox &b, CarContact &contact)
+{
+    float dx = b.x - a.x;
+    float dy = b.y - a.y;
+
+    // The four candidate separating axes: length and width axis of both boxes
+    const float axes[4][2] = {
+        {a.axisX, a.axisY},
+        {-a.axisY, a.axisX},
+        {b.axisX, b.axisY},
+        {-b.axisY, b.axisX},
+    };
+
+    float minOverlap = 0.0f;
+    int minAxis = -1;
+
+    for (int k = 0; k < 4; ++k)
+    {
+        float axisX = axes[k][0];
+        float axisY = axes[k][1];
+
+        // Projected radius of each box on this axis
+        float radiusA = a.halfLength * std::abs(a.axisX * axisX + a.axisY * axisY) +
+                        a.halfWidth * std::abs(-a.axisY * axisX + a.axisX * axisY);
+        float radiusB = b.halfLength * std::abs(b.axisX * axisX + b.axisY * axisY) +
+                        b.halfWidth * std::abs(-b.axisY * axisX + b.axisX * axisY);
+        float distance = std::abs(dx * axisX + dy * axisY);
+
+        float overlap = radiusA + radiusB - distance;
+        if (overlap <= 0.0f)
+            return false; // Found a separating axis
+
+        if (minAxis < 0 || overlap < minOverlap)
+        {
+            minOverlap = overlap;
+            minAxis = k;
+        }
+    }
+
+    // Push along the axis with the smallest overlap, pointing from a to b
+    contact.normalX = axes[minAxis][0];
+    contact.normalY = axes[minAxis][1];
+    if (dx * contact.normalX + dy * contact.normalY < 0.0f)
+    {
+        contact.normalX = -contact.normalX;
+        contact.normalY = -contact.normalY;
+    }
+    contact.depth = minOverlap;
+    return true;
+}
+
+void CarCollision::resolveContacts(std::vector<std::unique_ptr<Car>> &cars) const
+{
+    // Energy kept along the contact normal (0 = cars stick together, 1 = perfect bounce)
+    const float restitution = 0.2f;
+
+    for (const auto &contact : contacts)
+    {
+        Car &carA = *cars[contact.a];
+        Car &carB = *cars[contact.b];
+        sf::Vector2f normal(contact.normalX, contact.normalY);
+
+        // Heavier cars get pushed less
+        float inverseMassA = 1.0f / carA.getVehicleParams().mass;
+        float inverseMassB = 1.0f / carB.getVehicleParams().mass;
+        float inverseMassSum = inverseMassA + inverseMassB;
+
+        // Separate the boxes
+        sf::Vector2f correction = normal * (contact.depth / inverseMassSum);
+        sf::Vector2f offsetA = -correction * inverseMassA;
+        sf::Vector2f offsetB = correction * inverseMassB;
+
+        // Only remove velocity if the cars are moving towards each other
+        sf::Vector2f relativeVelocity = carB.getVelocity() - carA.getVelocity();
+        float closingSpeed = relativeVelocity.x * normal.x + relativeVelocity.y * normal.y;
+        sf::Vector2f impulse(0.0f, 0.0f);
+        if (closingSpeed < 0.0f)
+        {
+            impulse = normal * (-(1.0f + restitution) * closingSpeed / inverseMassSum);
+        }
+
+        carA.applyContact(offsetA, -impulse * inverseMassA);
+        carB.applyContact(offsetB, impulse * inverseMassB);
+    }
+}
+
+void CarCollision::step(std::vector<std::unique_ptr<Car>> &cars, const std::vector<bool> &active)
+{
+    updateBoxes(cars, active);
+    findContacts();
+    resolveContacts(cars);
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <vector>
+
+class Car;
+
+// Oriented box of one car, built from its physics state
+struct CarBox
+{
+    float x, y;                // Center
+    float axisX, axisY;        // Unit vector along the car (heading)
+    float halfLength;          // Half extent along the heading
+    float halfWidth;           // Half extent across the heading
+    float minX, minY;          // Axis aligned bounds of the box
+    float maxX, maxY;
+    bool active;               // Only active cars take part in collisions
+};
+
+// Two overlapping cars, the normal points from car a to car b
+struct CarContact
+{
+    int a, b;
+    float normalX, normalY;
+    float depth;
+};
+
+// Car-to-car collisions: sort-and-sweep on x over the car AABBs, oriented box test for the candidates
+class CarCollision
+{
+private:
+    std::vector<CarBox> boxes;    // Indexed by car index
+    std::vector<int> sortedOrder; // Car indices sorted by minX, kept between frames
+    std::vector<CarContact> contacts;
+
+    // Stats of the last detection pass
+    int candidatePairs;
+
+    // Separating axis test, fills the contact if the boxes overlap
+    static bool testBoxes(const CarBox &a, const CarBox &b, CarContact &contact);
+
+public:
+    CarCollision();
+
+    // Rebuild the boxes from the cars (cars with active[i] == false are ignored)
+    void updateBoxes(const std::vector<std::unique_ptr<Car>> &cars, const std::vector<bool> &active);
+
+    // Find all overlapping pairs of active cars
+    const std::vector<CarContact> &findContacts();
+
+    // Push overlapping cars apart and remove the closing velocity between them
+    void resolveContacts(std::vector<std::unique_ptr<Car>> &cars) const;
+
+    // Detect and resolve in one call
+    void step(std::vector<std::unique_ptr<Car>> &cars, const std::vector<bool> &active);
+
+    // Build the oriented box (and its AABB) of a car at a given pose
+    static CarBox makeBox(float x, float y, float rotationDegrees, float length, float width);
+
+    const std::vector<CarContact> &getContacts() const { return contacts; }
+    int getCandidatePairCount() const { return candidatePairs; }
+};
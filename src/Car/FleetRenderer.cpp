@@ -0,0 +1,102 @@
+#include "FleetRenderer.h"
+#include <cmath>
+
+FleetRenderer::FleetRenderer(float carWidth, float carHeight)
+    : vertices(sf::PrimitiveType::Triangles), carCount(0), cullMargin(0.0f)
+{
+    // Same parts, sizes and offsets as CarShape, in the same draw order
+    // Main body
+    addTemplatePart({0.0f, 0.0f}, {carWidth, carHeight}, sf::Color::Red);
+    // Hood (front)
+    addTemplatePart({carWidth * 0.3f, 0.0f}, {carWidth * 0.4f, carHeight * 0.8f}, sf::Color(200, 0, 0));
+    // Trunk (back)
+    addTemplatePart({-carWidth * 0.25f, 0.0f}, {carWidth * 0.3f, carHeight * 0.7f}, sf::Color(180, 0, 0));
+    // Windows (top)
+    addTemplatePart({carWidth * 0.1f, 0.0f}, {carWidth * 0.6f, carHeight * 0.4f}, sf::Color(100, 150, 255));
+
+    // Wheels
+    sf::Vector2f wheelSize(carWidth * 0.15f, carHeight * 0.3f);
+    float wheelOffsetX = carWidth * 0.35f;
+    float wheelOffsetY = carHeight * 0.4f;
+    addTemplatePart({wheelOffsetX, wheelOffsetY}, wheelSize, sf::Color::Black);
+    addTemplatePart({wheelOffsetX, -wheelOffsetY}, wheelSize, sf::Color::Black);
+    addTemplatePart({-wheelOffsetX, wheelOffsetY}, wheelSize, sf::Color::Black);
+    addTemplatePart({-wheelOffsetX, -wheelOffsetY}, wheelSize, sf::Color::Black);
+
+    // Headlights
+    sf::Vector2f headlightSize(carWidth * 0.1f, carHeight * 0.2f);
+    float headlightOffsetX = carWidth * 0.45f;
+    float headlightOffsetY = carHeight * 0.25f;
+    addTemplatePart({headlightOffsetX, headlightOffsetY}, headlightSize, sf::Color::White);
+    addTemplatePart({headlightOffsetX, -headlightOffsetY}, headlightSize, sf::Color::White);
+
+    // A car is visible if any part of it can be on screen
+    cullMargin = std::sqrt(carWidth * carWidth + carHeight * carHeight) / 2.0f;
+}
+
+void FleetRenderer::addTemplatePart(sf::Vector2f center, sf::Vector2f size, sf::Color color)
+{
+    sf::Vector2f half = size / 2.0f;
+    sf::Vector2f topLeft = center + sf::Vector2f(-half.x, -half.y);
+    sf::Vector2f topRight = center + sf::Vector2f(half.x, -half.y);
+    sf::Vector2f bottomRight = center + sf::Vector2f(half.x, half.y);
+    sf::Vector2f bottomLeft = center + sf::Vector2f(-half.x, half.y);
+
+    carTemplate.push_back({topLeft, color});
+    carTemplate.push_back({topRight, color});
+    carTemplate.push_back({bottomRight, color});
+    carTemplate.push_back({topLeft, color});
+    carTemplate.push_back({bottomRight, color});
+    carTemplate.push_back({bottomLeft, color});
+}
+
+void FleetRenderer::begin(const sf::FloatRect &visibleArea)
+{
+    // Keeps the allocated capacity, so a steady fleet doesn't allocate per frame
+    vertices.clear();
+    carCount = 0;
+    cullBounds = visibleArea;
+}
+
+void FleetRenderer::addCar(float x, float y, float rotationDegrees, std::uint8_t alpha)
+{
+    // Skip cars that are completely off screen
+    if (x + cullMargin < cullBounds.position.x || x - cullMargin > cullBounds.position.x + cullBounds.size.x ||
+        y + cullMargin < cullBounds.position.y || y - cullMargin > cullBounds.position.y + cullBounds.size.y)
+        return;
+
+    float radians = rotationDegrees * 3.14159f / 180.0f;
+    float cosRot = std::cos(radians);
+    float sinRot = std::sin(radians);
+
+    // Write the transformed template directly into the vertex array
+    std::size_t first = vertices.getVertexCount();
+    vertices.resize(first + carTemplate.size());
+    for (std::size_t i = 0; i < carTemplate.size(); ++i)
+    {
+        const TemplateVertex &part = carTemplate[i];
+        sf::Vertex &vertex = vertices[first + i];
+        vertex.position = sf::Vector2f(x + part.offset.x * cosRot - part.offset.y * sinRot,
+                                       y + part.offset.x * sinRot + part.offset.y * cosRot);
+        vertex.color = part.color;
+        vertex.color.a = alpha;
+    }
+
+    carCount++;
+}
+
+void FleetRenderer::draw(sf::RenderTarget &target) const
+{
+    if (vertices.getVertexCount() == 0)
+        return;
+
+    target.draw(vertices);
+}
+
+sf::FloatRect FleetRenderer::getViewBounds(const sf::View &view)
+{
+    // The game's views are never rotated, so the visible area is the view rectangle
+    sf::Vector2f size = view.getSize();
+    sf::Vector2f center = view.getCenter();
+    return sf::FloatRect(center - size / 2.0f, size);
+}
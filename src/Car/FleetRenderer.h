@@ -0,0 +1,48 @@
+#pragma once
+#include "../Interfaces/IRenderable.h"
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+// Renders every car in one draw call
+// The car body parts (same layout as CarShape) are precomputed in car space once,
+// each frame the visible cars are transformed straight into a single triangle list
+class FleetRenderer : public IRenderable
+{
+private:
+    // One vertex of the car template, relative to the car center with the car facing +x
+    struct TemplateVertex
+    {
+        sf::Vector2f offset;
+        sf::Color color;
+    };
+
+    std::vector<TemplateVertex> carTemplate;
+    sf::VertexArray vertices;
+    std::size_t carCount;
+
+    // Cars outside this rectangle are skipped
+    sf::FloatRect cullBounds;
+    float cullMargin;
+
+    // Add one rectangle (center, size in car space) to the template as two triangles
+    void addTemplatePart(sf::Vector2f center, sf::Vector2f size, sf::Color color);
+
+public:
+    FleetRenderer(float carWidth = 20.0f, float carHeight = 10.0f);
+
+    // Start a new frame, only cars inside the visible area will be added
+    void begin(const sf::FloatRect &visibleArea);
+
+    // Add a car at a pose (alpha < 255 draws it translucent)
+    void addCar(float x, float y, float rotationDegrees, std::uint8_t alpha = 255);
+
+    // Number of cars added since begin()
+    std::size_t getCarCount() const { return carCount; }
+
+    // IRenderable interface implementation
+    void draw(sf::RenderTarget &target) const override;
+
+    // Visible area of a view
+    static sf::FloatRect getViewBounds(const sf::View &view);
+};
@@ -1,34 +1,14 @@
 #include "RaySensor.h"
 #include <cmath>
 
-RaySensor::RaySensor(float angle)
-    : angle(angle), currentLength(150.0f), maxLength(150.0f)
+RaySensor::RaySensor(float angle, float maxLength)
+    : angle(angle), currentLength(maxLength), maxLength(maxLength)
 {
-    // Create a thin rectangle for the ray with initial length of 150
-    shape.setSize(sf::Vector2f(currentLength, 2.0f)); // 150 pixels long, 2 pixels wide
-    shape.setOrigin(sf::Vector2f(0.0f, 1.0f));        // Origin at left center
-    shape.setFillColor(sf::Color::Cyan);
-}
-
-void RaySensor::setPosition(const sf::Vector2f &carPosition, float carRotation)
-{
-    // Calculate the ray's absolute angle
-    float absoluteAngle = carRotation + angle;
-
-    // Set position and rotation
-    shape.setPosition(carPosition);
-    shape.setRotation(sf::degrees(absoluteAngle));
-}
-
-void RaySensor::setColor(const sf::Color &color)
-{
-    shape.setFillColor(color);
 }
 
 void RaySensor::setLength(float length)
 {
     currentLength = std::min(length, maxLength);
-    shape.setSize(sf::Vector2f(currentLength, 2.0f));
 }
 
 sf::Vector2f RaySensor::getEndPoint(const sf::Vector2f &carPosition, float carRotation) const
@@ -43,9 +23,3 @@ sf::Vector2f RaySensor::getEndPoint(const sf::Vector2f &carPosition, float carRo
 
     return sf::Vector2f(endX, endY);
 }
-
-void RaySensor::draw(sf::RenderWindow &window) const
-{
-    // Make rays invisible by not drawing them
-    // window.draw(shape);
-}
\ No newline at end of file
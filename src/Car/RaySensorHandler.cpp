@@ -28,11 +28,12 @@ RaySensorHandler::RaySensorHandler()
     // RaySensorHandler initialized silently
 }
 
-void RaySensorHandler::updateRays(const sf::Vector2f &carPosition, float carRotation)
+void RaySensorHandler::setLayout(const std::vector<float> &angles, float range)
 {
-    for (auto &ray : raySensors)
+    raySensors.clear();
+    for (float angle : angles)
     {
-        ray.setPosition(carPosition, carRotation);
+        raySensors.emplace_back(angle, range);
     }
 }
 
@@ -47,8 +48,6 @@ void RaySensorHandler::checkCollisions(const sf::Vector2f &carPosition, float ca
         return;
     }
 
-    int redRays = 0;
-
     for (size_t i = 0; i < raySensors.size(); ++i)
     {
         auto &ray = raySensors[i];
@@ -85,22 +84,6 @@ void RaySensorHandler::checkCollisions(const sf::Vector2f &carPosition, float ca
 
         // Set the ray to the optimal length
         ray.setLength(optimalLength);
-
-        // Get final end point for collision check
-        endPoint = ray.getEndPoint(carPosition, carRotation);
-        bool intersectsInner = checkRayIntersectsEdges(carPosition, endPoint, innerEdgePoints);
-        bool intersectsOuter = checkRayIntersectsEdges(carPosition, endPoint, outerEdgePoints);
-
-        // Set color based on collision state
-        if (intersectsInner || intersectsOuter)
-        {
-            ray.setColor(sf::Color::Red);
-            redRays++;
-        }
-        else
-        {
-            ray.setColor(sf::Color::Cyan);
-        }
     }
 }
 
@@ -207,14 +190,6 @@ bool RaySensorHandler::isPointNearEdge(const sf::Vector2f &point,
     return false;
 }
 
-void RaySensorHandler::draw(sf::RenderWindow &window) const
-{
-    for (const auto &ray : raySensors)
-    {
-        ray.draw(window);
-    }
-}
-
 std::vector<float> RaySensorHandler::getRayLengths() const
 {
     std::vector<float> lengths;
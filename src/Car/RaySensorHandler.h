@@ -13,20 +13,21 @@ private:
 public:
     RaySensorHandler();
 
-    // Update ray positions based on car position and rotation
-    void updateRays(const sf::Vector2f &carPosition, float carRotation);
+    // Replace the rays (angles in degrees relative to the car, all with the same range)
+    void setLayout(const std::vector<float> &angles, float range);
 
-    // Check collisions with track edges and update ray colors
+    // Check collisions with track edges and update ray lengths
     void checkCollisions(const sf::Vector2f &carPosition, float carRotation,
                          const std::vector<sf::Vector2f> &innerEdgePoints,
                          const std::vector<sf::Vector2f> &outerEdgePoints);
 
-    // Draw all ray sensors
-    void draw(sf::RenderWindow &window) const;
-
     // Get ray lengths for AI input
     std::vector<float> getRayLengths() const;
 
+    // Direct access to the rays (no copies)
+    size_t getRayCount() const { return raySensors.size(); }
+    const RaySensor &getRay(size_t index) const { return raySensors[index]; }
+
 private:
     // Helper method to check if a point is within 5 pixels of any edge point
     bool isPointNearEdge(const sf::Vector2f &point,
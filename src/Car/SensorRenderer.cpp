@@ -0,0 +1,54 @@
+#include "SensorRenderer.h"
+#include <algorithm>
+#include <cmath>
+
+SensorRenderer::SensorRenderer()
+    : lines(sf::PrimitiveType::Lines), clearColor(sf::Color::Cyan), hitColor(sf::Color::Red)
+{
+}
+
+void SensorRenderer::begin(const sf::FloatRect &visibleArea)
+{
+    // Keeps the allocated capacity between frames
+    lines.clear();
+    cullBounds = visibleArea;
+}
+
+void SensorRenderer::addCar(float x, float y, float rotationDegrees, const float *angles, const float *distances,
+                            std::size_t rayCount, float maxDistance)
+{
+    // No ray is longer than maxDistance, so a car further than that from the screen can't show any
+    if (x + maxDistance < cullBounds.position.x || x - maxDistance > cullBounds.position.x + cullBounds.size.x ||
+        y + maxDistance < cullBounds.position.y || y - maxDistance > cullBounds.position.y + cullBounds.size.y)
+        return;
+
+    std::size_t first = lines.getVertexCount();
+    lines.resize(first + rayCount * 2);
+
+    for (std::size_t r = 0; r < rayCount; ++r)
+    {
+        float radians = (rotationDegrees + angles[r]) * 3.14159f / 180.0f;
+        float distance = distances[r];
+
+        // Blend from the hit color (blocked close to the car) to the clear color (full range)
+        float t = maxDistance > 0.0f ? std::min(distance / maxDistance, 1.0f) : 1.0f;
+        sf::Color color(static_cast<std::uint8_t>(hitColor.r + (clearColor.r - hitColor.r) * t),
+                        static_cast<std::uint8_t>(hitColor.g + (clearColor.g - hitColor.g) * t),
+                        static_cast<std::uint8_t>(hitColor.b + (clearColor.b - hitColor.b) * t));
+
+        sf::Vertex &start = lines[first + r * 2];
+        sf::Vertex &end = lines[first + r * 2 + 1];
+        start.position = sf::Vector2f(x, y);
+        end.position = sf::Vector2f(x + std::cos(radians) * distance, y + std::sin(radians) * distance);
+        start.color = color;
+        end.color = color;
+    }
+}
+
+void SensorRenderer::draw(sf::RenderTarget &target) const
+{
+    if (lines.getVertexCount() == 0)
+        return;
+
+    target.draw(lines);
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include "../Interfaces/IRenderable.h"
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+
+// Optional debug layer that draws the ray sensors of many cars as one line batch
+// Built from the sensor distances only, the simulation never touches any graphics objects for it
+class SensorRenderer : public IRenderable
+{
+private:
+    sf::VertexArray lines;
+
+    // Cars outside this rectangle are skipped
+    sf::FloatRect cullBounds;
+
+    sf::Color clearColor; // Ray that reaches its full range
+    sf::Color hitColor;   // Ray blocked right at the car
+
+public:
+    SensorRenderer();
+
+    // Start a new frame, only cars whose rays can reach the visible area will be added
+    void begin(const sf::FloatRect &visibleArea);
+
+    // Add the rays of one car (angles relative to the car in degrees, distances in pixels)
+    void addCar(float x, float y, float rotationDegrees, const float *angles, const float *distances,
+                std::size_t rayCount, float maxDistance);
+
+    // IRenderable interface implementation
+    void draw(sf::RenderTarget &target) const override;
+};
@@ -0,0 +1,74 @@
+#include "StuckDetector.h"
+
+StuckDetector::StuckDetector(float checkInterval, float minDistance, float maxStuckTime)
+    : checkInterval(checkInterval), minDistance(minDistance), maxStuckTime(maxStuckTime)
+{
+}
+
+void StuckDetector::resize(size_t carCount)
+{
+    states.resize(carCount);
+}
+
+void StuckDetector::reset(size_t carIndex, const sf::Vector2f &position)
+{
+    if (carIndex >= states.size())
+        return;
+
+    states[carIndex] = CarState();
+    states[carIndex].anchorPosition = position;
+}
+
+void StuckDetector::resetAll(const sf::Vector2f &position)
+{
+    for (auto &state : states)
+    {
+        state = CarState();
+        state.anchorPosition = position;
+    }
+}
+
+bool StuckDetector::update(size_t carIndex, const sf::Vector2f &position, float deltaTime)
+{
+    if (carIndex >= states.size())
+        return false;
+
+    CarState &state = states[carIndex];
+
+    // Only compare positions once per check interval (per car, not a shared frame counter)
+    state.timeSinceCheck += deltaTime;
+    if (state.timeSinceCheck < checkInterval)
+        return false;
+
+    float elapsed = state.timeSinceCheck;
+    state.timeSinceCheck = 0.0f;
+
+    // Compare squared distances, no square root needed
+    float dx = position.x - state.anchorPosition.x;
+    float dy = position.y - state.anchorPosition.y;
+    state.anchorPosition = position;
+
+    if (dx * dx + dy * dy < minDistance * minDistance)
+    {
+        // Count the whole interval since the last check, not just the last frame
+        state.stuckTime += elapsed;
+        if (state.stuckTime > maxStuckTime)
+        {
+            state.stuckTime = 0.0f;
+            return true;
+        }
+    }
+    else
+    {
+        state.stuckTime = 0.0f;
+    }
+
+    return false;
+}
+
+float StuckDetector::getStuckTime(size_t carIndex) const
+{
+    if (carIndex >= states.size())
+        return 0.0f;
+    return states[carIndex].stuckTime;
+}
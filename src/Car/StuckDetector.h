@@ -0,0 +1,41 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Per-car stuck detection stored in a dense array indexed by car
+// Each car only touches its own entry, so cars can be stepped in any order (or in parallel)
+class StuckDetector
+{
+private:
+    struct CarState
+    {
+        sf::Vector2f anchorPosition; // Position at the last movement check
+        float timeSinceCheck;        // Time accumulated since the last movement check
+        float stuckTime;             // How long the car has been barely moving
+
+        CarState() : anchorPosition(0.0f, 0.0f), timeSinceCheck(0.0f), stuckTime(0.0f) {}
+    };
+
+    std::vector<CarState> states;
+
+    float checkInterval; // Seconds between movement checks
+    float minDistance;   // Moving less than this in one check interval counts as not moving
+    float maxStuckTime;  // Seconds without moving before a car is considered stuck
+
+public:
+    StuckDetector(float checkInterval = 0.16f, float minDistance = 5.0f, float maxStuckTime = 3.0f);
+
+    // Set the number of tracked cars
+    void resize(size_t carCount);
+    size_t size() const { return states.size(); }
+
+    // Reset one car or all cars to a start position
+    void reset(size_t carIndex, const sf::Vector2f &position);
+    void resetAll(const sf::Vector2f &position);
+
+    // Advance the car's state by one simulation step, returns true when the car is stuck
+    bool update(size_t carIndex, const sf::Vector2f &position, float deltaTime);
+
+    // Time the car has currently been stuck for
+    float getStuckTime(size_t carIndex) const;
+};
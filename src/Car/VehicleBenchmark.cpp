@@ -0,0 +1,45 @@
+#include "VehicleBenchmark.h"
+#include "VehicleDynamics.h"
+#include <chrono>
+#include <vector>
+
+// Measure the cost of one car-step of the vehicle model (RaceCar bench reports it)
+VehicleBenchmarkResult benchmarkVehicleDynamics(int carCount, int steps)
+{
+    VehicleDynamics dynamics;
+    std::vector<VehicleState> states(carCount);
+    std::vector<float> steering(carCount);
+    std::vector<float> throttle(carCount);
+
+    // Give every car a different input so the cars spread over all driving regimes
+    for (int i = 0; i < carCount; ++i)
+    {
+        steering[i] = (i % 21) / 10.0f - 1.0f;
+        throttle[i] = (i % 7) / 3.0f - 1.0f;
+    }
+
+    const float deltaTime = 1.0f / 60.0f;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int step = 0; step < steps; ++step)
+    {
+        dynamics.stepBatch(states.data(), steering.data(), throttle.data(), states.size(), deltaTime);
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double carSteps = static_cast<double>(carCount) * steps;
+
+    // Use the result so the loop can't be optimized away
+    double checksum = 0.0;
+    for (const auto &state : states)
+        checksum += state.x + state.y;
+
+    VehicleBenchmarkResult result;
+    result.carCount = carCount;
+    result.steps = steps;
+    result.seconds = seconds;
+    result.nanosecondsPerCarStep = carSteps > 0.0 ? seconds * 1e9 / carSteps : 0.0;
+    result.checksum = checksum;
+    return result;
+}
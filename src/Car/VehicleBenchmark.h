@@ -0,0 +1,14 @@
+#pragma once
+
+// Cost of the vehicle model alone (no sensors, no networks, no track)
+struct VehicleBenchmarkResult
+{
+    int carCount;
+    int steps;
+    double seconds;
+    double nanosecondsPerCarStep;
+    double checksum; // Sum of the final positions, the same inputs always give the same value
+};
+
+// Step carCount cars with fixed, varied inputs through stepBatch for the given number of 60 Hz steps
+VehicleBenchmarkResult benchmarkVehicleDynamics(int carCount = 10000, int steps = 600);
@@ -0,0 +1,266 @@
+#include "VehicleDynamics.h"
+#include "../Logging/Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+
+VehicleParams::VehicleParams()
+    : name("default"),
+      mass(1.0f), yawInertia(42.0f), cgToFront(7.0f), cgToRear(7.0f),
+      corneringStiffnessFront(7000.0f), corneringStiffnessRear(7500.0f),
+      maxGripFront(700.0f), maxGripRear(750.0f),
+      engineForce(600.0f), brakeForce(900.0f), reverseForce(400.0f), maxReverseSpeed(150.0f),
+      dragCoefficient(0.0018f), rollingResistance(150.0f),
+      maxSteerAngle(30.0f), kinematicSpeed(40.0f), maxSubstep(1.0f / 120.0f)
+{
+    // Defaults roughly match the old kinematic car: ~500 px/s top speed and tight turns
+}
+
+bool VehicleParams::loadFromFile(const std::string &filename, const std::string &className)
+{
+    std::ifstream file(filename);
+    if (!file.is_open())
+    {
+        LOG_WARNING("Vehicle config " << filename << " not found, using default vehicle");
+        return false;
+    }
+
+    // Keys of the vehicle class
+    struct Key
+    {
+        const char *name;
+        float *value;
+    };
+    const Key keys[] = {
+        {"mass", &mass},
+        {"yawInertia", &yawInertia},
+        {"cgToFront", &cgToFront},
+        {"cgToRear", &cgToRear},
+        {"corneringStiffnessFront", &corneringStiffnessFront},
+        {"corneringStiffnessRear", &corneringStiffnessRear},
+        {"maxGripFront", &maxGripFront},
+        {"maxGripRear", &maxGripRear},
+        {"engineForce", &engineForce},
+        {"brakeForce", &brakeForce},
+        {"reverseForce", &reverseForce},
+        {"maxReverseSpeed", &maxReverseSpeed},
+        {"dragCoefficient", &dragCoefficient},
+        {"rollingResistance", &rollingResistance},
+        {"maxSteerAngle", &maxSteerAngle},
+        {"kinematicSpeed", &kinematicSpeed},
+        {"maxSubstep", &maxSubstep},
+    };
+
+    auto trim = [](std::string text)
+    {
+        size_t first = text.find_first_not_of(" \t\r");
+        size_t last = text.find_last_not_of(" \t\r");
+        return first == std::string::npos ? std::string() : text.substr(first, last - first + 1);
+    };
+
+    bool inClass = false;
+    bool found = false;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        line = trim(line.substr(0, line.find_first_of(";#")));
+        if (line.empty())
+            continue;
+
+        // Section header
+        if (line.front() == '[' && line.back() == ']')
+        {
+            inClass = trim(line.substr(1, line.size() - 2)) == className;
+            found = found || inClass;
+            continue;
+        }
+
+        if (!inClass)
+            continue;
+
+        size_t equals = line.find('=');
+        if (equals == std::string::npos)
+            continue;
+
+        std::string key = trim(line.substr(0, equals));
+        std::string value = trim(line.substr(equals + 1));
+
+        bool known = false;
+        for (const auto &entry : keys)
+        {
+            if (key == entry.name)
+            {
+                *entry.value = std::strtof(value.c_str(), nullptr);
+                known = true;
+                break;
+            }
+        }
+
+        if (!known)
+        {
+            LOG_WARNING("Unknown vehicle key '" << key << "' in " << filename);
+        }
+    }
+
+    if (!found)
+    {
+        LOG_WARNING("Vehicle class '" << className << "' not found in " << filename);
+        return false;
+    }
+
+    name = className;
+    return true;
+}
+
+VehicleDynamics::VehicleDynamics()
+{
+    setParams(VehicleParams());
+}
+
+VehicleDynamics::VehicleDynamics(const VehicleParams &params)
+{
+    setParams(params);
+}
+
+void VehicleDynamics::setParams(const VehicleParams &newParams)
+{
+    params = newParams;
+
+    // Guard against broken config values instead of producing NaNs later
+    params.mass = std::max(params.mass, 0.001f);
+    params.yawInertia = std::max(params.yawInertia, 0.001f);
+    params.kinematicSpeed = std::max(params.kinematicSpeed, 1.0f);
+    params.maxSubstep = std::max(params.maxSubstep, 0.0005f);
+
+    inverseMass = 1.0f / params.mass;
+    inverseInertia = 1.0f / params.yawInertia;
+    wheelbase = std::max(params.cgToFront + params.cgToRear, 0.001f);
+    maxSteerRadians = params.maxSteerAngle * 3.14159f / 180.0f;
+}
+
+void VehicleDynamics::step(VehicleState &state, float steering, float throttle, float deltaTime) const
+{
+    if (deltaTime <= 0.0f)
+        return;
+
+    // Clamp inputs to valid ranges
+    steering = std::max(-1.0f, std::min(1.0f, steering));
+    throttle = std::max(-1.0f, std::min(1.0f, throttle));
+
+    // The inputs are constant over the frame, so the steering trig is only done once
+    float steerAngle = steering * maxSteerRadians;
+    float sinSteer = std::sin(steerAngle);
+    float cosSteer = std::cos(steerAngle);
+    float tanSteer = sinSteer / cosSteer;
+
+    // Split long frames so the tire forces stay stable
+    int substeps = static_cast<int>(std::ceil(deltaTime / params.maxSubstep));
+    float substepTime = deltaTime / substeps;
+    for (int i = 0; i < substeps; ++i)
+    {
+        integrate(state, sinSteer, cosSteer, tanSteer, throttle, substepTime);
+    }
+}
+
+void VehicleDynamics::stepBatch(VehicleState *states, const float *steering, const float *throttle, size_t count, float deltaTime) const
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        step(states[i], steering[i], throttle[i], deltaTime);
+    }
+}
+
+void VehicleDynamics::integrate(VehicleState &state, float sinSteer, float cosSteer, float tanSteer, float throttle, float deltaTime) const
+{
+    float vx = state.velocity;
+    float vy = state.lateralVelocity;
+    float r = state.yawRate;
+
+    // Longitudinal force: engine, brakes or reverse
+    float driveForce = 0.0f;
+    bool braking = false;
+    if (throttle > 0.0f)
+    {
+        driveForce = throttle * params.engineForce;
+    }
+    else if (throttle < 0.0f)
+    {
+        if (vx > 1.0f)
+        {
+            driveForce = throttle * params.brakeForce;
+            braking = true;
+        }
+        else if (vx > -params.maxReverseSpeed)
+        {
+            driveForce = throttle * params.reverseForce;
+        }
+    }
+
+    // Resistances always oppose the motion
+    float resistance = params.dragCoefficient * vx * std::abs(vx);
+    if (vx > 0.0f)
+        resistance += params.rollingResistance;
+    else if (vx < 0.0f)
+        resistance -= params.rollingResistance;
+
+    // Wheel velocities in the wheel frames
+    float frontLateralRaw = vy + params.cgToFront * r;
+    float frontLongitudinal = vx * cosSteer + frontLateralRaw * sinSteer;
+    float frontLateral = frontLateralRaw * cosSteer - vx * sinSteer;
+    float rearLateral = vy - params.cgToRear * r;
+
+    // Slip angles (regularized at low speed where they are ill defined)
+    float frontSlip = std::atan2(frontLateral, std::max(std::abs(frontLongitudinal), params.kinematicSpeed));
+    float rearSlip = std::atan2(rearLateral, std::max(std::abs(vx), params.kinematicSpeed));
+
+    // Linear tires up to the grip limit, beyond that the tire slides
+    float frontForce = std::max(-params.maxGripFront, std::min(params.maxGripFront, -params.corneringStiffnessFront * frontSlip));
+    float rearForce = std::max(-params.maxGripRear, std::min(params.maxGripRear, -params.corneringStiffnessRear * rearSlip));
+
+    // Equations of motion in the car frame
+    float ax = (driveForce - resistance - frontForce * sinSteer) * inverseMass + vy * r;
+    float ay = (rearForce + frontForce * cosSteer) * inverseMass - vx * r;
+    float yawAcceleration = (params.cgToFront * frontForce * cosSteer - params.cgToRear * rearForce) * inverseInertia;
+
+    // Semi-implicit Euler
+    float newVx = vx + ax * deltaTime;
+    vy += ay * deltaTime;
+    r += yawAcceleration * deltaTime;
+
+    // Brakes stop the car, they don't push it backwards
+    if (braking && newVx < 0.0f)
+        newVx = 0.0f;
+    // Coasting never reverses the direction of travel either
+    if (driveForce == 0.0f && (newVx > 0.0f) != (vx > 0.0f))
+        newVx = 0.0f;
+    vx = std::max(newVx, -params.maxReverseSpeed);
+
+    // At low speed the tire model is unreliable, blend into the kinematic bicycle model
+    float speed = std::abs(vx);
+    if (speed < params.kinematicSpeed)
+    {
+        float blend = speed / params.kinematicSpeed;
+        float kinematicYawRate = vx * tanSteer / wheelbase;
+        r = blend * r + (1.0f - blend) * kinematicYawRate;
+        vy *= blend;
+    }
+
+    state.velocity = vx;
+    state.lateralVelocity = vy;
+    state.yawRate = r;
+
+    // Move in world space (the lateral axis is the heading rotated by +90 degrees)
+    float radians = state.rotation * 3.14159f / 180.0f;
+    float cosHeading = std::cos(radians);
+    float sinHeading = std::sin(radians);
+    state.x += (vx * cosHeading - vy * sinHeading) * deltaTime;
+    state.y += (vx * sinHeading + vy * cosHeading) * deltaTime;
+    state.rotation += r * deltaTime * 180.0f / 3.14159f;
+
+    // Keep the heading in a small range so the trig stays accurate over long runs
+    if (state.rotation > 180.0f)
+        state.rotation -= 360.0f;
+    else if (state.rotation < -180.0f)
+        state.rotation += 360.0f;
+}
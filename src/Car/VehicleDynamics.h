@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// Parameters of one vehicle class (world units are pixels, forces are mass * px/s^2)
+struct VehicleParams
+{
+    std::string name;
+
+    float mass;        // Vehicle mass
+    float yawInertia;  // Moment of inertia around the vertical axis
+    float cgToFront;   // Distance from the center of gravity to the front axle
+    float cgToRear;    // Distance from the center of gravity to the rear axle
+
+    float corneringStiffnessFront; // Lateral force per radian of front slip angle
+    float corneringStiffnessRear;  // Lateral force per radian of rear slip angle
+    float maxGripFront;            // Maximum lateral force the front tires can produce
+    float maxGripRear;             // Maximum lateral force the rear tires can produce (lower than front = drifts)
+
+    float engineForce;     // Forward force at full throttle
+    float brakeForce;      // Braking force at full brake
+    float reverseForce;    // Backwards force when braking from standstill
+    float maxReverseSpeed; // Reverse speed limit
+    float dragCoefficient; // Air drag, force = -drag * v * |v|
+    float rollingResistance; // Rolling resistance, constant force against the direction of travel
+
+    float maxSteerAngle;  // Front wheel angle at full steering input (degrees)
+    float kinematicSpeed; // Below this speed the tire model blends into a kinematic model
+    float maxSubstep;     // Longest integration step, larger frames are split into substeps
+
+    VehicleParams();
+
+    // Load a vehicle class ("[name]" section) from an INI file
+    // Keys that are missing keep their current value, returns false if the file or class is not found
+    bool loadFromFile(const std::string &filename, const std::string &className);
+};
+
+// Dynamic state of one vehicle
+struct VehicleState
+{
+    float x, y;            // Position of the center of gravity
+    float rotation;        // Heading in degrees
+    float velocity;        // Forward velocity (car frame)
+    float lateralVelocity; // Sideways velocity (car frame), non-zero while sliding
+    float yawRate;         // Rotation speed in radians per second
+
+    VehicleState() : x(0.0f), y(0.0f), rotation(0.0f), velocity(0.0f), lateralVelocity(0.0f), yawRate(0.0f) {}
+};
+
+// Single-track (bicycle) model with linear tires up to a grip limit, drag and rolling resistance
+// The constants needed per step are precomputed once so stepping a car is a handful of flops
+class VehicleDynamics
+{
+private:
+    VehicleParams params;
+
+    // Precomputed from params
+    float inverseMass;
+    float inverseInertia;
+    float wheelbase;
+    float maxSteerRadians;
+
+public:
+    VehicleDynamics();
+    explicit VehicleDynamics(const VehicleParams &params);
+
+    void setParams(const VehicleParams &newParams);
+    const VehicleParams &getParams() const { return params; }
+
+    // Advance the state by deltaTime seconds
+    // steering: -1 (left) to 1 (right), throttle: -1 (brake/reverse) to 1 (full throttle)
+    void step(VehicleState &state, float steering, float throttle, float deltaTime) const;
+
+    // Step many cars with the same parameters (states and inputs are dense arrays of size count)
+    void stepBatch(VehicleState *states, const float *steering, const float *throttle, size_t count, float deltaTime) const;
+
+private:
+    void integrate(VehicleState &state, float sinSteer, float cosSteer, float tanSteer, float throttle, float deltaTime) const;
+};
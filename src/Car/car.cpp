@@ -1,172 +1,81 @@
 #include "Car.h"
-#include <iostream>
+#include "CarCollision.h"
+#include "../Logging/Logger.h"
 
 Car::Car(float startX, float startY, float carWidth, float carHeight)
-    : x(startX), y(startY), velocity(0.0f), rotation(0.0f), acceleration(500.0f), steering(0.0f),
-      carShape(carWidth, carHeight), maxSpeed(500.0f), maxReverseSpeed(150.0f), deceleration(300.0f), rotationSpeed(180.0f)
+    : carShape(carWidth, carHeight), steeringInput(0.0f), throttleInput(0.0f)
 {
+    state.x = startX;
+    state.y = startY;
+
     // Initialize the neural network brain with 10 inputs (8 ray sensors + speed + rotation), 2 outputs (steering, acceleration), 0 hidden nodes (basic structure)
     brain.initializeSimple(10, 2, 0);
 
     // RaySensorHandler is automatically initialized in the constructor
-    std::cout << "Car initialized with RaySensorHandler" << std::endl;
+    LOG_TRACE("Car initialized with RaySensorHandler");
 }
 
-void Car::draw(sf::RenderWindow &window) const
+void Car::draw(sf::RenderTarget &target) const
 {
-    // Set the car shape's position and rotation
-    const_cast<CarShape &>(carShape).setPosition(sf::Vector2f(x, y));
-    const_cast<CarShape &>(carShape).setRotation(rotation);
+    // The shape is only synced with the physics state when a single car is drawn on its own
+    // (the fleet renderer draws all cars straight from their physics state)
+    carShape.setPosition(sf::Vector2f(state.x, state.y));
+    carShape.setRotation(state.rotation);
 
     // Draw the car shape
-    window.draw(carShape);
+    target.draw(carShape);
 }
 
 void Car::update(float deltaTime)
 {
-    // Update car position based on velocity and rotation
-    float radians = rotation * 3.14159f / 180.0f;
-    x += velocity * std::cos(radians) * deltaTime;
-    y += velocity * std::sin(radians) * deltaTime;
-
-    // Update car shape position and rotation
-    carShape.setPosition({x, y});
-    carShape.setRotation(rotation);
+    // Integrate the vehicle model with the latest control inputs
+    dynamics.step(state, steeringInput, throttleInput, deltaTime);
 }
 
 void Car::handleInput()
 {
-    // Handle WASD input for car physics
+    // Map WASD to the same inputs the AI uses, the physics happens in update()
+    steeringInput = 0.0f;
+    throttleInput = 0.0f;
+
     if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::W))
-    {
-        // Accelerate forward
-        velocity += acceleration * 0.016f;
-        if (velocity > maxSpeed)
-            velocity = maxSpeed;
-    }
+        throttleInput += 1.0f; // Accelerate forward
     if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::S))
-    {
-        // Reverse/brake
-        velocity -= acceleration * 0.016f;
-        if (velocity < -maxReverseSpeed)
-            velocity = -maxReverseSpeed;
-    }
+        throttleInput -= 1.0f; // Brake, then reverse
     if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A))
-    {
-        // Rotate left (only when moving)
-        if (std::abs(velocity) > 10.0f)
-        { // Small threshold to prevent turning when nearly stopped
-            if (velocity > 0)
-            {
-                rotation -= rotationSpeed * 0.016f; // Normal steering when moving forward
-            }
-            else
-            {
-                rotation += rotationSpeed * 0.016f; // Reversed steering when reversing
-            }
-        }
-    }
+        steeringInput -= 1.0f; // Steer left
     if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D))
-    {
-        // Rotate right (only when moving)
-        if (std::abs(velocity) > 10.0f)
-        { // Small threshold to prevent turning when nearly stopped
-            if (velocity > 0)
-            {
-                rotation += rotationSpeed * 0.016f; // Normal steering when moving forward
-            }
-            else
-            {
-                rotation -= rotationSpeed * 0.016f; // Reversed steering when reversing
-            }
-        }
-    }
-
-    // Natural deceleration when no keys are pressed
-    if (!sf::Keyboard::isKeyPressed(sf::Keyboard::Key::W) && !sf::Keyboard::isKeyPressed(sf::Keyboard::Key::S))
-    {
-        if (velocity > 0)
-        {
-            velocity -= deceleration * 0.5f * 0.016f; // Slow down forward motion
-            if (velocity < 0)
-                velocity = 0;
-        }
-        else if (velocity < 0)
-        {
-            velocity += deceleration * 0.5f * 0.016f; // Slow down reverse motion
-            if (velocity > 0)
-                velocity = 0;
-        }
-    }
+        steeringInput += 1.0f; // Steer right
 }
 
 void Car::setPosition(float newX, float newY)
 {
-    x = newX;
-    y = newY;
-    carShape.setPosition({x, y});
+    state.x = newX;
+    state.y = newY;
 }
 
 void Car::setAIInputs(float steering, float acceleration)
 {
-    // Clamp inputs to valid ranges
-    steering = std::max(-1.0f, std::min(1.0f, steering));
-    acceleration = std::max(-1.0f, std::min(1.0f, acceleration));
-
-    // Apply steering (only when moving)
-    if (std::abs(velocity) > 10.0f)
-    {
-        if (velocity > 0)
-        {
-            rotation += steering * rotationSpeed * 0.016f;
-        }
-        else
-        {
-            rotation -= steering * rotationSpeed * 0.016f;
-        }
-    }
+    // Clamp inputs to valid ranges, they are applied by the vehicle model on the next update
+    steeringInput = std::max(-1.0f, std::min(1.0f, steering));
+    throttleInput = std::max(-1.0f, std::min(1.0f, acceleration));
+}
 
-    // Apply acceleration
-    if (acceleration > 0)
-    {
-        // Forward acceleration
-        velocity += acceleration * this->acceleration * 0.016f;
-        if (velocity > maxSpeed)
-            velocity = maxSpeed;
-    }
-    else if (acceleration < 0)
-    {
-        // Braking/reverse
-        velocity += acceleration * this->acceleration * 0.016f;
-        if (velocity < -maxReverseSpeed)
-            velocity = -maxReverseSpeed;
-    }
-    else
-    {
-        // Natural deceleration when no acceleration input
-        if (velocity > 0)
-        {
-            velocity -= deceleration * 0.5f * 0.016f;
-            if (velocity < 0)
-                velocity = 0;
-        }
-        else if (velocity < 0)
-        {
-            velocity += deceleration * 0.5f * 0.016f;
-            if (velocity > 0)
-                velocity = 0;
-        }
-    }
+sf::Vector2f Car::getVelocity() const
+{
+    // World space velocity including any sideways sliding
+    float radians = state.rotation * 3.14159f / 180.0f;
+    float cosHeading = std::cos(radians);
+    float sinHeading = std::sin(radians);
+    return sf::Vector2f(state.velocity * cosHeading - state.lateralVelocity * sinHeading,
+                        state.velocity * sinHeading + state.lateralVelocity * cosHeading);
 }
 
 void Car::updateRaySensors(const std::vector<sf::Vector2f> &innerEdgePoints,
                            const std::vector<sf::Vector2f> &outerEdgePoints)
 {
-    // Update ray positions based on car position and rotation
-    raySensorHandler.updateRays(sf::Vector2f(x, y), rotation);
-
-    // Check for collisions and update ray colors
-    raySensorHandler.checkCollisions(sf::Vector2f(x, y), rotation, innerEdgePoints, outerEdgePoints);
+    // Measure the distance to the track edges along each ray
+    raySensorHandler.checkCollisions(sf::Vector2f(state.x, state.y), state.rotation, innerEdgePoints, outerEdgePoints);
 }
 
 std::vector<float> Car::getRayDistances() const
@@ -175,43 +84,57 @@ std::vector<float> Car::getRayDistances() const
     return raySensorHandler.getRayLengths();
 }
 
-void Car::drawRaySensors(sf::RenderWindow &window) const
-{
-    raySensorHandler.draw(window);
-}
-
 void Car::resetPosition()
 {
     // Reset to start position (checkered flag position)
-    x = 350.0f;
-    y = 230.0f;
-    rotation = 0.0f;
-    velocity = 0.0f;
-
-    // Update car shape
-    carShape.setPosition({x, y});
-    carShape.setRotation(rotation);
+    state = VehicleState();
+    state.x = 350.0f;
+    state.y = 230.0f;
+    steeringInput = 0.0f;
+    throttleInput = 0.0f;
 }
 
 sf::FloatRect Car::getGlobalBounds() const
 {
-    return carShape.getGlobalBounds();
+    // Bounds of the rotated car body, no need to go through the shapes
+    sf::Vector2f size = carShape.getSize();
+    CarBox box = CarCollision::makeBox(state.x, state.y, state.rotation, size.x, size.y);
+    return sf::FloatRect(sf::Vector2f(box.minX, box.minY), sf::Vector2f(box.maxX - box.minX, box.maxY - box.minY));
 }
 
-void Car::handleCollision(const std::vector<sf::Vector2f> &innerEdgePoints, const std::vector<sf::Vector2f> &outerEdgePoints)
+void Car::applyContact(const sf::Vector2f &positionOffset, const sf::Vector2f &velocityChange)
 {
+    state.x += positionOffset.x;
+    state.y += positionOffset.y;
+
+    // Split the world space velocity change into the car frame
+    float radians = state.rotation * 3.14159f / 180.0f;
+    float cosHeading = std::cos(radians);
+    float sinHeading = std::sin(radians);
+    state.velocity += velocityChange.x * cosHeading + velocityChange.y * sinHeading;
+    state.lateralVelocity += -velocityChange.x * sinHeading + velocityChange.y * cosHeading;
+}
+
+void Car::handleCollision(const std::vector<sf::Vector2f> &innerEdgePoints, const std::vector<sf::Vector2f> &outerEdgePoints,
+                          const EdgeGrid &innerGrid, const EdgeGrid &outerGrid)
+{
+    // Only the edge points near the car can collide, the grids return them in index order
+    // so the first hit is the same as scanning every point
+    float collisionRadius = 5.0f + carShape.getSize().x / 2.0f;
+
     // Check collision with inner edge points
-    for (size_t i = 0; i < innerEdgePoints.size(); ++i)
+    innerGrid.query(sf::Vector2f(state.x, state.y), collisionRadius, nearbyEdgePoints);
+    for (std::uint32_t i : nearbyEdgePoints)
     {
         const auto &edgePoint = innerEdgePoints[i];
 
         // Calculate distance between car center and edge point
-        float dx = x - edgePoint.x;
-        float dy = y - edgePoint.y;
+        float dx = state.x - edgePoint.x;
+        float dy = state.y - edgePoint.y;
         float distance = std::sqrt(dx * dx + dy * dy);
 
         // Check if car is within collision radius of edge point
-        if (distance < 5.0f + carShape.getSize().x / 2.0f)
+        if (distance < collisionRadius)
         {
             // Find adjacent points to calculate tangent
             sf::Vector2f prevPoint, nextPoint;
@@ -259,11 +182,11 @@ void Car::handleCollision(const std::vector<sf::Vector2f> &innerEdgePoints, cons
 
             // Bounce the car away from the edge
             float bounceDistance = 5.0f + carShape.getSize().x / 2.0f - distance + 1.0f;
-            x += normal.x * bounceDistance;
-            y += normal.y * bounceDistance;
+            state.x += normal.x * bounceDistance;
+            state.y += normal.y * bounceDistance;
 
             // Calculate reflection using vector math (more robust)
-            float velocityAngle = rotation * 3.14159f / 180.0f;
+            float velocityAngle = state.rotation * 3.14159f / 180.0f;
 
             // Create velocity vector
             sf::Vector2f velocityVector(std::cos(velocityAngle), std::sin(velocityAngle));
@@ -280,7 +203,7 @@ void Car::handleCollision(const std::vector<sf::Vector2f> &innerEdgePoints, cons
             float newAngle = newVelocityAngle * 180.0f / 3.14159f;
 
             // Check if the rotation would be too large (more than 90 degrees)
-            float angleDifference = std::abs(newAngle - rotation);
+            float angleDifference = std::abs(newAngle - state.rotation);
             if (angleDifference > 180.0f)
             {
                 angleDifference = 360.0f - angleDifference; // Handle angle wrapping
@@ -289,36 +212,37 @@ void Car::handleCollision(const std::vector<sf::Vector2f> &innerEdgePoints, cons
             // Only apply rotation if it's less than 90 degrees
             if (angleDifference < 45.0f)
             {
-                rotation = newAngle;
+                state.rotation = newAngle;
             }
             else
             {
                 // If rotation would be too large, reverse the velocity instead
-                velocity = -velocity * 0.5f; // Reverse and reduce velocity by 50%
+                state.velocity = -state.velocity * 0.5f; // Reverse and reduce velocity by 50%
             }
 
             // Calculate velocity reduction based on angle of incidence
             float velocityReductionFactor = 0.0f + ((angleOfIncidence / (3.14159f / 2.0f)) * 0.9f) * .3f;
-            velocity *= velocityReductionFactor;
+            state.velocity *= velocityReductionFactor;
 
-            // Update car shape
-            carShape.setPosition({x, y});
-            carShape.setRotation(rotation);
+            // The wall absorbs any sliding and spin
+            state.lateralVelocity = 0.0f;
+            state.yawRate = 0.0f;
 
             return; // Only handle one collision per frame
         }
     }
 
     // Check collision with outer edge points (similar logic)
-    for (size_t i = 0; i < outerEdgePoints.size(); ++i)
+    outerGrid.query(sf::Vector2f(state.x, state.y), collisionRadius, nearbyEdgePoints);
+    for (std::uint32_t i : nearbyEdgePoints)
     {
         const auto &edgePoint = outerEdgePoints[i];
 
-        float dx = x - edgePoint.x;
-        float dy = y - edgePoint.y;
+        float dx = state.x - edgePoint.x;
+        float dy = state.y - edgePoint.y;
         float distance = std::sqrt(dx * dx + dy * dy);
 
-        if (distance < 5.0f + carShape.getSize().x / 2.0f)
+        if (distance < collisionRadius)
         {
             // Find adjacent points to calculate tangent
             sf::Vector2f prevPoint, nextPoint;
@@ -363,11 +287,11 @@ void Car::handleCollision(const std::vector<sf::Vector2f> &innerEdgePoints, cons
 
             // Bounce the car away from the edge
             float bounceDistance = 5.0f + carShape.getSize().x / 2.0f - distance + 1.0f;
-            x += normal.x * bounceDistance;
-            y += normal.y * bounceDistance;
+            state.x += normal.x * bounceDistance;
+            state.y += normal.y * bounceDistance;
 
             // Calculate reflection using vector math (more robust)
-            float velocityAngle = rotation * 3.14159f / 180.0f;
+            float velocityAngle = state.rotation * 3.14159f / 180.0f;
 
             // Create velocity vector
             sf::Vector2f velocityVector(std::cos(velocityAngle), std::sin(velocityAngle));
@@ -384,7 +308,7 @@ void Car::handleCollision(const std::vector<sf::Vector2f> &innerEdgePoints, cons
             float newAngle = newVelocityAngle * 180.0f / 3.14159f;
 
             // Check if the rotation would be too large (more than 90 degrees)
-            float angleDifference = std::abs(newAngle - rotation);
+            float angleDifference = std::abs(newAngle - state.rotation);
             if (angleDifference > 180.0f)
             {
                 angleDifference = 360.0f - angleDifference; // Handle angle wrapping
@@ -393,21 +317,21 @@ void Car::handleCollision(const std::vector<sf::Vector2f> &innerEdgePoints, cons
             // Only apply rotation if it's less than 90 degrees
             if (angleDifference < 90.0f)
             {
-                rotation = newAngle;
+                state.rotation = newAngle;
             }
             else
             {
                 // If rotation would be too large, reverse the velocity instead
-                velocity = -velocity * 0.5f; // Reverse and reduce velocity by 50%
+                state.velocity = -state.velocity * 0.5f; // Reverse and reduce velocity by 50%
             }
 
             // Calculate velocity reduction based on angle of incidence
             float velocityReductionFactor = 1.0f - (angleOfIncidence / (3.14159f / 2.0f)) * 0.9f;
-            velocity *= velocityReductionFactor;
+            state.velocity *= velocityReductionFactor;
 
-            // Update car shape
-            carShape.setPosition({x, y});
-            carShape.setRotation(rotation);
+            // The wall absorbs any sliding and spin
+            state.lateralVelocity = 0.0f;
+            state.yawRate = 0.0f;
 
             return; // Only handle one collision per frame
         }
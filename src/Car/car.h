@@ -2,25 +2,24 @@
 #include <SFML/Graphics.hpp>
 #include "CarShape.h"
 #include "RaySensorHandler.h"
+#include "VehicleDynamics.h"
 #include "../AI/NeuralNetwork.h"
+#include "../Track/EdgeGrid.h"
+#include <cstdint>
 #include <vector>
 #include "../Interfaces/IRenderable.h"
 
 class Car : public IRenderable
 {
 private:
-    float x, y;
-    float velocity;
-    float rotation;
-    float acceleration;
-    float steering;
-    CarShape carShape;
-
-    // Car physics constants
-    float maxSpeed;
-    float maxReverseSpeed;
-    float deceleration;
-    float rotationSpeed;
+    // Position, heading and velocities integrated by the vehicle model
+    VehicleState state;
+    mutable CarShape carShape; // Synced with the state in draw()
+
+    // Vehicle physics model and the control inputs it integrates on the next update
+    VehicleDynamics dynamics;
+    float steeringInput;
+    float throttleInput;
 
     // Ray sensor handler for AI
     RaySensorHandler raySensorHandler;
@@ -28,18 +27,22 @@ private:
     // Neural network brain for AI
     NeuralNetwork brain;
 
+    // Scratch list for edge grid queries (keeps its capacity)
+    std::vector<std::uint32_t> nearbyEdgePoints;
+
 public:
     Car(float startX, float startY, float carWidth = 20.0f, float carHeight = 10.0f);
 
-    void draw(sf::RenderWindow &window) const override;
+    void draw(sf::RenderTarget &target) const override;
     void update(float deltaTime);
     void handleInput();
-    void handleCollision(const std::vector<sf::Vector2f> &innerEdgePoints, const std::vector<sf::Vector2f> &outerEdgePoints);
+    void handleCollision(const std::vector<sf::Vector2f> &innerEdgePoints, const std::vector<sf::Vector2f> &outerEdgePoints,
+                         const EdgeGrid &innerGrid, const EdgeGrid &outerGrid);
 
     // Getters for position and angle
-    float getX() const { return x; }
-    float getY() const { return y; }
-    float getAngle() const { return rotation; }
+    float getX() const { return state.x; }
+    float getY() const { return state.y; }
+    float getAngle() const { return state.rotation; }
 
     // Setters for position
     void setPosition(float newX, float newY);
@@ -48,20 +51,34 @@ public:
     void updateRaySensors(const std::vector<sf::Vector2f> &innerEdgePoints,
                           const std::vector<sf::Vector2f> &outerEdgePoints);
     std::vector<float> getRayDistances() const;
-    void drawRaySensors(sf::RenderWindow &window) const;
+    const RaySensorHandler &getRaySensors() const { return raySensorHandler; }
+    void setSensorLayout(const std::vector<float> &angles, float range) { raySensorHandler.setLayout(angles, range); }
 
     // AI control methods
     void setAIInputs(float steering, float acceleration);
-    sf::Vector2f getVelocity() const { return sf::Vector2f(velocity * std::cos(rotation * 3.14159f / 180.0f),
-                                                           velocity * std::sin(rotation * 3.14159f / 180.0f)); }
-    float getRotation() const { return rotation; }
-    float getSpeed() const { return velocity; }
+    sf::Vector2f getVelocity() const;
+    float getRotation() const { return state.rotation; }
+    float getSpeed() const { return state.velocity; }
+
+    // The clamped inputs the next update applies (what a replay records)
+    float getSteeringInput() const { return steeringInput; }
+    float getThrottleInput() const { return throttleInput; }
+
+    // Vehicle physics access
+    void setVehicleParams(const VehicleParams &params) { dynamics.setParams(params); }
+    const VehicleParams &getVehicleParams() const { return dynamics.getParams(); }
+    const VehicleState &getVehicleState() const { return state; }
+    void setVehicleState(const VehicleState &newState) { state = newState; }
 
     // Reset car to start position
     void resetPosition();
 
-    // Get global bounds for collision detection
+    // Get global bounds for collision detection (computed from the physics state)
     sf::FloatRect getGlobalBounds() const;
+    sf::Vector2f getSize() const { return carShape.getSize(); }
+
+    // Car-to-car contact response: move the car and change its world space velocity
+    void applyContact(const sf::Vector2f &positionOffset, const sf::Vector2f &velocityChange);
 
     // Neural network brain access
     const NeuralNetwork &getBrain() const { return brain; }
@@ -8,7 +8,15 @@ Checkpoint::Checkpoint(const std::vector<sf::Vector2f> &cornerPositions, int num
     {
         // Invalid checkpoint - should have exactly 4 corners
         corners.clear();
+        return;
     }
+
+    // Calculate the bounding box once, the corners never change
+    float minX = std::min({corners[0].x, corners[1].x, corners[2].x, corners[3].x});
+    float maxX = std::max({corners[0].x, corners[1].x, corners[2].x, corners[3].x});
+    float minY = std::min({corners[0].y, corners[1].y, corners[2].y, corners[3].y});
+    float maxY = std::max({corners[0].y, corners[1].y, corners[2].y, corners[3].y});
+    bounds = sf::FloatRect(sf::Vector2f(minX, minY), sf::Vector2f(maxX - minX, maxY - minY));
 }
 
 bool Checkpoint::isPointInside(const sf::Vector2f &point) const
@@ -17,10 +25,10 @@ bool Checkpoint::isPointInside(const sf::Vector2f &point) const
         return false;
 
     // Quick bounding box check first (much faster)
-    float minX = std::min({corners[0].x, corners[1].x, corners[2].x, corners[3].x});
-    float maxX = std::max({corners[0].x, corners[1].x, corners[2].x, corners[3].x});
-    float minY = std::min({corners[0].y, corners[1].y, corners[2].y, corners[3].y});
-    float maxY = std::max({corners[0].y, corners[1].y, corners[2].y, corners[3].y});
+    float minX = bounds.position.x;
+    float minY = bounds.position.y;
+    float maxX = minX + bounds.size.x;
+    float maxY = minY + bounds.size.y;
 
     // If point is outside bounding box, it's definitely not inside
     if (point.x < minX || point.x > maxX || point.y < minY || point.y > maxY)
@@ -49,10 +57,10 @@ bool Checkpoint::isLineIntersecting(const sf::Vector2f &start, const sf::Vector2
         return false;
 
     // Quick bounding box check first
-    float minX = std::min({corners[0].x, corners[1].x, corners[2].x, corners[3].x});
-    float maxX = std::max({corners[0].x, corners[1].x, corners[2].x, corners[3].x});
-    float minY = std::min({corners[0].y, corners[1].y, corners[2].y, corners[3].y});
-    float maxY = std::max({corners[0].y, corners[1].y, corners[2].y, corners[3].y});
+    float minX = bounds.position.x;
+    float minY = bounds.position.y;
+    float maxX = minX + bounds.size.x;
+    float maxY = minY + bounds.size.y;
 
     // Check if line segment intersects with bounding box (with some tolerance)
     float tolerance = 5.0f; // Add small tolerance for fast movement
@@ -142,21 +150,10 @@ sf::Vector2f Checkpoint::getCenter() const
 
 sf::FloatRect Checkpoint::getBounds() const
 {
-    if (corners.size() != 4)
-        return sf::FloatRect();
-
-    // Calculate bounding box
-    float minX = std::min({corners[0].x, corners[1].x, corners[2].x, corners[3].x});
-    float maxX = std::max({corners[0].x, corners[1].x, corners[2].x, corners[3].x});
-    float minY = std::min({corners[0].y, corners[1].y, corners[2].y, corners[3].y});
-    float maxY = std::max({corners[0].y, corners[1].y, corners[2].y, corners[3].y});
-
-    sf::Vector2f position(minX, minY);
-    sf::Vector2f size(maxX - minX, maxY - minY);
-    return sf::FloatRect(position, size);
+    return bounds;
 }
 
-void Checkpoint::draw(sf::RenderWindow &window) const
+void Checkpoint::draw(sf::RenderTarget &target) const
 {
     if (corners.size() != 4)
         return;
@@ -202,5 +199,5 @@ void Checkpoint::draw(sf::RenderWindow &window) const
     }
 
     shape.setOutlineThickness(0.0f); // No outline
-    window.draw(shape);
+    target.draw(shape);
 }
\ No newline at end of file
@@ -8,6 +8,7 @@ class Checkpoint : public ICollidable, public IRenderable
 {
 private:
     std::vector<sf::Vector2f> corners; // 4 corners of the checkpoint rectangle
+    sf::FloatRect bounds;              // Bounding box of the corners (computed once)
     bool isHit;
     int checkpointNumber;
 
@@ -22,7 +23,7 @@ public:
     bool isLineIntersecting(const sf::Vector2f &start, const sf::Vector2f &end) const;
 
     // IRenderable interface implementation
-    void draw(sf::RenderWindow &window) const override;
+    void draw(sf::RenderTarget &target) const override;
 
     // Checkpoint-specific methods
     bool getIsHit() const;
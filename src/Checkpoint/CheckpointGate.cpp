@@ -0,0 +1,97 @@
+#include "CheckpointGate.h"
+#include <cmath>
+
+CheckpointGateSet::CheckpointGateSet()
+{
+}
+
+void CheckpointGateSet::build(const std::vector<SegmentData> &segmentData)
+{
+    gates.clear();
+    gates.reserve(segmentData.size());
+
+    // Extend each gate a little past the track edges so cars pushed out by collisions still register
+    const float overhang = 10.0f;
+
+    for (const auto &segment : segmentData)
+    {
+        // The segment's local y axis runs across the track
+        float radians = segment.rotation * 3.14159f / 180.0f;
+        sf::Vector2f across(-std::sin(radians), std::cos(radians));
+        float halfWidth = segment.size.y / 2.0f + overhang;
+
+        sf::Vector2f start = segment.position - across * halfWidth;
+        sf::Vector2f end = segment.position + across * halfWidth;
+
+        CheckpointGate gate;
+        gate.startX = start.x;
+        gate.startY = start.y;
+        gate.deltaX = end.x - start.x;
+        gate.deltaY = end.y - start.y;
+        gate.minX = std::min(start.x, end.x);
+        gate.minY = std::min(start.y, end.y);
+        gate.maxX = std::max(start.x, end.x);
+        gate.maxY = std::max(start.y, end.y);
+
+        gates.push_back(gate);
+    }
+}
+
+void CheckpointGateSet::clear()
+{
+    gates.clear();
+}
+
+bool CheckpointGateSet::isCrossed(int index, const sf::Vector2f &start, const sf::Vector2f &end, float *fraction) const
+{
+    const CheckpointGate &gate = gates[index];
+
+    // Bounding box rejection (most gates are far away from the car)
+    if (std::max(start.x, end.x) < gate.minX || std::min(start.x, end.x) > gate.maxX ||
+        std::max(start.y, end.y) < gate.minY || std::min(start.y, end.y) > gate.maxY)
+        return false;
+
+    // Segment-segment intersection without divisions:
+    // start + s * motion = gateStart + t * gateDelta, with s in [0, 1) and t in [0, 1]
+    float motionX = end.x - start.x;
+    float motionY = end.y - start.y;
+    float denominator = motionX * gate.deltaY - motionY * gate.deltaX;
+
+    // Parallel (or no motion at all)
+    if (denominator == 0.0f)
+        return false;
+
+    float offsetX = gate.startX - start.x;
+    float offsetY = gate.startY - start.y;
+    float sNumerator = offsetX * gate.deltaY - offsetY * gate.deltaX;
+    float tNumerator = offsetX * motionY - offsetY * motionX;
+
+    // Flip signs so the range checks work against a positive denominator
+    if (denominator < 0.0f)
+    {
+        denominator = -denominator;
+        sNumerator = -sNumerator;
+        tNumerator = -tNumerator;
+    }
+
+    // The motion range is half-open so a car ending exactly on a line is only counted once
+    if (sNumerator < 0.0f || sNumerator >= denominator || tNumerator < 0.0f || tNumerator > denominator)
+        return false;
+
+    if (fraction)
+    {
+        *fraction = sNumerator / denominator;
+    }
+    return true;
+}
+
+int CheckpointGateSet::findFirstCrossed(int first, int count, const sf::Vector2f &start, const sf::Vector2f &end, float *fraction) const
+{
+    int last = std::min(first + count, size());
+    for (int i = std::max(first, 0); i < last; ++i)
+    {
+        if (isCrossed(i, start, end, fraction))
+            return i;
+    }
+    return -1;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "../BezierShape/BezierShape.h" // For SegmentData
+
+// Compact checkpoint representation: one line segment across the track plus its bounding box
+struct CheckpointGate
+{
+    float startX, startY; // One end of the crossing line
+    float deltaX, deltaY; // Vector from the start to the other end of the line
+    float minX, minY;     // Cached bounding box of the line
+    float maxX, maxY;
+};
+
+// Contiguous set of checkpoint gates with a batched "did this motion cross gate k" test
+class CheckpointGateSet
+{
+private:
+    std::vector<CheckpointGate> gates;
+
+public:
+    CheckpointGateSet();
+
+    // Build one gate per checkpoint segment (a line across the track through the segment center)
+    void build(const std::vector<SegmentData> &segmentData);
+
+    // Remove all gates
+    void clear();
+
+    // Number of gates
+    int size() const { return static_cast<int>(gates.size()); }
+
+    // Access the packed gate data
+    const CheckpointGate &getGate(int index) const { return gates[index]; }
+    const std::vector<CheckpointGate> &getGates() const { return gates; }
+
+    // Check if the motion segment start->end crosses gate k
+    // If fraction is given, it receives how far along the motion the crossing happened (0 to 1)
+    bool isCrossed(int index, const sf::Vector2f &start, const sf::Vector2f &end, float *fraction = nullptr) const;
+
+    // Check gates [first, first + count) in order and return the first one crossed, or -1
+    int findFirstCrossed(int first, int count, const sf::Vector2f &start, const sf::Vector2f &end, float *fraction = nullptr) const;
+};
@@ -1,10 +1,12 @@
 #include "CheckpointHandler.h"
 #include <iostream>
+#include <algorithm>
 
 CheckpointHandler::CheckpointHandler()
-    : totalCheckpoints(0), hitCheckpoints(0), lapCompleted(false), maxCars(1)
+    : totalCheckpoints(0), hitCheckpoints(0), lapCompleted(false), maxCars(1), raceLaps(1)
 {
     carProgress.resize(1); // Start with one car
+    resizeRaceStorage();
 }
 
 void CheckpointHandler::initializeCheckpoints(const std::vector<SegmentData> &segmentData)
@@ -57,6 +59,11 @@ void CheckpointHandler::initializeCheckpoints(const std::vector<SegmentData> &se
             finalCheckpoint = std::make_unique<Checkpoint>(corners, -1); // Use -1 to indicate final checkpoint
         }
     }
+
+    // Compile the checkpoints into crossing lines for detection
+    gates.build(segmentData);
+
+    resizeRaceStorage();
 }
 
 CheckpointHandler::~CheckpointHandler()
@@ -65,86 +72,24 @@ CheckpointHandler::~CheckpointHandler()
 
 void CheckpointHandler::checkCarPositionWithLine(const sf::Vector2f &previousPosition, const sf::Vector2f &currentPosition)
 {
-    // Debug output removed
-
-    // Calculate distance moved to determine sampling frequency
-    float distanceMoved = std::sqrt(
-        (currentPosition.x - previousPosition.x) * (currentPosition.x - previousPosition.x) +
-        (currentPosition.y - previousPosition.y) * (currentPosition.y - previousPosition.y));
-
-    // Sample multiple points along the movement path for fast-moving cars
-    int numSamples = std::max(1, static_cast<int>(distanceMoved / 10.0f)); // Sample every 10 pixels
-    numSamples = std::min(numSamples, 10);                                 // Cap at 10 samples to avoid performance issues
-
-    bool checkpointHit = false;
     int checkRange = 3; // Check up to 3 checkpoints ahead
 
-    // Check each sample point along the movement path
-    for (int sample = 0; sample <= numSamples && !checkpointHit; ++sample)
-    {
-        // Calculate sample position along the movement path
-        float t = (numSamples > 0) ? static_cast<float>(sample) / static_cast<float>(numSamples) : 0.0f;
-        sf::Vector2f samplePosition = previousPosition + t * (currentPosition - previousPosition);
-
-        // Check the next few checkpoints in sequence
-        for (int i = 0; i < checkRange && (hitCheckpoints + i) < checkpoints.size(); ++i)
-        {
-            auto &checkpoint = checkpoints[hitCheckpoints + i];
-
-            if (!checkpoint->getIsHit() &&
-                (checkpoint->isLineIntersecting(previousPosition, currentPosition) ||
-                 checkpoint->isPointInside(currentPosition)))
-            {
-                checkpoint->markAsHit();
-                hitCheckpoints += i + 1;
-                checkpointHit = true;
-                break;
-            }
-        }
-    }
-
-    // If no checkpoint was hit with sampling, try the original line intersection method
-    if (!checkpointHit)
-    {
-        for (int i = 0; i < checkRange && (hitCheckpoints + i) < checkpoints.size(); ++i)
-        {
-            auto &checkpoint = checkpoints[hitCheckpoints + i];
-
-            if (!checkpoint->getIsHit() &&
-                (checkpoint->isLineIntersecting(previousPosition, currentPosition) ||
-                 checkpoint->isPointInside(currentPosition)))
-            {
-                checkpoint->markAsHit();
-                hitCheckpoints += i + 1;
-                checkpointHit = true;
-                break;
-            }
-        }
-    }
-
-    // If no checkpoint was hit in the forward range, check if we missed any previous checkpoints
-    if (!checkpointHit && hitCheckpoints > 0)
+    // Find the first gate in range that the movement crossed
+    int crossed = gates.findFirstCrossed(hitCheckpoints, checkRange, previousPosition, currentPosition);
+    if (crossed >= 0)
     {
-        // Check a few checkpoints behind in case we missed one
-        for (int i = 1; i <= 2 && (hitCheckpoints - i) >= 0; ++i)
+        // Mark the crossed checkpoint and any skipped ones before it
+        for (int i = hitCheckpoints; i <= crossed; ++i)
         {
-            auto &checkpoint = checkpoints[hitCheckpoints - i];
-
-            if (!checkpoint->getIsHit() &&
-                (checkpoint->isLineIntersecting(previousPosition, currentPosition) ||
-                 checkpoint->isPointInside(currentPosition)))
-            {
-                checkpoint->markAsHit();
-                break;
-            }
+            checkpoints[i]->markAsHit();
         }
+        hitCheckpoints = crossed + 1;
     }
 
     // Check final checkpoint only if all regular checkpoints are hit
     if (hitCheckpoints == totalCheckpoints && finalCheckpoint && !lapCompleted)
     {
-        if (finalCheckpoint->isLineIntersecting(previousPosition, currentPosition) ||
-            finalCheckpoint->isPointInside(currentPosition))
+        if (gates.isCrossed(0, previousPosition, currentPosition))
         {
             finalCheckpoint->markAsHit();
             lapCompleted = true;
@@ -181,18 +126,23 @@ void CheckpointHandler::resetAllCheckpoints()
     lapCompleted = false;
 }
 
-void CheckpointHandler::drawCheckpoints(sf::RenderWindow &window) const
+void CheckpointHandler::drawCheckpoints(sf::RenderTarget &target) const
+{
+    drawCheckpoints(target, hitCheckpoints);
+}
+
+void CheckpointHandler::drawCheckpoints(sf::RenderTarget &target, int nextCheckpoint) const
 {
     // Only draw the next checkpoint (much faster than drawing all)
-    if (hitCheckpoints < checkpoints.size())
+    if (nextCheckpoint >= 0 && nextCheckpoint < static_cast<int>(checkpoints.size()))
     {
-        checkpoints[hitCheckpoints]->draw(window);
+        checkpoints[nextCheckpoint]->draw(target);
     }
 
     // Draw final checkpoint only when all regular checkpoints are hit
-    if (finalCheckpoint && hitCheckpoints == totalCheckpoints)
+    if (finalCheckpoint && nextCheckpoint == totalCheckpoints)
     {
-        finalCheckpoint->draw(window);
+        finalCheckpoint->draw(target);
     }
 }
 
@@ -206,12 +156,18 @@ const std::unique_ptr<Checkpoint> &CheckpointHandler::getFinalCheckpoint() const
     return finalCheckpoint;
 }
 
+const CheckpointGateSet &CheckpointHandler::getGates() const
+{
+    return gates;
+}
+
 // Multi-car support methods
 
 void CheckpointHandler::setMaxCars(int maxCars)
 {
     this->maxCars = maxCars;
     carProgress.resize(maxCars);
+    resizeRaceStorage();
 }
 
 void CheckpointHandler::checkCarPosition(int carId, const sf::Vector2f &carPosition)
@@ -250,7 +206,8 @@ void CheckpointHandler::checkCarPosition(int carId, const sf::Vector2f &carPosit
     }
 }
 
-void CheckpointHandler::checkCarPositionWithLine(int carId, const sf::Vector2f &previousPosition, const sf::Vector2f &currentPosition)
+void CheckpointHandler::checkCarPositionWithLine(int carId, const sf::Vector2f &previousPosition, const sf::Vector2f &currentPosition,
+                                                 float raceTime, float stepTime)
 {
     if (carId < 0 || carId >= maxCars)
         return;
@@ -258,47 +215,40 @@ void CheckpointHandler::checkCarPositionWithLine(int carId, const sf::Vector2f &
     CarProgress &progress = carProgress[carId];
     progress.lastPosition = currentPosition;
 
-    // Calculate distance moved to determine sampling frequency
-    float distanceMoved = std::sqrt(
-        (currentPosition.x - previousPosition.x) * (currentPosition.x - previousPosition.x) +
-        (currentPosition.y - previousPosition.y) * (currentPosition.y - previousPosition.y));
-
-    // Sample multiple points along the movement path for fast-moving cars
-    int numSamples = std::max(1, static_cast<int>(distanceMoved / 10.0f)); // Sample every 10 pixels
-    numSamples = std::min(numSamples, 10);                                 // Cap at 10 samples to avoid performance issues
+    if (progress.lapCompleted || totalCheckpoints == 0)
+        return; // Race already finished for this car (or no checkpoints)
 
-    bool checkpointHit = false;
+    float *carSplits = &splitTimes[(static_cast<size_t>(carId) * raceLaps + progress.lapsCompleted) * totalCheckpoints];
+    float fraction = 0.0f;
 
-    // Check each sample point along the movement path
-    for (int sample = 0; sample <= numSamples && !checkpointHit; ++sample)
+    // Advance through the gates in sequence (a fast car may cross more than one per step)
+    // Only per-car progress is touched here, the shared Checkpoint objects are left alone
+    while (progress.hitCheckpoints < totalCheckpoints &&
+           gates.isCrossed(progress.hitCheckpoints, previousPosition, currentPosition, &fraction))
     {
-        // Calculate sample position along the movement path
-        float t = (numSamples > 0) ? static_cast<float>(sample) / static_cast<float>(numSamples) : 0.0f;
-        sf::Vector2f samplePosition = previousPosition + t * (currentPosition - previousPosition);
-
-        // Check the next checkpoint in sequence
-        if (progress.hitCheckpoints < checkpoints.size())
-        {
-            auto &checkpoint = checkpoints[progress.hitCheckpoints];
-
-            if (checkpoint->isPointInside(samplePosition))
-            {
-                checkpoint->markAsHit();
-                progress.hitCheckpoints++;
-                checkpointHit = true;
-            }
-        }
+        float crossingTime = raceTime - stepTime * (1.0f - fraction);
+        carSplits[progress.hitCheckpoints] = crossingTime - progress.lapStartTime;
+        progress.hitCheckpoints++;
     }
 
-    // Check final checkpoint only if all regular checkpoints are hit
-    if (progress.hitCheckpoints == totalCheckpoints && finalCheckpoint && !progress.lapCompleted)
+    // Crossing the finish line (gate 0) after all regular checkpoints completes a lap
+    if (progress.hitCheckpoints == totalCheckpoints && gates.isCrossed(0, previousPosition, currentPosition, &fraction))
     {
-        if (finalCheckpoint->isLineIntersecting(previousPosition, currentPosition) ||
-            finalCheckpoint->isPointInside(currentPosition))
+        float crossingTime = raceTime - stepTime * (1.0f - fraction);
+        lapTimes[static_cast<size_t>(carId) * raceLaps + progress.lapsCompleted] = crossingTime - progress.lapStartTime;
+        progress.lapsCompleted++;
+        progress.lapStartTime = crossingTime;
+
+        if (progress.lapsCompleted >= raceLaps)
         {
-            finalCheckpoint->markAsHit();
             progress.lapCompleted = true;
         }
+        else
+        {
+            // The finish line is also the first checkpoint of the next lap
+            progress.hitCheckpoints = 1;
+            splitTimes[(static_cast<size_t>(carId) * raceLaps + progress.lapsCompleted) * totalCheckpoints] = 0.0f;
+        }
     }
 }
 
@@ -321,8 +271,7 @@ float CheckpointHandler::getProgressForCar(int carId) const
     if (carId < 0 || carId >= maxCars || totalCheckpoints == 0)
         return 0.0f;
 
-    const CarProgress &progress = carProgress[carId];
-    return static_cast<float>(progress.hitCheckpoints) / static_cast<float>(totalCheckpoints);
+    return static_cast<float>(getTotalHitCheckpoints(carId)) / static_cast<float>(totalCheckpoints * raceLaps);
 }
 
 void CheckpointHandler::resetCarProgress(int carId)
@@ -330,19 +279,18 @@ void CheckpointHandler::resetCarProgress(int carId)
     if (carId < 0 || carId >= maxCars)
         return;
 
-    carProgress[carId].hitCheckpoints = 0;
-    carProgress[carId].lapCompleted = false;
-    carProgress[carId].lastPosition = sf::Vector2f(0.0f, 0.0f);
+    carProgress[carId] = CarProgress();
+    clearRaceTimes(carId);
 }
 
 void CheckpointHandler::resetAllCarProgress()
 {
     for (auto &progress : carProgress)
     {
-        progress.hitCheckpoints = 0;
-        progress.lapCompleted = false;
-        progress.lastPosition = sf::Vector2f(0.0f, 0.0f);
+        progress = CarProgress();
     }
+    std::fill(splitTimes.begin(), splitTimes.end(), 0.0f);
+    std::fill(lapTimes.begin(), lapTimes.end(), 0.0f);
 
     // Also reset all checkpoints
     for (auto &checkpoint : checkpoints)
@@ -354,4 +302,93 @@ void CheckpointHandler::resetAllCarProgress()
     {
         finalCheckpoint->reset();
     }
-}
\ No newline at end of file
+}
+
+// Race mode methods
+
+void CheckpointHandler::resizeRaceStorage()
+{
+    splitTimes.assign(static_cast<size_t>(maxCars) * raceLaps * totalCheckpoints, 0.0f);
+    lapTimes.assign(static_cast<size_t>(maxCars) * raceLaps, 0.0f);
+}
+
+void CheckpointHandler::clearRaceTimes(int carId)
+{
+    auto splitsBegin = splitTimes.begin() + static_cast<size_t>(carId) * raceLaps * totalCheckpoints;
+    std::fill(splitsBegin, splitsBegin + static_cast<size_t>(raceLaps) * totalCheckpoints, 0.0f);
+
+    auto lapsBegin = lapTimes.begin() + static_cast<size_t>(carId) * raceLaps;
+    std::fill(lapsBegin, lapsBegin + raceLaps, 0.0f);
+}
+
+void CheckpointHandler::setRaceLaps(int laps)
+{
+    raceLaps = std::max(1, laps);
+    resizeRaceStorage();
+    resetAllCarProgress();
+}
+
+int CheckpointHandler::getLapsCompleted(int carId) const
+{
+    if (carId < 0 || carId >= maxCars)
+        return 0;
+    return carProgress[carId].lapsCompleted;
+}
+
+bool CheckpointHandler::isRaceFinished(int carId) const
+{
+    return isLapCompleted(carId);
+}
+
+int CheckpointHandler::getTotalHitCheckpoints(int carId) const
+{
+    if (carId < 0 || carId >= maxCars)
+        return 0;
+
+    const CarProgress &progress = carProgress[carId];
+    if (progress.lapCompleted)
+        return progress.lapsCompleted * totalCheckpoints;
+    return progress.lapsCompleted * totalCheckpoints + progress.hitCheckpoints;
+}
+
+float CheckpointHandler::getLapTime(int carId, int lap) const
+{
+    if (carId < 0 || carId >= maxCars || lap < 0 || lap >= raceLaps)
+        return 0.0f;
+    return lapTimes[static_cast<size_t>(carId) * raceLaps + lap];
+}
+
+float CheckpointHandler::getSplitTime(int carId, int lap, int checkpoint) const
+{
+    if (carId < 0 || carId >= maxCars || lap < 0 || lap >= raceLaps || checkpoint < 0 || checkpoint >= totalCheckpoints)
+        return 0.0f;
+    return splitTimes[(static_cast<size_t>(carId) * raceLaps + lap) * totalCheckpoints + checkpoint];
+}
+
+float CheckpointHandler::getBestLapTime(int carId) const
+{
+    if (carId < 0 || carId >= maxCars)
+        return 0.0f;
+
+    float best = 0.0f;
+    for (int lap = 0; lap < carProgress[carId].lapsCompleted; ++lap)
+    {
+        float lapTime = getLapTime(carId, lap);
+        if (best == 0.0f || lapTime < best)
+            best = lapTime;
+    }
+    return best;
+}
+
+float CheckpointHandler::getTotalLapTime(int carId) const
+{
+    if (carId < 0 || carId >= maxCars)
+        return 0.0f;
+
+    float total = 0.0f;
+    for (int lap = 0; lap < carProgress[carId].lapsCompleted; ++lap)
+    {
+        total += getLapTime(carId, lap);
+    }
+    return total;
+}
@@ -4,6 +4,7 @@
 #include <memory>
 #include <string>
 #include "Checkpoint.h"
+#include "CheckpointGate.h"
 #include "../BezierShape/BezierShape.h" // For SegmentData
 
 // Forward declaration
@@ -14,6 +15,7 @@ class CheckpointHandler
 private:
     std::vector<std::unique_ptr<Checkpoint>> checkpoints;
     std::unique_ptr<Checkpoint> finalCheckpoint; // Final checkpoint at the start/finish line
+    CheckpointGateSet gates;                     // Crossing lines used for detection (gate 0 is also the finish line)
     int totalCheckpoints;
     int hitCheckpoints;
     bool lapCompleted;
@@ -22,15 +24,26 @@ private:
     struct CarProgress
     {
         int hitCheckpoints;
-        bool lapCompleted;
+        bool lapCompleted; // Set once the car has finished every lap of the race
+        int lapsCompleted;
+        float lapStartTime;
         sf::Vector2f lastPosition;
         
-        CarProgress() : hitCheckpoints(0), lapCompleted(false), lastPosition(0.0f, 0.0f) {}
+        CarProgress() : hitCheckpoints(0), lapCompleted(false), lapsCompleted(0), lapStartTime(0.0f), lastPosition(0.0f, 0.0f) {}
     };
     
     std::vector<CarProgress> carProgress;
     int maxCars;
 
+    // Race mode: number of laps per car and per-car timing arrays
+    int raceLaps;
+    std::vector<float> splitTimes; // [car][lap][checkpoint] time since the lap started
+    std::vector<float> lapTimes;   // [car][lap] completed lap times
+
+    // Resize the timing arrays after the car, lap or checkpoint count changed
+    void resizeRaceStorage();
+    void clearRaceTimes(int carId);
+
 public:
     CheckpointHandler();
     ~CheckpointHandler();
@@ -57,19 +70,41 @@ public:
     void resetAllCheckpoints();
 
     // Draw all checkpoints
-    void drawCheckpoints(sf::RenderWindow &window) const;
+    void drawCheckpoints(sf::RenderTarget &target) const;
+
+    // Draw the checkpoints for a given progress (used by the render thread with snapshot values)
+    void drawCheckpoints(sf::RenderTarget &target, int nextCheckpoint) const;
 
     // Get all checkpoints for external rendering
     const std::vector<std::unique_ptr<Checkpoint>>& getCheckpoints() const;
     const std::unique_ptr<Checkpoint>& getFinalCheckpoint() const;
+    const CheckpointGateSet& getGates() const;
 
     // Multi-car support methods
     void setMaxCars(int maxCars);
     void checkCarPosition(int carId, const sf::Vector2f &carPosition);
-    void checkCarPositionWithLine(int carId, const sf::Vector2f &previousPosition, const sf::Vector2f &currentPosition);
+    // raceTime is the race clock at the end of the movement and stepTime the duration of the movement,
+    // they are used to interpolate the exact split and lap times
+    void checkCarPositionWithLine(int carId, const sf::Vector2f &previousPosition, const sf::Vector2f &currentPosition,
+                                  float raceTime = 0.0f, float stepTime = 0.0f);
     int getHitCheckpoints(int carId) const;
     bool isLapCompleted(int carId) const;
     float getProgressForCar(int carId) const;
     void resetCarProgress(int carId);
     void resetAllCarProgress();
+
+    // Race mode methods
+    void setRaceLaps(int laps);
+    int getRaceLaps() const { return raceLaps; }
+    int getLapsCompleted(int carId) const;
+    bool isRaceFinished(int carId) const;
+
+    // Checkpoints hit over all laps (used for fitness)
+    int getTotalHitCheckpoints(int carId) const;
+
+    // Lap and split times for a car (0 if not recorded yet)
+    float getLapTime(int carId, int lap) const;
+    float getSplitTime(int carId, int lap, int checkpoint) const;
+    float getBestLapTime(int carId) const;
+    float getTotalLapTime(int carId) const;
 };
\ No newline at end of file
@@ -1,61 +1,34 @@
 #include "CheckpointUIRenderer.h"
-#include "CheckpointHandler.h"
-#include <iostream>
+#include "../UI/HudRenderer.h"
 #include <sstream>
 
-CheckpointUIRenderer::CheckpointUIRenderer(const CheckpointHandler &handler)
-    : checkpointHandler(handler), checkpointText(nullptr)
+CheckpointUIRenderer::CheckpointUIRenderer(HudRenderer &hudRenderer)
+    : hud(hudRenderer), shownHitCheckpoints(-1), shownTotalCheckpoints(-1)
 {
-    // Load font for checkpoint counter
-    if (!font.openFromFile("../../Fonts/ARIAL.TTF"))
-    {
-        std::cout << "Failed to load font for checkpoint counter!" << std::endl;
-    }
-    else
-    {
-        // Initialize checkpoint text
-        checkpointText = new sf::Text(font, "Checkpoints: 0/0", 20);
-        checkpointText->setFillColor(sf::Color::White);
-        checkpointText->setOutlineColor(sf::Color::Black);
-        checkpointText->setOutlineThickness(1.0f);
-    }
+    // Initialize checkpoint text (drawn by the batched HUD)
+    checkpointLabel = hud.addLabel(20, sf::Color::White, sf::Color::Black, 1.0f);
+    updateText(0, 0);
 }
 
-CheckpointUIRenderer::~CheckpointUIRenderer()
+void CheckpointUIRenderer::draw(sf::RenderTarget &target) const
 {
-    if (checkpointText)
-    {
-        delete checkpointText;
-    }
+    // Position the text in the top right corner
+    sf::Vector2u windowSize = target.getSize();
+    hud.setPosition(checkpointLabel, sf::Vector2f(
+                                         windowSize.x - 200.0f,
+                                         20.0f));
 }
 
-void CheckpointUIRenderer::draw(sf::RenderWindow &window) const
+void CheckpointUIRenderer::updateText(int hitCheckpoints, int totalCheckpoints)
 {
-    if (checkpointText)
-    {
-        try
-        {
-            // Position the text in the top right corner
-            sf::Vector2u windowSize = window.getSize();
-            checkpointText->setPosition(sf::Vector2f(
-                windowSize.x - 200.0f,
-                20.0f));
+    // Nothing to do if the counter didn't change
+    if (hitCheckpoints == shownHitCheckpoints && totalCheckpoints == shownTotalCheckpoints)
+        return;
 
-            window.draw(*checkpointText);
-        }
-        catch (...)
-        {
-            // If drawing text fails, just skip it
-        }
-    }
-}
+    shownHitCheckpoints = hitCheckpoints;
+    shownTotalCheckpoints = totalCheckpoints;
 
-void CheckpointUIRenderer::updateText()
-{
-    if (checkpointText)
-    {
-        std::ostringstream oss;
-        oss << "Checkpoints: " << checkpointHandler.getHitCheckpoints() << "/" << checkpointHandler.getTotalCheckpoints();
-        checkpointText->setString(oss.str());
-    }
-}
\ No newline at end of file
+    std::ostringstream oss;
+    oss << "Checkpoints: " << hitCheckpoints << "/" << totalCheckpoints;
+    hud.setText(checkpointLabel, oss.str());
+}
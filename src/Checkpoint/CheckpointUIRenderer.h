@@ -4,23 +4,25 @@
 #include <memory>
 
 // Forward declaration
-class CheckpointHandler;
+class HudRenderer;
 
 // UI renderer for checkpoint counter - handles only UI rendering
 class CheckpointUIRenderer : public IRenderable
 {
 private:
-    const CheckpointHandler& checkpointHandler;
-    sf::Font font;
-    sf::Text* checkpointText;
+    HudRenderer& hud;
+    int checkpointLabel; // HUD label showing the checkpoint counter
+
+    // Values shown in the label (text is only rebuilt when they change)
+    int shownHitCheckpoints;
+    int shownTotalCheckpoints;
 
 public:
-    CheckpointUIRenderer(const CheckpointHandler& handler);
-    ~CheckpointUIRenderer();
+    CheckpointUIRenderer(HudRenderer& hudRenderer);
     
     // IRenderable interface implementation
-    void draw(sf::RenderWindow& window) const override;
+    void draw(sf::RenderTarget& target) const override;
     
-    // Update the checkpoint text
-    void updateText();
+    // Update the checkpoint text (values come from the simulation snapshot)
+    void updateText(int hitCheckpoints, int totalCheckpoints);
 }; 
\ No newline at end of file
@@ -0,0 +1,515 @@
+#include "BatchRunner.h"
+#include "Game.h"
+#include "../Car/VehicleBenchmark.h"
+#include "../Car/VehicleDynamics.h"
+#include "../Car/car.h"
+#include "../AI/Random.h"
+#include "../Logging/Logger.h"
+#include "../Persistence/BinaryIO.h"
+#include "../Recording/ReplayFile.h"
+#include "../Recording/ReplayPlayer.h"
+#include "../Track/TrackFile.h"
+#include "../Track/track.h"
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+namespace
+{
+    // One JSON object on one line, every object starts with its "type"
+    class JsonLine
+    {
+    private:
+        std::ostringstream text;
+
+        void writeString(const std::string &value)
+        {
+            text << '"';
+            for (char character : value)
+            {
+                if (character == '"' || character == '\\')
+                    text << '\\' << character;
+                else if (static_cast<unsigned char>(character) < 0x20)
+                    text << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(character)
+                         << std::dec << std::setfill(' ');
+                else
+                    text << character;
+            }
+            text << '"';
+        }
+
+        void writeKey(const char *key)
+        {
+            text << ",\"" << key << "\":";
+        }
+
+    public:
+        explicit JsonLine(const char *type)
+        {
+            text << std::setprecision(10) << "{\"type\":";
+            writeString(type);
+        }
+
+        JsonLine &add(const char *key, const std::string &value)
+        {
+            writeKey(key);
+            writeString(value);
+            return *this;
+        }
+
+        JsonLine &add(const char *key, const char *value) { return add(key, std::string(value)); }
+
+        JsonLine &add(const char *key, bool value)
+        {
+            writeKey(key);
+            text << (value ? "true" : "false");
+            return *this;
+        }
+
+        JsonLine &add(const char *key, int value)
+        {
+            writeKey(key);
+            text << value;
+            return *this;
+        }
+
+        JsonLine &add(const char *key, unsigned long long value)
+        {
+            writeKey(key);
+            text << value;
+            return *this;
+        }
+
+        // JSON has no infinity or NaN
+        JsonLine &add(const char *key, double value)
+        {
+            writeKey(key);
+            if (std::isfinite(value))
+                text << value;
+            else
+                text << "null";
+            return *this;
+        }
+
+        std::string str() const { return text.str() + "}"; }
+    };
+
+    double secondsSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+BatchRunner::BatchRunner(const CommandLine &arguments)
+    : commandLine(arguments), results(nullptr), bestFitness(0.0), bestGeneration(-1)
+{
+}
+
+int BatchRunner::run()
+{
+    if (commandLine.help)
+    {
+        std::cout << CommandLine::getUsage() << GameConfig::getKeyHelp();
+        return 0;
+    }
+
+    if (commandLine.quiet)
+        Logger::setLevel(LogLevel::Warning);
+
+    if (commandLine.command != RunCommand::Play && !openResults())
+        return fail("Could not open " + commandLine.resultsPath + " for the results");
+
+    if (!loadConfig())
+        return 1;
+
+    try
+    {
+        switch (commandLine.command)
+        {
+        case RunCommand::Train:
+            return train();
+        case RunCommand::Evaluate:
+            return evaluate();
+        case RunCommand::Replay:
+            return replay();
+        case RunCommand::Bench:
+            return bench();
+        case RunCommand::Play:
+            break;
+        }
+        return play();
+    }
+    catch (const std::exception &e)
+    {
+        return fail(std::string("Error: ") + e.what());
+    }
+}
+
+bool BatchRunner::openResults()
+{
+    // Appended, so many runs can share one file (the error summary goes to stdout if it can't be opened)
+    bool opened = true;
+    if (!commandLine.resultsPath.empty())
+    {
+        resultsFile.open(commandLine.resultsPath, std::ios::app);
+        opened = resultsFile.is_open();
+    }
+    results.rdbuf(opened && resultsFile.is_open() ? resultsFile.rdbuf() : std::cout.rdbuf());
+
+    // Everything else printed to std::cout (the log included) goes to stderr from now on
+    std::cout.rdbuf(std::cerr.rdbuf());
+    return opened;
+}
+
+void BatchRunner::writeResult(const std::string &line)
+{
+    // Flushed per line so a scheduler can follow a long run
+    results << line << std::endl;
+}
+
+int BatchRunner::fail(const std::string &message)
+{
+    LOG_ERROR(message);
+    if (commandLine.command != RunCommand::Play)
+    {
+        writeResult(JsonLine("summary")
+                        .add("command", CommandLine::getCommandName(commandLine.command))
+                        .add("status", "error")
+                        .add("error", message)
+                        .str());
+    }
+    return 1;
+}
+
+bool BatchRunner::loadConfig()
+{
+    if (commandLine.configGiven && !std::ifstream(commandLine.configPath).is_open())
+    {
+        fail("Config " + commandLine.configPath + " could not be opened");
+        return false;
+    }
+    config.loadFromFile(commandLine.configPath);
+
+    for (const std::string &assignment : commandLine.overrides)
+    {
+        if (!config.applyOverride(assignment))
+        {
+            fail("Invalid setting '" + assignment + "'");
+            return false;
+        }
+    }
+    if (commandLine.headless)
+    {
+        config.set("window.render", "headless");
+    }
+
+    // A track that was asked for by name is never replaced by the built-in one
+    TrackFileData trackData;
+    if (commandLine.trackGiven && !TrackFile::load(config.trackPath, trackData))
+    {
+        fail("Track " + config.trackPath + " could not be loaded");
+        return false;
+    }
+
+    if (commandLine.command == RunCommand::Play && config.headless)
+    {
+        fail("play needs a window, use train, evaluate, replay or bench for headless runs");
+        return false;
+    }
+
+    // A batch run always reports the seed it used, so any run can be repeated
+    // (a resumed run continues with the random state of its checkpoint instead, see train)
+    if (commandLine.command != RunCommand::Play && config.seed == 0 && !isResumed())
+    {
+        config.seed = std::random_device{}() % 1000000000u + 1;
+    }
+
+    // 2560x1440 at most, smaller screens get a window that fits (the camera fits the track to it)
+    if (!config.headless)
+    {
+        sf::VideoMode desktop = sf::VideoMode::getDesktopMode();
+        if (config.windowWidth == 0)
+            config.windowWidth = std::min(2560u, desktop.size.x);
+        if (config.windowHeight == 0)
+            config.windowHeight = std::min(1440u, desktop.size.y);
+    }
+    return true;
+}
+
+bool BatchRunner::isResumed() const
+{
+    return commandLine.command == RunCommand::Evaluate || commandLine.resume || commandLine.fromArchive;
+}
+
+int BatchRunner::play()
+{
+    Game game(config);
+    game.run();
+    return 0;
+}
+
+const char *BatchRunner::runGenerations(Game &game, int generations)
+{
+    game.setGenerationLimit(generations);
+    game.setTimeLimit(commandLine.timeLimit);
+    game.setGenerationCallback([this](const GenerationResult &result)
+                               {
+                                   if (bestGeneration < 0 || result.bestFitness > bestFitness)
+                                   {
+                                       bestFitness = result.bestFitness;
+                                       bestGeneration = result.generation;
+                                   }
+                                   writeResult(JsonLine("generation")
+                                                   .add("generation", result.generation)
+                                                   .add("bestFitness", result.bestFitness)
+                                                   .add("averageFitness", result.averageFitness)
+                                                   .add("bestCheckpoints", result.bestCheckpoints)
+                                                   .add("bestTimeAlive", static_cast<double>(result.bestTimeAlive))
+                                                   .add("bestLapTime", static_cast<double>(result.bestLapTime))
+                                                   .add("finishedCars", result.finishedCars)
+                                                   .add("species", result.speciesCount)
+                                                   .add("generationTime", static_cast<double>(result.generationTime))
+                                                   .str()); });
+
+    game.startAILearning();
+    game.run();
+
+    if (game.wasTimeLimitReached())
+        return "time_limit";
+    if (generations > 0 && game.getEvaluatedGenerations() >= generations)
+        return "completed";
+    return "closed"; // The window was closed first
+}
+
+int BatchRunner::train()
+{
+    if (config.headless && commandLine.generations == 0 && commandLine.timeLimit <= 0.0f)
+        return fail("A headless training run needs --generations or --time-limit");
+
+    auto start = std::chrono::steady_clock::now();
+    const char *status = nullptr;
+    int evaluated = 0;
+    unsigned long long ticks = 0;
+    std::uint32_t randomState = 0;
+    {
+        Game game(config);
+        if (commandLine.resume && !game.loadAITrainingData())
+            return fail("No training checkpoint loaded from " + config.checkpointPath);
+        if (commandLine.fromArchive && !game.resumeFromArchive(commandLine.archiveGeneration))
+            return fail("No population loaded from the archive " + config.archivePath);
+
+        // The checkpoint replaced the seeded random state, its fingerprint identifies the run instead
+        if (isResumed())
+        {
+            std::string state = Random::getState();
+            randomState = fnv1a(state.data(), state.size());
+        }
+
+        status = runGenerations(game, commandLine.generations);
+        evaluated = game.getEvaluatedGenerations();
+        ticks = game.getSimulationTick();
+
+        // The next job can continue with --resume (written before the game is gone)
+        game.saveAITrainingData();
+    }
+
+    JsonLine summary("summary");
+    summary.add("command", CommandLine::getCommandName(commandLine.command))
+        .add("status", status)
+        .add("generations", evaluated)
+        .add("bestFitness", bestFitness)
+        .add("bestGeneration", bestGeneration)
+        .add("ticks", ticks)
+        .add("seconds", secondsSince(start));
+    if (isResumed())
+        summary.add("randomState", static_cast<unsigned long long>(randomState));
+    else
+        summary.add("seed", static_cast<unsigned long long>(config.seed));
+    writeResult(summary.add("headless", config.headless)
+                    .add("checkpoint", config.checkpointPath)
+                    .str());
+    return 0;
+}
+
+int BatchRunner::evaluate()
+{
+    // Evaluating leaves no trace: no telemetry, replays or checkpoints (the archive is only read)
+    config.telemetryPath.clear();
+    config.replayDirectory.clear();
+    config.checkpointInterval = 0;
+    int generations = commandLine.generations == 0 && commandLine.timeLimit <= 0.0f ? 1 : commandLine.generations;
+
+    auto start = std::chrono::steady_clock::now();
+    const char *status = nullptr;
+    int evaluated = 0;
+    unsigned long long ticks = 0;
+    {
+        Game game(config);
+        bool loaded = commandLine.fromArchive ? game.resumeFromArchive(commandLine.archiveGeneration) : game.loadAITrainingData();
+        if (!loaded)
+        {
+            return fail(commandLine.fromArchive ? "No population loaded from the archive " + config.archivePath
+                                                : "No training checkpoint loaded from " + config.checkpointPath);
+        }
+
+        game.setEvolutionEnabled(false);
+        status = runGenerations(game, generations);
+        evaluated = game.getEvaluatedGenerations();
+        ticks = game.getSimulationTick();
+    }
+
+    writeResult(JsonLine("summary")
+                    .add("command", CommandLine::getCommandName(commandLine.command))
+                    .add("status", status)
+                    .add("generations", evaluated)
+                    .add("bestFitness", bestFitness)
+                    .add("bestGeneration", bestGeneration)
+                    .add("ticks", ticks)
+                    .add("seconds", secondsSince(start))
+                    .add("source", commandLine.fromArchive ? config.archivePath : config.checkpointPath)
+                    .str());
+    return 0;
+}
+
+std::string BatchRunner::findReplay() const
+{
+    // Names start with the time their run started, so the last one is the newest run's last best run
+    std::vector<std::string> replays = ReplayFile::findFiles(config.replayDirectory);
+    return replays.empty() ? std::string() : replays.back();
+}
+
+int BatchRunner::replay()
+{
+    std::string path = commandLine.replayPath.empty() ? findReplay() : commandLine.replayPath;
+    if (path.empty())
+        return fail("No replays in " + config.replayDirectory);
+
+    auto start = std::chrono::steady_clock::now();
+    if (!config.headless || config.recordFrames)
+    {
+        // Shown like the Y key does, the window closes when the replay ends (headless it is only drawn for the recording)
+        Game game(config);
+        if (!game.playReplay(path))
+            return fail("No replay loaded from " + path);
+        game.setTimeLimit(commandLine.timeLimit);
+        game.setCloseWhenIdle(true);
+        game.run();
+
+        const char *status = game.wasTimeLimitReached() ? "time_limit" : game.isReplayPlaying() ? "closed" : "completed";
+        writeResult(JsonLine("summary")
+                        .add("command", CommandLine::getCommandName(commandLine.command))
+                        .add("status", status)
+                        .add("path", path)
+                        .add("seconds", secondsSince(start))
+                        .str());
+        return 0;
+    }
+
+    // Headless the run only has to be driven once, no population or window is needed
+    ReplayData data;
+    if (!ReplayFile::load(path, data))
+        return fail("No replay loaded from " + path);
+
+    Track track(0, 0);
+    if (!track.loadFromFile(config.trackPath))
+        track.createDefaultLayout();
+    if (data.trackId != track.getLayoutId())
+        return fail("Replay " + path + " was recorded on a different track than " + config.trackPath);
+
+    VehicleParams vehicleParams;
+    vehicleParams.loadFromFile(config.vehiclesPath, data.vehicleClass);
+
+    ReplayPlayer player;
+    player.start(std::move(data), vehicleParams);
+    while (player.step(track))
+    {
+    }
+
+    const ReplayData &played = player.getReplay();
+    for (std::size_t i = 0; i < played.cars.size(); ++i)
+    {
+        const Car &car = *player.getCars()[i];
+        writeResult(JsonLine("replayCar")
+                        .add("carIndex", static_cast<int>(played.cars[i].carIndex))
+                        .add("fitness", played.cars[i].fitness)
+                        .add("activeTicks", static_cast<unsigned long long>(played.cars[i].activeTicks))
+                        .add("x", static_cast<double>(car.getX()))
+                        .add("y", static_cast<double>(car.getY()))
+                        .add("rotation", static_cast<double>(car.getRotation()))
+                        .str());
+    }
+
+    writeResult(JsonLine("summary")
+                    .add("command", CommandLine::getCommandName(commandLine.command))
+                    .add("status", "completed")
+                    .add("path", path)
+                    .add("generation", played.generation)
+                    .add("cars", static_cast<int>(played.cars.size()))
+                    .add("ticks", static_cast<unsigned long long>(player.getTick()))
+                    .add("simulatedSeconds", static_cast<double>(player.getTick() * played.simulationStep))
+                    .add("seconds", secondsSince(start))
+                    .str());
+    return 0;
+}
+
+int BatchRunner::bench()
+{
+    auto start = std::chrono::steady_clock::now();
+
+    // The vehicle model alone
+    VehicleBenchmarkResult vehicle = benchmarkVehicleDynamics(commandLine.benchCars, commandLine.benchSteps);
+    writeResult(JsonLine("bench")
+                    .add("name", "vehicleDynamics")
+                    .add("cars", vehicle.carCount)
+                    .add("steps", vehicle.steps)
+                    .add("seconds", vehicle.seconds)
+                    .add("nsPerCarStep", vehicle.nanosecondsPerCarStep)
+                    .add("checksum", vehicle.checksum)
+                    .str());
+
+    // Whole ticks (sensors, networks, checkpoints, evolution) of a headless population that saves nothing
+    config.headless = true;
+    config.recordFrames = false;
+    config.archivePath.clear();
+    config.telemetryPath.clear();
+    config.replayDirectory.clear();
+    config.checkpointInterval = 0;
+    int generations = commandLine.generations == 0 && commandLine.timeLimit <= 0.0f ? 1 : commandLine.generations;
+
+    auto simulationStart = std::chrono::steady_clock::now();
+    const char *status = nullptr;
+    unsigned long long ticks = 0;
+    std::size_t threads = 0;
+    {
+        Game game(config);
+        status = runGenerations(game, generations);
+        ticks = game.getSimulationTick();
+        threads = game.getSimulationThreadCount();
+    }
+    double simulationSeconds = secondsSince(simulationStart);
+    double ticksPerSecond = simulationSeconds > 0.0 ? ticks / simulationSeconds : 0.0;
+
+    writeResult(JsonLine("bench")
+                    .add("name", "simulation")
+                    .add("cars", config.populationSize)
+                    .add("threads", static_cast<int>(threads))
+                    .add("ticks", ticks)
+                    .add("seconds", simulationSeconds)
+                    .add("ticksPerSecond", ticksPerSecond)
+                    .add("carStepsPerSecond", ticksPerSecond * config.populationSize)
+                    .add("realTimeFactor", ticksPerSecond / config.tickRate)
+                    .str());
+
+    writeResult(JsonLine("summary")
+                    .add("command", CommandLine::getCommandName(commandLine.command))
+                    .add("status", status)
+                    .add("seconds", secondsSince(start))
+                    .add("seed", static_cast<unsigned long long>(config.seed))
+                    .str());
+    return 0;
+}
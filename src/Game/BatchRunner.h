@@ -0,0 +1,51 @@
+#pragma once
+#include "CommandLine.h"
+#include "GameConfig.h"
+#include <fstream>
+#include <ostream>
+#include <string>
+
+class Game;
+
+// Runs one command of the command line (see CommandLine::getUsage)
+// play opens the window as before. The batch commands (train, evaluate, replay, bench) run windowed or headless,
+// stop at their generation and time limits and report machine readable results: one JSON object per line,
+// on stdout or appended to --results. Their log output moves to stderr so stdout only carries results.
+class BatchRunner
+{
+private:
+    CommandLine commandLine;
+    GameConfig config;
+    std::ofstream resultsFile;
+    std::ostream results; // The results file or the original stdout
+
+    // Best generation reported so far
+    double bestFitness;
+    int bestGeneration;
+
+    bool loadConfig();
+    bool openResults();
+    void writeResult(const std::string &line);
+
+    // Log why the command could not run and report it as a summary with status "error", returns the exit code
+    int fail(const std::string &message);
+
+    int play();
+    int train();
+    int evaluate();
+    int replay();
+    int bench();
+
+    // The run starts from a checkpoint or the archive, which restores the random state after the seed
+    bool isResumed() const;
+
+    // Start learning, run until a limit is reached and report every generation, returns the run's status
+    const char *runGenerations(Game &game, int generations);
+    std::string findReplay() const;
+
+public:
+    explicit BatchRunner(const CommandLine &arguments);
+
+    // Exit code of the program: 0 after a run, 1 if it could not start (batch commands still write their summary)
+    int run();
+};
@@ -0,0 +1,110 @@
+#include "Camera.h"
+#include <algorithm>
+#include <cmath>
+
+Camera::Camera(sf::Vector2u viewportSize)
+    : center(static_cast<float>(viewportSize.x) / 2.0f, static_cast<float>(viewportSize.y) / 2.0f), zoom(1.0f),
+      viewportSize(viewportSize), minZoom(0.1f), maxZoom(50.0f), fitting(false), following(false),
+      followSharpness(5.0f)
+{
+}
+
+void Camera::setViewportSize(sf::Vector2u size)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    viewportSize = sf::Vector2f(size);
+    if (fitting)
+    {
+        applyFit();
+    }
+}
+
+void Camera::fitTo(const sf::FloatRect &bounds)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    fitBounds = bounds;
+    fitting = true;
+    following = false;
+    applyFit();
+}
+
+void Camera::applyFit()
+{
+    if (viewportSize.x <= 0.0f || viewportSize.y <= 0.0f)
+        return;
+
+    // Whole rectangle plus a small margin, centered
+    const float margin = 1.05f;
+    zoom = clampZoom(std::max(fitBounds.size.x / viewportSize.x, fitBounds.size.y / viewportSize.y) * margin);
+    center = fitBounds.position + fitBounds.size / 2.0f;
+}
+
+void Camera::zoomAt(float factor, sf::Vector2i pixel)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    fitting = false;
+
+    // World point under the pixel before zooming
+    sf::Vector2f offset = sf::Vector2f(pixel) - viewportSize / 2.0f;
+    sf::Vector2f worldPoint = center + offset * zoom;
+
+    zoom = clampZoom(zoom * factor);
+
+    // Move the center so the same world point ends up under the pixel (not while following, the car stays centered)
+    if (!following)
+    {
+        center = worldPoint - offset * zoom;
+    }
+}
+
+void Camera::pan(sf::Vector2f pixelDelta)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    fitting = false;
+    following = false;
+    center += pixelDelta * zoom;
+}
+
+void Camera::setFollowing(bool follow)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    following = follow;
+    if (follow)
+    {
+        fitting = false;
+    }
+}
+
+bool Camera::isFollowing() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return following;
+}
+
+void Camera::update(float deltaTime, bool hasTarget, sf::Vector2f target)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!following || !hasTarget)
+        return;
+
+    // Exponential smoothing, independent of the frame rate
+    float blend = 1.0f - std::exp(-followSharpness * deltaTime);
+    center += (target - center) * blend;
+}
+
+sf::View Camera::getView(sf::Vector2u targetSize) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return sf::View(center, sf::Vector2f(targetSize) * zoom);
+}
+
+float Camera::getZoom() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return zoom;
+}
+
+float Camera::clampZoom(float value) const
+{
+    return std::max(minZoom, std::min(maxZoom, value));
+}
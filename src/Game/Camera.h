@@ -0,0 +1,55 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <mutex>
+
+// World space camera: zoom, pan, follow a car, or fit a rectangle (the whole track) to the window
+// Input (main thread) and rendering (render thread) both use it, so every method locks
+class Camera
+{
+private:
+    mutable std::mutex mutex;
+
+    sf::Vector2f center;       // World position at the middle of the window
+    float zoom;                // World units per screen pixel
+    sf::Vector2f viewportSize; // Window size in pixels
+    float minZoom;
+    float maxZoom;
+
+    // Fit mode: keep fitBounds in view (also after resizing) until the user zooms or pans
+    bool fitting;
+    sf::FloatRect fitBounds;
+
+    // Follow mode: glide towards the followed car's position
+    bool following;
+    float followSharpness; // Higher follows more tightly
+
+    void applyFit();
+    float clampZoom(float value) const;
+
+public:
+    Camera(sf::Vector2u viewportSize);
+
+    // Window size changed (keeps center and zoom, refits in fit mode)
+    void setViewportSize(sf::Vector2u size);
+
+    // Show the whole rectangle and keep doing so until the user moves the camera
+    void fitTo(const sf::FloatRect &bounds);
+
+    // Zoom by factor (< 1 zooms in) keeping the world point under the pixel in place
+    void zoomAt(float factor, sf::Vector2i pixel);
+
+    // Move the view by a distance in screen pixels
+    void pan(sf::Vector2f pixelDelta);
+
+    // Follow the target passed to update()
+    void setFollowing(bool follow);
+    bool isFollowing() const;
+
+    // Advance the follow motion (call once per rendered frame)
+    void update(float deltaTime, bool hasTarget, sf::Vector2f target);
+
+    // View for a target of the given size (the recording can differ from the window)
+    sf::View getView(sf::Vector2u targetSize) const;
+
+    float getZoom() const;
+};
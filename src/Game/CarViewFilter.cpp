@@ -0,0 +1,117 @@
+#include "CarViewFilter.h"
+#include <algorithm>
+#include <numeric>
+
+CarViewFilter::CarViewFilter(std::size_t topCount, std::size_t sampleCount)
+    : topCount(topCount), sampleCount(sampleCount), sampledCarCount(0), sampledGeneration(-1),
+      rng(std::random_device{}())
+{
+}
+
+void CarViewFilter::setSampleCount(std::size_t count)
+{
+    sampleCount = count;
+    sampledCarCount = 0; // Draw a new sample next frame
+}
+
+const std::vector<std::size_t> &CarViewFilter::select(const SimulationSnapshot &snapshot, CarViewMode mode)
+{
+    const std::vector<CarSnapshot> &cars = snapshot.cars;
+
+    switch (mode)
+    {
+    case CarViewMode::TopFitness:
+        selectBest(cars, topCount);
+        break;
+
+    case CarViewMode::FollowBest:
+        selectBest(cars, 1);
+        break;
+
+    case CarViewMode::RandomSample:
+        // Keep the same cars for the whole generation so the view doesn't flicker
+        if (sampledCarCount != cars.size() || sampledGeneration != snapshot.generation)
+        {
+            drawSample(cars.size());
+            sampledGeneration = snapshot.generation;
+        }
+        selection = sample;
+        break;
+
+    default:
+        selection.resize(cars.size());
+        std::iota(selection.begin(), selection.end(), std::size_t(0));
+        break;
+    }
+
+    return selection;
+}
+
+void CarViewFilter::selectBest(const std::vector<CarSnapshot> &cars, std::size_t count)
+{
+    selection.resize(cars.size());
+    std::iota(selection.begin(), selection.end(), std::size_t(0));
+    count = std::min(count, cars.size());
+
+    // Partial selection is O(n), the population doesn't have to be fully sorted
+    auto better = [&cars](std::size_t a, std::size_t b)
+    {
+        if (cars[a].alive != cars[b].alive)
+            return cars[a].alive;
+        return cars[a].fitness > cars[b].fitness;
+    };
+    std::nth_element(selection.begin(), selection.begin() + count, selection.end(), better);
+    selection.resize(count);
+}
+
+void CarViewFilter::drawSample(std::size_t carCount)
+{
+    sample.resize(carCount);
+    std::iota(sample.begin(), sample.end(), std::size_t(0));
+
+    // Partial Fisher-Yates shuffle, only the first sampleCount entries are needed
+    std::size_t count = std::min(sampleCount, carCount);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::uniform_int_distribution<std::size_t> pick(i, carCount - 1);
+        std::swap(sample[i], sample[pick(rng)]);
+    }
+    sample.resize(count);
+    sampledCarCount = carCount;
+}
+
+int CarViewFilter::findBest(const std::vector<CarSnapshot> &cars)
+{
+    int best = -1;
+    for (std::size_t i = 0; i < cars.size(); ++i)
+    {
+        if (best < 0 ||
+            (cars[i].alive && !cars[best].alive) ||
+            (cars[i].alive == cars[best].alive && cars[i].fitness > cars[best].fitness))
+        {
+            best = static_cast<int>(i);
+        }
+    }
+    return best;
+}
+
+CarViewMode CarViewFilter::nextMode(CarViewMode mode)
+{
+    int next = (static_cast<int>(mode) + 1) % static_cast<int>(CarViewMode::Count);
+    return static_cast<CarViewMode>(next);
+}
+
+std::string CarViewFilter::getModeName(CarViewMode mode)
+{
+    switch (mode)
+    {
+    case CarViewMode::TopFitness:
+        return "Top Fitness";
+    case CarViewMode::RandomSample:
+        return "Random Sample";
+    case CarViewMode::FollowBest:
+        return "Follow Best";
+    default:
+        return "All";
+    }
+}
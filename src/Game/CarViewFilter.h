@@ -0,0 +1,57 @@
+#pragma once
+#include "SimulationSnapshot.h"
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+// Which AI cars are drawn
+enum class CarViewMode
+{
+    All,          // Every car
+    TopFitness,   // The cars with the highest current fitness
+    RandomSample, // A fixed random subset, drawn again every generation
+    FollowBest,   // Only the best car
+    Count
+};
+
+// Picks the cars to draw from a snapshot so the render cost doesn't grow with the population
+// Only used by the renderer, the selection is rebuilt every frame from the snapshot
+class CarViewFilter
+{
+private:
+    std::size_t topCount;    // Cars shown in TopFitness mode
+    std::size_t sampleCount; // Cars shown in RandomSample mode
+
+    std::vector<std::size_t> selection; // Indices into the snapshot cars
+    std::vector<std::size_t> sample;    // Current random sample (kept for a whole generation)
+    std::size_t sampledCarCount;        // Car count the sample was drawn for
+    int sampledGeneration;              // Generation the sample was drawn for
+    std::mt19937 rng;
+
+    // Rank cars by fitness (alive cars before crashed ones) and keep the best count of them
+    void selectBest(const std::vector<CarSnapshot> &cars, std::size_t count);
+
+    // Draw a new random sample of sampleCount cars
+    void drawSample(std::size_t carCount);
+
+public:
+    CarViewFilter(std::size_t topCount = 25, std::size_t sampleCount = 25);
+
+    // Indices of the cars to draw (valid until the next call)
+    const std::vector<std::size_t> &select(const SimulationSnapshot &snapshot, CarViewMode mode);
+
+    void setTopCount(std::size_t count) { topCount = count; }
+    void setSampleCount(std::size_t count);
+    std::size_t getTopCount() const { return topCount; }
+    std::size_t getSampleCount() const { return sampleCount; }
+
+    // Index of the best car (alive cars first, then highest fitness), -1 if there are none
+    static int findBest(const std::vector<CarSnapshot> &cars);
+
+    // Next mode in the cycle (All -> TopFitness -> RandomSample -> FollowBest -> All)
+    static CarViewMode nextMode(CarViewMode mode);
+
+    // Name shown in the HUD
+    static std::string getModeName(CarViewMode mode);
+};
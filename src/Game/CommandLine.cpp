@@ -0,0 +1,223 @@
+#include "CommandLine.h"
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+    bool parseCount(const char *text, int &result)
+    {
+        char *end = nullptr;
+        errno = 0;
+        long value = std::strtol(text, &end, 10);
+        if (*text == '\0' || *end != '\0' || errno != 0 || value < 0 || value > 1000000000L)
+            return false;
+        result = static_cast<int>(value);
+        return true;
+    }
+
+    bool parseSeconds(const char *text, float &result)
+    {
+        char *end = nullptr;
+        float value = std::strtof(text, &end);
+        if (*text == '\0' || *end != '\0' || !std::isfinite(value) || value < 0.0f)
+            return false;
+        result = value;
+        return true;
+    }
+}
+
+CommandLine::CommandLine()
+    : command(RunCommand::Play), configPath("../../Config/racecar.ini"), configGiven(false), headless(false),
+      trackGiven(false), help(false), quiet(false), generations(0), timeLimit(0.0f), resume(false), fromArchive(false),
+      archiveGeneration(-1), benchCars(10000), benchSteps(600)
+{
+}
+
+bool CommandLine::parse(int argc, char *argv[])
+{
+    int first = 1;
+    if (argc > 1 && argv[1][0] != '-')
+    {
+        std::string name = argv[1];
+        if (name == "play")
+            command = RunCommand::Play;
+        else if (name == "train")
+            command = RunCommand::Train;
+        else if (name == "evaluate")
+            command = RunCommand::Evaluate;
+        else if (name == "replay")
+            command = RunCommand::Replay;
+        else if (name == "bench")
+            command = RunCommand::Bench;
+        else
+        {
+            std::cerr << "Unknown command '" << name << "'" << std::endl;
+            return false;
+        }
+        first = 2;
+    }
+
+    for (int i = first; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (argument == "--help" || argument == "-h")
+        {
+            help = true;
+        }
+        else if (argument == "--headless")
+        {
+            headless = true;
+        }
+        else if (argument == "--quiet")
+        {
+            quiet = true;
+        }
+        else if (argument == "--record")
+        {
+            overrides.push_back("recording.enabled=true");
+        }
+        else if (argument == "--resume")
+        {
+            resume = true;
+        }
+        else if (argument == "--from-archive")
+        {
+            fromArchive = true;
+        }
+        else if (argument == "--config" && hasValue)
+        {
+            configPath = argv[++i];
+            configGiven = true;
+        }
+        else if (argument == "--results" && hasValue)
+        {
+            resultsPath = argv[++i];
+        }
+        else if (argument == "--track" && hasValue)
+        {
+            overrides.push_back(std::string("files.track=") + argv[++i]);
+            trackGiven = true;
+        }
+        else if (argument == "--checkpoint" && hasValue)
+        {
+            overrides.push_back(std::string("files.checkpoint=") + argv[++i]);
+        }
+        else if (argument == "--seed" && hasValue)
+        {
+            overrides.push_back(std::string("simulation.seed=") + argv[++i]);
+        }
+        else if (argument == "--generations" && hasValue)
+        {
+            if (!parseCount(argv[++i], generations))
+            {
+                std::cerr << "--generations expects a whole number, got '" << argv[i] << "'" << std::endl;
+                return false;
+            }
+        }
+        else if (argument == "--time-limit" && hasValue)
+        {
+            if (!parseSeconds(argv[++i], timeLimit))
+            {
+                std::cerr << "--time-limit expects seconds, got '" << argv[i] << "'" << std::endl;
+                return false;
+            }
+        }
+        else if (argument == "--archive-generation" && hasValue)
+        {
+            if (!parseCount(argv[++i], archiveGeneration))
+            {
+                std::cerr << "--archive-generation expects a generation number, got '" << argv[i] << "'" << std::endl;
+                return false;
+            }
+            fromArchive = true;
+        }
+        else if ((argument == "--cars" || argument == "--steps") && hasValue)
+        {
+            int &count = argument == "--cars" ? benchCars : benchSteps;
+            if (!parseCount(argv[++i], count) || count == 0)
+            {
+                std::cerr << argument << " expects a positive number, got '" << argv[i] << "'" << std::endl;
+                return false;
+            }
+        }
+        else if (argument.compare(0, 2, "--") == 0 && argument.find('=') != std::string::npos)
+        {
+            overrides.push_back(argument.substr(2));
+        }
+        else if (command == RunCommand::Replay && argument[0] != '-' && replayPath.empty())
+        {
+            replayPath = argument;
+        }
+        else
+        {
+            std::cerr << "Unknown argument '" << argument << "'" << std::endl;
+            return false;
+        }
+    }
+
+    if (resume && fromArchive)
+    {
+        std::cerr << "--resume and --from-archive/--archive-generation exclude each other" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+const char *CommandLine::getCommandName(RunCommand command)
+{
+    switch (command)
+    {
+    case RunCommand::Play:
+        return "play";
+    case RunCommand::Train:
+        return "train";
+    case RunCommand::Evaluate:
+        return "evaluate";
+    case RunCommand::Replay:
+        return "replay";
+    case RunCommand::Bench:
+        return "bench";
+    }
+    return "play";
+}
+
+const char *CommandLine::getUsage()
+{
+    return "Usage: RaceCar [command] [options] [--section.key=value ...]\n"
+           "\n"
+           "Commands:\n"
+           "  play                     Open the window and train interactively (default)\n"
+           "  train                    Train, then save files.checkpoint; headless runs need --generations or --time-limit\n"
+           "  evaluate                 Drive a saved population without evolving it (--generations, default 1)\n"
+           "                           from files.checkpoint, or from the archive with --from-archive\n"
+           "  replay [file]            Play a recorded run (the newest in files.replays by default);\n"
+           "                           headless, it is driven to the end and the final poses are reported\n"
+           "  bench                    Time the vehicle model (--cars, --steps) and headless simulation ticks\n"
+           "\n"
+           "Options:\n"
+           "  --config <file>          Settings file (default ../../Config/racecar.ini)\n"
+           "  --headless               No window, simulate as fast as possible\n"
+           "  --record                 Record frames from the start (also headless, see the recording.* keys)\n"
+           "  --generations <n>        Stop after n evaluated generations\n"
+           "  --time-limit <seconds>   Stop after this much real time\n"
+           "  --track <file>           Track file (must exist)\n"
+           "  --checkpoint <file>      Training checkpoint to load and save\n"
+           "  --resume                 train: continue from the checkpoint\n"
+           "  --from-archive           train/evaluate: start from the newest archived generation\n"
+           "  --archive-generation <n> train/evaluate: start from the population evolved from generation n\n"
+           "  --seed <n>               Seed of evolution's random numbers (batch runs pick and report one otherwise)\n"
+           "  --cars <n>, --steps <n>  bench: size of the vehicle model benchmark\n"
+           "  --results <file>         Append the JSON result lines to a file instead of stdout\n"
+           "  --quiet                  Log warnings and errors only\n"
+           "\n"
+           "Batch commands write one JSON object per line (\"type\": generation, replayCar, bench or summary),\n"
+           "the log goes to stderr. The exit code is 0 on success and 1 if the run could not start, the summary\n"
+           "then has \"status\": \"error\" and the reason. Runs resumed from a checkpoint report the fingerprint\n"
+           "of the restored random state (\"randomState\") instead of a seed.\n"
+           "\n"
+           "Config keys:\n";
+}
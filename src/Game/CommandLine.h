@@ -0,0 +1,42 @@
+#pragma once
+#include <string>
+#include <vector>
+
+enum class RunCommand
+{
+    Play,     // Interactive window (no command given)
+    Train,    // Evolve for a number of generations or a time budget
+    Evaluate, // Drive a saved population without evolving it
+    Replay,   // Play a recorded run
+    Bench     // Measure the vehicle model and the simulation tick rate
+};
+
+// Arguments of one run, parsed but not applied yet (BatchRunner loads the config and applies the overrides)
+struct CommandLine
+{
+    RunCommand command;
+    std::string configPath;
+    bool configGiven;                   // --config named the file, so it has to exist
+    std::vector<std::string> overrides; // "section.key=value", in command line order
+    bool headless;                      // --headless, same as --window.render=headless
+    bool trackGiven;                    // --track named the file, so it has to exist
+    bool help;
+    bool quiet;                         // Warnings and errors only
+    int generations;                    // Generations to evaluate, 0 for no limit
+    float timeLimit;                    // Seconds of real time, 0 for no limit
+    bool resume;                        // train: continue from files.checkpoint
+    bool fromArchive;                   // train/evaluate: start from an archived generation
+    int archiveGeneration;              // -1 for the newest one
+    std::string replayPath;             // replay: empty plays the newest file in files.replays
+    std::string resultsPath;            // JSON lines are appended here, empty writes them to stdout
+    int benchCars;
+    int benchSteps;
+
+    CommandLine();
+
+    // Reports the first problem on stderr and returns false
+    bool parse(int argc, char *argv[]);
+
+    static const char *getCommandName(RunCommand command);
+    static const char *getUsage();
+};
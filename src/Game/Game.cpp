@@ -1,5 +1,6 @@
 #include "Game.h"
 #include "../Background/Background.h"
+#include "../Background/StaticLayer.h"
 #include "../Track/track.h"
 #include "../Car/Car.h"
 #include "../Timer/TimerLogic.h"
@@ -9,101 +10,304 @@
 #include "../UI/UIManager.h"
 #include "../AI/NetworkRenderHandler.h"
 #include "../AI/Population.h"
+#include "../AI/FrozenNetwork.h"
 #include "../AI/AIController.h"
-#include <iostream>
-#include <unordered_map> // Added for checkCarStuck
-#include <iomanip>       // Added for std::fixed and std::setprecision
-
-Game::Game(unsigned int width, unsigned int height)
-    : deltaTime(0.016f), fps(60.0f), frameCount(0), performanceFontLoaded(false),
-      fpsText(nullptr), // Default to 60 FPS
+#include "../Car/StuckDetector.h"
+#include "../Car/CarCollision.h"
+#include "../Car/FleetRenderer.h"
+#include "../Car/SensorRenderer.h"
+#include "../UI/HudRenderer.h"
+#include "../Persistence/BinaryIO.h"
+#include "../Persistence/CheckpointWriter.h"
+#include "../Persistence/PopulationArchive.h"
+#include "../Persistence/TelemetryWriter.h"
+#include "../Logging/Logger.h"
+#include "../Persistence/TrainingCheckpoint.h"
+#include "../Recording/ReplayRecorder.h"
+#include "../Recording/ReplayPlayer.h"
+#include "../Recording/GhostLap.h"
+#include "../AI/Random.h"
+#include "Camera.h"
+#include "CarViewFilter.h"
+#include "SimulationSnapshot.h"
+#include "TripleBuffer.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <numeric>
+#include <thread>
+
+Game::Game(const GameConfig &gameConfig)
+    : config(gameConfig), simulationStep(1.0f / gameConfig.tickRate), simulationAccumulator(0.0f), simulationTick(0),
+      fastForward(false), fastForwardTicks(gameConfig.fastForwardTicks), simulationRateTicks(0), simulationRate(0.0f),
+      renderThreadEnabled(gameConfig.renderThread), closeRequested(false),
+      resizePending(false), pendingWidth(gameConfig.windowWidth), pendingHeight(gameConfig.windowHeight),
+      deltaTime(0.016f), renderFrameTime(0.016f), fps(60.0f), frameCount(0), // Default to 60 FPS
+      fpsLabel(-1), aiStatsLabel(-1),
       aiLearningEnabled(false), aiLearningPaused(false), generationTime(0.0f),
-      maxGenerationTime(20.0f), currentGeneration(0), bestFitnessGeneration(0)
+      maxGenerationTime(20.0f), currentGeneration(0), bestFitnessGeneration(0),
+      raceLaps(gameConfig.raceLaps), bestLapTime(0.0f), vehicleClass(gameConfig.vehicleClass),
+      carCollisionsEnabled(gameConfig.carCollisions),
+      carViewMode(CarViewMode::All), drawnCarCount(0), showSensors(false), recordingRequested(false),
+      checkpointPath(gameConfig.checkpointPath), checkpointInterval(gameConfig.checkpointInterval),
+      archivePath(gameConfig.archivePath), championPath(gameConfig.championPath),
+      telemetryPath(gameConfig.telemetryPath), replayDirectory(gameConfig.replayDirectory),
+      replayRunName(ReplayFile::makeRunName()), replayRecordFitness(0.0),
+      maxGhosts(5),
+      trackPath(gameConfig.trackPath), networkCarIndex(-1),
+      generationLimit(0), timeLimit(0.0f), timeLimitReached(false), evolutionEnabled(true), closeWhenIdle(false),
+      evaluatedGenerations(0),
+      panning(false), lastPanPixel(0, 0)
 {
-    // Create window
-    window = std::make_unique<sf::RenderWindow>(sf::VideoMode({width, height}), "Race Car - AI Learning Simulation");
-    window->setFramerateLimit(60);
-    window->setVerticalSyncEnabled(true);
+    unsigned int width = config.windowWidth;
+    unsigned int height = config.windowHeight;
+
+    // A fixed seed makes a run repeatable (the checkpoints keep the engine state from then on)
+    if (config.seed != 0)
+    {
+        Random::seed(config.seed);
+    }
 
     // Create game objects
-    background = std::make_unique<Background>(width, height, 128);
     track = std::make_unique<Track>(width, height);
+    if (!track->loadFromFile(trackPath))
+    {
+        // First start: build the built-in track and bake it for the next start
+        // A file that exists but can't be loaded (damaged, newer version) is never replaced, the built-in track is only used
+        track->createDefaultLayout();
+        std::error_code error;
+        if (!std::filesystem::exists(trackPath, error))
+        {
+            track->saveToFile(trackPath);
+        }
+        else
+        {
+            LOG_ERROR("Track " << trackPath << " could not be loaded, using the built-in track (the file is left as it is)");
+        }
+    }
 
     // Create timer system
     timerLogic = std::make_unique<TimerLogic>();
-    timerRenderer = std::make_unique<TimerRenderer>(*timerLogic);
 
     // Create checkpoint system
     checkpointHandler = std::make_unique<CheckpointHandler>();
     checkpointHandler->initializeCheckpoints(track->getCheckpointSegments());
-    checkpointUIRenderer = std::make_unique<CheckpointUIRenderer>(*checkpointHandler);
-
-    // Create UI system
-    uiManager = std::make_unique<UIManager>();
-    uiManager->initialize();
-
-    // Set up button callbacks
-    uiManager->setStartCallback([this]()
-                                {
-                                    std::cout << "Start button clicked!" << std::endl;
-                                    startAILearning(); });
-
-    uiManager->setStopCallback([this]()
-                               {
-                                   std::cout << "Pause button clicked!" << std::endl;
-                                   pauseAILearning(); });
-
-    uiManager->setSaveCallback([this]()
-                               {
-                                   std::cout << "Save button clicked!" << std::endl;
-                                   saveAITrainingData(); });
-
-    // Initialize AI population
-    const int numInputs = 10;      // 8 ray sensors + speed + rotation
-    const int numOutputs = 2;      // steering + acceleration
-    const int numHidden = 0;       // Start with 0 hidden nodes (basic structure)
-    const int populationSize = 25; // Reduced from 50 to 25 for better performance
+    checkpointHandler->setRaceLaps(raceLaps);
 
-    aiPopulation = std::make_unique<Population>(populationSize, numInputs, numOutputs, numHidden);
+    // A headless game has no window (batch runs, see BatchRunner), it only draws when it records frames
+    if (!config.headless)
+    {
+        window = std::make_unique<sf::RenderWindow>(sf::VideoMode({width, height}), "Race Car - AI Learning Simulation");
+        window->setFramerateLimit(60);
+        window->setVerticalSyncEnabled(true);
+    }
 
-    // Set up checkpoint handler for multiple cars
-    checkpointHandler->setMaxCars(populationSize);
+    if (window || config.recordFrames)
+    {
+        background = std::make_unique<Background>(128);
+        staticLayer = std::make_unique<StaticLayer>();
 
-    createAICars();
+        // Start with the whole track in view
+        camera = std::make_unique<Camera>(window ? window->getSize() : sf::Vector2u(config.recordingWidth, config.recordingHeight));
+        camera->fitTo(track->getTrackBounds());
+
+        // Create the HUD (shared by all text overlays)
+        hud = std::make_unique<HudRenderer>(config.fontPath);
+        timerRenderer = std::make_unique<TimerRenderer>(*hud);
+        checkpointUIRenderer = std::make_unique<CheckpointUIRenderer>(*hud);
+    }
+
+    if (window)
+    {
+        // Create UI system
+        uiManager = std::make_unique<UIManager>();
+        uiManager->initialize(config.fontPath);
+
+        // Set up button callbacks
+        uiManager->setStartCallback([this]()
+                                    {
+                                        LOG_INFO("Start button clicked!");
+                                        startAILearning(); });
+
+        uiManager->setStopCallback([this]()
+                                   {
+                                       LOG_INFO("Pause button clicked!");
+                                       pauseAILearning(); });
+
+        uiManager->setSaveCallback([this]()
+                                   {
+                                       LOG_INFO("Save button clicked!");
+                                       saveAITrainingData(); });
+    }
 
-    // Initialize performance monitoring
-    if (performanceFont.openFromFile("../../Fonts/ARIAL.TTF"))
+    stuckDetector = std::make_unique<StuckDetector>();
+    workerPool = std::make_unique<WorkerPool>(static_cast<unsigned int>(config.threadCount));
+    carCollision = std::make_unique<CarCollision>();
+    fleetRenderer = std::make_unique<FleetRenderer>();
+    carViewFilter = std::make_unique<CarViewFilter>();
+    sensorRenderer = std::make_unique<SensorRenderer>();
+    frameRecorder = std::make_unique<FrameRecorder>();
+    recordingSettings.directory = config.recordingDirectory;
+    recordingSettings.format = config.recordingRaw ? FrameFormat::RawRGBA : FrameFormat::PngSequence;
+    recordingSettings.frameSkip = config.recordingFrameSkip;
+    recordingSettings.maxQueuedFrames = static_cast<std::size_t>(config.recordingMaxQueuedFrames);
+    recordingRequested = config.recordFrames;
+    checkpointWriter = std::make_unique<CheckpointWriter>();
+    populationArchive = std::make_unique<PopulationArchiveWriter>();
+    if (!archivePath.empty() && !populationArchive->open(archivePath))
+    {
+        LOG_WARNING("Generations will not be archived");
+    }
+    telemetryWriter = std::make_unique<TelemetryWriter>();
+    TelemetryWriter::Format telemetryFormat = config.telemetryCsv ? TelemetryWriter::Format::Csv : TelemetryWriter::Format::Binary;
+    if (!telemetryPath.empty() && !telemetryWriter->open(telemetryPath, telemetryFormat))
     {
-        performanceFontLoaded = true;
-        fpsText = new sf::Text(performanceFont, "", 12);
-        fpsText->setFillColor(sf::Color::Yellow);
-        fpsText->setOutlineColor(sf::Color::Black);
-        fpsText->setOutlineThickness(1.0f);
+        LOG_WARNING("Telemetry will not be recorded");
     }
+    replayRecorder = std::make_unique<ReplayRecorder>();
+    replayPlayer = std::make_unique<ReplayPlayer>();
+    replayWriter = std::make_unique<CheckpointWriter>(true);
+
+    // Initialize AI population (size, sensors and network from the config)
+    initializeAIPopulation();
+    LOG_INFO("Population of " << config.populationSize << " cars, " << config.getInputCount() << " inputs, "
+             << workerPool->getThreadCount() << " simulation threads");
+
+    if (!hud)
+        return;
+
+    // Initialize performance monitoring and AI stats labels
+    fpsLabel = hud->addLabel(12, sf::Color::Yellow, sf::Color::Black, 1.0f);
+    aiStatsLabel = hud->addLabel(16, sf::Color::Green, sf::Color::Black, 1.0f);
+    hud->setPosition(aiStatsLabel, sf::Vector2f(10.0f, 10.0f));
+    shownPerformanceStats.fill(-1); // Nothing shown yet, the first frame builds both texts
+    shownAIStats.fill(-1);
 
     // Initialize network visualization
     networkRenderHandler = std::make_unique<NetworkRenderHandler>();
     networkRenderHandler->setDisplayPosition(20.0f, 800.0f);
     networkRenderHandler->setDisplaySize(400.0f, 300.0f);
     networkRenderHandler->setVisible(true); // Start visible for testing
+
+    // Publish the initial state so the first frame has something to draw
+    if (window)
+    {
+        snapshots = std::make_unique<TripleBuffer<SimulationSnapshot>>();
+        publishSnapshot();
+    }
 }
 
 Game::~Game()
 {
-    if (fpsText)
-    {
-        delete fpsText;
-    }
 }
 
 void Game::run()
 {
+    runClock.restart();
+    if (config.headless)
+    {
+        runHeadless();
+        return;
+    }
+
+    if (renderThreadEnabled)
+    {
+        // The render thread takes over the OpenGL context, events and simulation stay on this thread
+        if (window->setActive(false))
+        {
+            std::thread renderThread(&Game::renderLoop, this);
+
+            while (isRunning())
+            {
+                handleEvents();
+                update();
+            }
+
+            closeRequested = true;
+            renderThread.join();
+
+            if (!window->setActive(true))
+            {
+                LOG_WARNING("Failed to reactivate the window after the render thread stopped");
+            }
+            window->close();
+            return;
+        }
+
+        LOG_WARNING("Could not release the OpenGL context, rendering on the main thread");
+    }
+
     while (isRunning())
     {
         handleEvents();
         update();
         render();
     }
+    frameRecorder->stop();
+    window->close();
+}
+
+void Game::runHeadless()
+{
+    // No events and no window, only simulation ticks (and the recorded ones drawn off-screen) until a batch limit is reached
+    sf::Vector2u frameSize(config.recordingWidth, config.recordingHeight);
+    while (!closeRequested)
+    {
+        updateRecording(frameSize);
+        stepSimulation();
+        if (checkRunLimits())
+            closeRequested = true;
+    }
+    frameRecorder->stop();
+
+    // Let the background writers finish before the results are reported
+    checkpointWriter->flush();
+    replayWriter->flush();
+}
+
+std::size_t Game::getSimulationThreadCount() const
+{
+    return workerPool->getThreadCount();
+}
+
+bool Game::checkRunLimits()
+{
+    if (timeLimit > 0.0f && runClock.getElapsedTime().asSeconds() >= timeLimit)
+    {
+        timeLimitReached = true;
+        LOG_INFO("Time limit of " << LogFixed(timeLimit, 0) << "s reached");
+        return true;
+    }
+
+    if (generationLimit > 0 && evaluatedGenerations >= generationLimit)
+        return true;
+
+    bool simulating = replayPlayer->isPlaying() || (aiLearningEnabled && !aiLearningPaused);
+    return !simulating && (closeWhenIdle || config.headless);
+}
+
+void Game::renderLoop()
+{
+    if (!window->setActive(true))
+    {
+        LOG_WARNING("Render thread could not activate the window");
+        return;
+    }
+
+    // Draw at display rate (the frame limit only throttles this thread)
+    while (!closeRequested)
+    {
+        render();
+    }
+
+    // Finish writing any queued frames
+    frameRecorder->stop();
+
+    if (!window->setActive(false))
+    {
+        LOG_WARNING("Render thread could not release the window");
+    }
 }
 
 void Game::handleEvents()
@@ -112,13 +316,13 @@ void Game::handleEvents()
     {
         if (event->is<sf::Event::Closed>())
         {
-            window->close();
+            closeRequested = true;
         }
         else if (const auto *keyPressed = event->getIf<sf::Event::KeyPressed>())
         {
             if (keyPressed->scancode == sf::Keyboard::Scancode::Escape)
             {
-                window->close();
+                closeRequested = true;
             }
             else if (keyPressed->scancode == sf::Keyboard::Scancode::R)
             {
@@ -128,26 +332,160 @@ void Game::handleEvents()
             {
                 startTimer();
             }
+            else if (keyPressed->scancode == sf::Keyboard::Scancode::L)
+            {
+                // Toggle between single lap training and a 3 lap race
+                setRaceLaps(raceLaps == 1 ? 3 : 1);
+            }
+            else if (keyPressed->scancode == sf::Keyboard::Scancode::C)
+            {
+                // Toggle car-to-car collisions
+                carCollisionsEnabled = !carCollisionsEnabled;
+                LOG_INFO("Car collisions " << (carCollisionsEnabled ? "enabled" : "disabled"));
+            }
+            else if (keyPressed->scancode == sf::Keyboard::Scancode::V)
+            {
+                // Cycle which AI cars are drawn
+                carViewMode = CarViewFilter::nextMode(carViewMode);
+                LOG_INFO("Car view: " << CarViewFilter::getModeName(carViewMode));
+            }
+            else if (keyPressed->scancode == sf::Keyboard::Scancode::S)
+            {
+                // Toggle the ray sensor layer
+                showSensors = !showSensors;
+                LOG_INFO("Sensors " << (showSensors ? "shown" : "hidden"));
+            }
+            else if (keyPressed->scancode == sf::Keyboard::Scancode::B)
+            {
+                // Toggle the camera following the best car
+                camera->setFollowing(!camera->isFollowing());
+            }
+            else if (keyPressed->scancode == sf::Keyboard::Scancode::Home)
+            {
+                // Show the whole track again
+                camera->fitTo(track->getTrackBounds());
+            }
+            else if (keyPressed->scancode == sf::Keyboard::Scancode::Equal ||
+                     keyPressed->scancode == sf::Keyboard::Scancode::Hyphen)
+            {
+                // Zoom around the window center
+                float factor = keyPressed->scancode == sf::Keyboard::Scancode::Equal ? 0.8f : 1.25f;
+                camera->zoomAt(factor, sf::Vector2i(window->getSize() / 2u));
+            }
+            else if (keyPressed->scancode == sf::Keyboard::Scancode::Left ||
+                     keyPressed->scancode == sf::Keyboard::Scancode::Right ||
+                     keyPressed->scancode == sf::Keyboard::Scancode::Up ||
+                     keyPressed->scancode == sf::Keyboard::Scancode::Down)
+            {
+                // Pan by a tenth of the window
+                sf::Vector2f step(window->getSize().x * 0.1f, window->getSize().y * 0.1f);
+                sf::Vector2f delta(0.0f, 0.0f);
+                if (keyPressed->scancode == sf::Keyboard::Scancode::Left)
+                    delta.x = -step.x;
+                else if (keyPressed->scancode == sf::Keyboard::Scancode::Right)
+                    delta.x = step.x;
+                else if (keyPressed->scancode == sf::Keyboard::Scancode::Up)
+                    delta.y = -step.y;
+                else
+                    delta.y = step.y;
+                camera->pan(delta);
+            }
+            else if (keyPressed->scancode == sf::Keyboard::Scancode::F5)
+            {
+                saveAITrainingData();
+            }
+            else if (keyPressed->scancode == sf::Keyboard::Scancode::F9)
+            {
+                // Shift resumes after the newest archived generation instead of the last checkpoint
+                if (keyPressed->shift)
+                    resumeFromArchive();
+                else
+                    loadAITrainingData();
+            }
+            else if (keyPressed->scancode == sf::Keyboard::Scancode::E)
+            {
+                exportChampion();
+            }
+            else if (keyPressed->scancode == sf::Keyboard::Scancode::Y)
+            {
+                // Play the newest recorded best run, or go back to training
+                if (isReplayPlaying())
+                {
+                    stopReplay();
+                }
+                else
+                {
+                    std::vector<std::string> replays = ReplayFile::findFiles(replayDirectory);
+                    if (!lastReplayPath.empty())
+                        playReplay(lastReplayPath);
+                    else if (!replays.empty())
+                        playReplay(replays.back());
+                    else
+                        LOG_INFO("No replays in " << replayDirectory);
+                }
+            }
+            else if (keyPressed->scancode == sf::Keyboard::Scancode::G)
+            {
+                // Toggle the ghosts of earlier best runs
+                if (areGhostsShown())
+                    hideGhosts();
+                else
+                    showGhosts();
+            }
+            else if (keyPressed->scancode == sf::Keyboard::Scancode::P)
+            {
+                // Toggle recording frames to disk
+                recordingRequested = !recordingRequested;
+            }
+            else if (keyPressed->scancode == sf::Keyboard::Scancode::F)
+            {
+                // Toggle running the simulation as fast as possible
+                fastForward = !fastForward;
+                simulationAccumulator = 0.0f;
+                LOG_INFO("Fast forward " << (fastForward ? "enabled" : "disabled"));
+            }
+        }
+        else if (const auto *scrolled = event->getIf<sf::Event::MouseWheelScrolled>())
+        {
+            // Zoom towards the mouse cursor
+            camera->zoomAt(std::pow(0.9f, scrolled->delta), scrolled->position);
+        }
+        else if (const auto *pressed = event->getIf<sf::Event::MouseButtonPressed>())
+        {
+            // Drag with the right or middle button to pan
+            if (pressed->button == sf::Mouse::Button::Right || pressed->button == sf::Mouse::Button::Middle)
+            {
+                panning = true;
+                lastPanPixel = pressed->position;
+            }
+        }
+        else if (const auto *released = event->getIf<sf::Event::MouseButtonReleased>())
+        {
+            if (released->button == sf::Mouse::Button::Right || released->button == sf::Mouse::Button::Middle)
+            {
+                panning = false;
+            }
+        }
+        else if (const auto *moved = event->getIf<sf::Event::MouseMoved>())
+        {
+            if (panning)
+            {
+                // Dragging moves the world with the mouse
+                camera->pan(sf::Vector2f(lastPanPixel - moved->position));
+                lastPanPixel = moved->position;
+            }
         }
         else if (const auto *resized = event->getIf<sf::Event::Resized>())
         {
-            // Update window dimensions and game objects when resized
-            window->clear();
-            unsigned int newWidth = resized->size.x;
-            unsigned int newHeight = resized->size.y;
-
-            background->setWindowSize(newWidth, newHeight);
-            track->setWindowSize(newWidth, newHeight);
-
-            // Update the view to match the new window size
-            sf::View view = window->getView();
-            view.setSize({static_cast<float>(newWidth), static_cast<float>(newHeight)});
-            view.setCenter({static_cast<float>(newWidth) / 2.0f, static_cast<float>(newHeight) / 2.0f});
-            window->setView(view);
+            // The renderer applies the new size at the start of its next frame
+            pendingWidth = resized->size.x;
+            pendingHeight = resized->size.y;
+            resizePending = true;
         }
 
-        // Handle UI events
-        sf::Vector2f mousePos = window->mapPixelToCoords(sf::Mouse::getPosition(*window));
+        // Handle UI events (the UI is drawn in screen coordinates)
+        sf::Vector2f mousePos(sf::Mouse::getPosition(*window));
+        std::lock_guard<std::recursive_mutex> lock(uiMutex);
         uiManager->handleEvent(*event, mousePos);
     }
 }
@@ -157,78 +495,421 @@ void Game::update()
     // Calculate delta time
     deltaTime = deltaClock.restart().asSeconds();
 
-    // Update performance stats
-    updatePerformanceStats();
-
     // Update timer
     timerLogic->update();
 
-    // Update UI
-    checkpointUIRenderer->updateText();
-
     // Update UI manager
-    sf::Vector2f mousePos = window->mapPixelToCoords(sf::Mouse::getPosition(*window));
-    uiManager->update(mousePos);
+    {
+        sf::Vector2f mousePos(sf::Mouse::getPosition(*window));
+        std::lock_guard<std::recursive_mutex> lock(uiMutex);
+        uiManager->update(mousePos);
+    }
 
-    // Update AI cars if AI learning is enabled
-    if (aiLearningEnabled)
+    // Advance the simulation in fixed ticks
+    int ticks = 0;
+    if (fastForward)
+    {
+        // Not tied to real time, the renderer just shows the latest snapshot
+        for (; ticks < fastForwardTicks; ++ticks)
+        {
+            stepSimulation();
+        }
+    }
+    else
+    {
+        // Limit the catch up after a stall so the simulation doesn't spiral
+        simulationAccumulator += std::min(deltaTime, 0.25f);
+        while (simulationAccumulator >= simulationStep)
+        {
+            stepSimulation();
+            simulationAccumulator -= simulationStep;
+            ticks++;
+        }
+    }
+
+    if (checkRunLimits())
+    {
+        closeRequested = true;
+    }
+
+    // Measure the simulation rate
+    if (simulationRateClock.getElapsedTime().asSeconds() >= 1.0f)
+    {
+        simulationRate = simulationRateTicks / simulationRateClock.restart().asSeconds();
+        simulationRateTicks = 0;
+    }
+
+    if (ticks > 0)
+    {
+        publishSnapshot();
+    }
+    else if (renderThreadEnabled)
+    {
+        // Nothing to simulate yet, don't spin at 100% CPU
+        sf::sleep(sf::milliseconds(1));
+    }
+}
+
+void Game::stepSimulation()
+{
+    if (replayPlayer->isPlaying())
     {
-        updateAICars(deltaTime);
+        // The recorded cars drive instead of the population, training waits until the replay ends
+        if (!replayPlayer->step(*track))
+        {
+            LOG_INFO("Replay finished");
+        }
+    }
+    else if (aiLearningEnabled)
+    {
+        // Update AI cars if AI learning is enabled
+        updateAICars(simulationStep);
     }
+
+    simulationTick++;
+    simulationRateTicks++;
+    captureTick();
+}
+
+void Game::publishSnapshot()
+{
+    fillSnapshot(snapshots->getWriteBuffer());
+    snapshots->publish();
+}
+
+void Game::fillSnapshot(SimulationSnapshot &snapshot)
+{
+    snapshot.tick = simulationTick;
+    snapshot.simulationRate = simulationRate;
+
+    // Car poses and sensor readings (the vectors keep their capacity between ticks)
+    // A replay shows its own cars, they cast no sensors
+    const auto &controllers = aiPopulation->getControllers();
+    bool replaying = replayPlayer->isPlaying();
+    const auto &shownCars = replaying ? replayPlayer->getCars() : aiCars;
+    snapshot.cars.resize(shownCars.size());
+    snapshot.sensorAngles.clear();
+    snapshot.sensorRange = 0.0f;
+    if (showSensors && !replaying && !aiCars.empty())
+    {
+        const RaySensorHandler &sensors = aiCars[0]->getRaySensors();
+        for (size_t r = 0; r < sensors.getRayCount(); ++r)
+        {
+            snapshot.sensorAngles.push_back(sensors.getRay(r).getAngle());
+            snapshot.sensorRange = std::max(snapshot.sensorRange, sensors.getRay(r).getMaxLength());
+        }
+    }
+    size_t raysPerCar = snapshot.sensorAngles.size();
+    snapshot.sensorDistances.resize(shownCars.size() * raysPerCar);
+
+    for (size_t i = 0; i < shownCars.size(); ++i)
+    {
+        const VehicleState &state = shownCars[i]->getVehicleState();
+        CarSnapshot &car = snapshot.cars[i];
+        car.x = state.x;
+        car.y = state.y;
+        car.rotation = state.rotation;
+        if (replaying)
+        {
+            car.fitness = static_cast<float>(replayPlayer->getReplay().cars[i].fitness);
+            car.alive = replayPlayer->isCarActive(i);
+        }
+        else
+        {
+            car.fitness = i < controllers.size() ? static_cast<float>(controllers[i]->getFitness()) : 0.0f;
+            car.alive = i < controllers.size() && controllers[i]->isCarAlive();
+        }
+
+        const RaySensorHandler &sensors = shownCars[i]->getRaySensors();
+        for (size_t r = 0; r < raysPerCar && r < sensors.getRayCount(); ++r)
+        {
+            snapshot.sensorDistances[i * raysPerCar + r] = sensors.getRay(r).getLength();
+        }
+    }
+
+    // Live activations of the visualized network
+    if (networkCarIndex >= 0 && networkCarIndex < static_cast<int>(controllers.size()))
+    {
+        controllers[networkCarIndex]->getBrain().copyNodeValues(snapshot.networkActivations);
+    }
+    else
+    {
+        snapshot.networkActivations.clear();
+    }
+
+    // Ghosts follow the time of the shown run
+    snapshot.ghosts = ghosts;
+    snapshot.replaying = replaying;
+    snapshot.ghostTime = replaying ? replayPlayer->getTick() * replayPlayer->getReplay().simulationStep : generationTime;
+
+    // HUD stats
+    snapshot.aiLearningEnabled = aiLearningEnabled;
+    snapshot.aiLearningPaused = aiLearningPaused;
+    snapshot.generation = currentGeneration;
+    snapshot.bestFitness = aiPopulation->getBestFitness();
+    snapshot.speciesCount = aiPopulation->getSpeciesCount();
+    snapshot.generationTime = generationTime;
+    snapshot.maxGenerationTime = calculateMaxGenerationTime();
+    snapshot.raceLaps = raceLaps;
+    snapshot.carCollisionsEnabled = carCollisionsEnabled;
+    snapshot.fastForward = fastForward;
+    snapshot.timeString = timerLogic->getTimeString();
+    snapshot.hitCheckpoints = checkpointHandler->getHitCheckpoints();
+    snapshot.totalCheckpoints = checkpointHandler->getTotalCheckpoints();
+}
+
+void Game::applyPendingResize()
+{
+    if (!resizePending.exchange(false))
+        return;
+
+    // Update window dimensions and game objects when resized
+    unsigned int newWidth = pendingWidth;
+    unsigned int newHeight = pendingHeight;
+
+    track->setWindowSize(newWidth, newHeight);
+    staticLayer->invalidate();
+
+    // The camera keeps its zoom (or keeps the track fitted) for the new window size
+    camera->setViewportSize({newWidth, newHeight});
 }
 
 void Game::render()
 {
-    window->clear();
+    // Take the newest snapshot, if the simulation hasn't published one since the last frame keep the old one
+    snapshots->acquire();
+    const SimulationSnapshot &snapshot = snapshots->getReadBuffer();
 
-    // Draw background
-    background->draw(*window);
+    applyPendingResize();
 
-    // Draw track
-    track->draw(*window);
-    track->drawCheckeredFlag(*window);
-    track->drawTrackEdges(*window);
+    // Update performance stats
+    updatePerformanceStats();
 
-    // Draw AI cars if AI learning is enabled
-    if (aiLearningEnabled)
+    // Camera follows the best car when following is on
+    int bestCar = CarViewFilter::findBest(snapshot.cars);
+    if (bestCar >= 0)
+    {
+        const CarSnapshot &car = snapshot.cars[bestCar];
+        camera->update(renderFrameTime, snapshot.aiLearningEnabled, sf::Vector2f(car.x, car.y));
+    }
+
+    renderScene(*window, snapshot, true);
+    window->display();
+
+    // Recorded ticks are drawn off-screen with the same camera
+    updateRecording(window->getSize());
+    drawCapturedTicks();
+}
+
+void Game::renderScene(sf::RenderTarget &target, const SimulationSnapshot &snapshot, bool useStaticLayer)
+{
+    // The world is drawn through the camera, the UI in screen pixels
+    sf::View screenView(sf::FloatRect(sf::Vector2f(0.0f, 0.0f), sf::Vector2f(target.getSize())));
+    target.setView(camera->getView(target.getSize()));
+    target.clear();
+
+    // Draw background and track (cached in one layer while the camera stands still)
+    if (useStaticLayer && staticLayer->update(target, *background, *track))
+    {
+        staticLayer->draw(target);
+    }
+    else
     {
-        for (const auto &aiCar : aiCars)
+        background->draw(target);
+        track->draw(target);
+    }
+
+    // Draw AI cars if AI learning is enabled or a replay plays (the selected, visible cars in one batch)
+    drawnCarCount = 0;
+    if (snapshot.aiLearningEnabled || snapshot.replaying)
+    {
+        sf::FloatRect visibleArea = FleetRenderer::getViewBounds(target.getView());
+        const std::vector<std::size_t> &shownCars = carViewFilter->select(snapshot, carViewMode);
+
+        // Ray sensors under the cars, only when switched on and published
+        size_t raysPerCar = snapshot.sensorAngles.size();
+        if (showSensors && raysPerCar > 0 && snapshot.sensorDistances.size() == snapshot.cars.size() * raysPerCar)
         {
-            aiCar->draw(*window);
-            aiCar->drawRaySensors(*window);
+            sensorRenderer->begin(visibleArea);
+            for (std::size_t index : shownCars)
+            {
+                const CarSnapshot &car = snapshot.cars[index];
+                sensorRenderer->addCar(car.x, car.y, car.rotation, snapshot.sensorAngles.data(),
+                                       &snapshot.sensorDistances[index * raysPerCar], raysPerCar, snapshot.sensorRange);
+            }
+            sensorRenderer->draw(target);
         }
+
+        fleetRenderer->begin(visibleArea);
+
+        // Ghosts go in the same batch, first so the live cars are drawn over them
+        if (snapshot.ghosts)
+        {
+            const std::uint8_t ghostAlpha = 90;
+            GhostPose pose;
+            for (const GhostLap &ghost : *snapshot.ghosts)
+            {
+                if (ghost.getPose(snapshot.ghostTime, pose))
+                    fleetRenderer->addCar(pose.x, pose.y, pose.rotation, ghostAlpha);
+            }
+        }
+
+        for (std::size_t index : shownCars)
+        {
+            const CarSnapshot &car = snapshot.cars[index];
+            fleetRenderer->addCar(car.x, car.y, car.rotation);
+        }
+        fleetRenderer->draw(target);
+        drawnCarCount = fleetRenderer->getCarCount();
     }
 
     // Draw checkpoints
-    checkpointHandler->drawCheckpoints(*window);
+    checkpointHandler->drawCheckpoints(target, snapshot.hitCheckpoints);
 
     // Draw UI
-    timerRenderer->draw(*window);
-    checkpointUIRenderer->draw(*window);
-
-    // Draw UI manager (buttons)
-    uiManager->draw(*window);
+    target.setView(screenView);
+    timerRenderer->setTimeString(snapshot.timeString);
+    timerRenderer->draw(target);
+    checkpointUIRenderer->updateText(snapshot.hitCheckpoints, snapshot.totalCheckpoints);
+    checkpointUIRenderer->draw(target);
+
+    // Draw UI manager (buttons, none without a window)
+    if (uiManager)
+    {
+        std::lock_guard<std::recursive_mutex> lock(uiMutex);
+        uiManager->draw(target);
+    }
 
     // Draw performance stats
-    drawPerformanceStats();
+    drawPerformanceStats(snapshot, target.getSize());
 
     // Draw AI stats
-    drawAIStats();
+    drawAIStats(snapshot);
+
+    // Draw all HUD text in one batch
+    hud->draw(target);
 
     // Draw network visualization
     if (networkRenderHandler)
     {
-        networkRenderHandler->draw(*window);
+        std::lock_guard<std::recursive_mutex> lock(uiMutex);
+        networkRenderHandler->updateActivations(snapshot.networkActivations);
+        networkRenderHandler->draw(target);
     }
+}
 
-    window->display();
+void Game::updateRecording(sf::Vector2u frameSize)
+{
+    // The render texture has to be created on the thread that draws into it, a game that can't draw never records
+    if (recordingRequested && !frameRecorder->isRecording() && hud)
+    {
+        RecordingSettings settings;
+        {
+            std::lock_guard<std::recursive_mutex> lock(uiMutex);
+            settings = recordingSettings;
+        }
+        settings.tickRate = config.tickRate;
+        settings.waitForWriter = config.headless;
+        if (!frameRecorder->start(settings, frameSize))
+        {
+            recordingRequested = false;
+        }
+    }
+    else if (!recordingRequested && frameRecorder->isRecording())
+    {
+        frameRecorder->stop();
+
+        // Ticks selected before the stop are not drawn anymore
+        std::lock_guard<std::mutex> lock(captureMutex);
+        for (SimulationSnapshot &snapshot : capturedTicks)
+            spareCaptures.push_back(std::move(snapshot));
+        capturedTicks.clear();
+    }
+}
+
+void Game::captureTick()
+{
+    if (!frameRecorder->isRecording())
+        return;
+
+    // A headless game draws the tick right away (the recorder holds the simulation while the writer is behind)
+    if (config.headless)
+    {
+        if (!frameRecorder->shouldCapture(simulationTick, 0))
+            return;
+        if (spareCaptures.empty())
+            spareCaptures.emplace_back();
+        fillSnapshot(spareCaptures.back());
+        renderScene(frameRecorder->beginFrame(), spareCaptures.back(), false);
+        frameRecorder->endFrame(simulationTick);
+        return;
+    }
+
+    // The window's render thread gets a copy of the tick, however many ticks pass between its frames
+    SimulationSnapshot snapshot;
+    {
+        std::lock_guard<std::mutex> lock(captureMutex);
+        if (!frameRecorder->shouldCapture(simulationTick, capturedTicks.size()))
+            return;
+        if (!spareCaptures.empty())
+        {
+            snapshot = std::move(spareCaptures.back());
+            spareCaptures.pop_back();
+        }
+    }
+    fillSnapshot(snapshot);
+
+    std::lock_guard<std::mutex> lock(captureMutex);
+    capturedTicks.push_back(std::move(snapshot));
+}
+
+void Game::drawCapturedTicks()
+{
+    {
+        std::lock_guard<std::mutex> lock(captureMutex);
+        drawnCaptures.swap(capturedTicks);
+    }
+    if (drawnCaptures.empty())
+        return;
+
+    // The recording keeps the size it was started with, the camera view is scaled to it
+    for (const SimulationSnapshot &snapshot : drawnCaptures)
+    {
+        if (!frameRecorder->isRecording())
+            break;
+        renderScene(frameRecorder->beginFrame(), snapshot, false);
+        frameRecorder->endFrame(snapshot.tick);
+    }
+
+    std::lock_guard<std::mutex> lock(captureMutex);
+    for (SimulationSnapshot &snapshot : drawnCaptures)
+        spareCaptures.push_back(std::move(snapshot));
+    drawnCaptures.clear();
+}
+
+void Game::startRecording(const RecordingSettings &settings)
+{
+    {
+        std::lock_guard<std::recursive_mutex> lock(uiMutex);
+        recordingSettings = settings;
+    }
+    recordingRequested = true;
+}
+
+void Game::startRecording()
+{
+    recordingRequested = true;
+}
+
+void Game::stopRecording()
+{
+    recordingRequested = false;
 }
 
 void Game::reset()
 {
     timerLogic->reset();
     checkpointHandler->resetAllCheckpoints();
-    checkpointUIRenderer->updateText();
     if (aiLearningEnabled)
     {
         stopAILearning();
@@ -248,7 +929,7 @@ void Game::stopTimer()
 
 bool Game::isRunning() const
 {
-    return window->isOpen();
+    return (!window || window->isOpen()) && !closeRequested;
 }
 
 bool Game::isLapCompleted() const
@@ -258,6 +939,7 @@ bool Game::isLapCompleted() const
 
 void Game::updatePerformanceStats()
 {
+    renderFrameTime = renderClock.restart().asSeconds();
     frameCount++;
 
     // Update FPS every second
@@ -269,41 +951,39 @@ void Game::updatePerformanceStats()
     }
 }
 
-void Game::drawPerformanceStats()
+void Game::drawPerformanceStats(const SimulationSnapshot &snapshot, sf::Vector2u targetSize)
 {
-    if (!performanceFontLoaded || !fpsText)
+    // Position in top-right corner, moved down to avoid AI stats overlap
+    float windowWidth = static_cast<float>(targetSize.x);
+    hud->setPosition(fpsLabel, sf::Vector2f(windowWidth - 350.0f, 200.0f));
+
+    // Only rebuild the text when the shown numbers change
+    const std::array<int, 5> stats = {static_cast<int>(fps), static_cast<int>(renderFrameTime * 1000.0f),
+                                      static_cast<int>(snapshot.simulationRate),
+                                      static_cast<int>(100.0f / camera->getZoom()),
+                                      static_cast<int>(track->getDrawnVertexCount())};
+    if (stats == shownPerformanceStats)
         return;
+    shownPerformanceStats = stats;
 
-    try
-    {
-        // Position in top-right corner, moved down to avoid AI stats overlap
-        float windowWidth = static_cast<float>(window->getSize().x);
-        fpsText->setPosition(sf::Vector2f(windowWidth - 350.0f, 200.0f));
-
-        // Update text content
-        std::string fpsString = "FPS: " + std::to_string(static_cast<int>(fps));
-        std::string frameTimeString = "Frame: " + std::to_string(static_cast<int>(deltaTime * 1000.0f)) + "ms";
-
-        fpsText->setString(fpsString + "\n" + frameTimeString);
-
-        window->draw(*fpsText);
-    }
-    catch (...)
-    {
-        // Silently fail if text rendering fails
-    }
+    std::string fpsString = "FPS: " + std::to_string(stats[0]);
+    std::string frameTimeString = "Frame: " + std::to_string(stats[1]) + "ms";
+    std::string simulationString = "Sim: " + std::to_string(stats[2]) + " ticks/s";
+    std::string cameraString = "Zoom: " + std::to_string(stats[3]) + "%, Track: " + std::to_string(stats[4]) + " verts";
+    hud->setText(fpsLabel, fpsString + "\n" + frameTimeString + "\n" + simulationString + "\n" + cameraString);
 }
 
 // AI Learning Methods
 
 void Game::initializeAIPopulation()
 {
-    // Initialize NEAT population with 50 cars, 19 inputs (16 rays + speed + rotation + checkpoint progress), 2 outputs (steering, acceleration)
-    const int populationSize = 50;
-    const int numInputs = 19; // 16 ray sensors + speed + rotation + checkpoint progress
-    const int numOutputs = 2; // steering, acceleration
-    const int numHidden = 8;  // hidden layer size
+    // One input per ray sensor plus speed and rotation, 2 outputs (steering, acceleration)
+    const int populationSize = config.populationSize;
+    const int numInputs = config.getInputCount();
+    const int numOutputs = 2;
+    const int numHidden = config.hiddenNodes;
 
+    std::lock_guard<std::recursive_mutex> lock(uiMutex);
     aiPopulation = std::make_unique<Population>(populationSize, numInputs, numOutputs, numHidden);
 
     // Set up checkpoint handler for multiple cars
@@ -320,17 +1000,27 @@ void Game::createAICars()
     sf::Vector2f startPos = track->getStartPosition();
     float startRotation = track->getStartRotation();
 
+    // Load the vehicle class once and share it with every car (defaults if the config is missing)
+    VehicleParams vehicleParams;
+    vehicleParams.loadFromFile(config.vehiclesPath, vehicleClass);
+
     // Create cars for each AI controller
     const auto &controllers = aiPopulation->getControllers();
     for (size_t i = 0; i < controllers.size(); ++i)
     {
         auto car = std::make_unique<Car>(startPos.x, startPos.y);
         car->setPosition(startPos.x, startPos.y);
+        car->setVehicleParams(vehicleParams);
+        car->setSensorLayout(config.sensorAngles, config.sensorRange);
         aiCars.push_back(std::move(car));
 
         // Reset the controller with the car's position
         controllers[i]->reset(startPos, startRotation);
     }
+
+    stuckDetector->resize(aiCars.size());
+    stuckDetector->resetAll(startPos);
+    replayRecorder->stop();
 }
 
 void Game::startAILearning()
@@ -346,48 +1036,261 @@ void Game::startAILearning()
     // Update network visualization to show initial structure
     updateNetworkVisualization();
 
-    std::cout << "=== AI LEARNING SIMULATION STARTED ===" << std::endl;
-    std::cout << "Generation: " << currentGeneration << " (max " << std::fixed << std::setprecision(1) << calculateMaxGenerationTime() << "s per generation)" << std::endl;
-    std::cout << "Population Size: " << aiCars.size() << " cars" << std::endl;
-    std::cout << "Press the buttons to control the simulation." << std::endl;
+    LOG_INFO("=== AI LEARNING SIMULATION STARTED ===");
+    LOG_INFO("Generation: " << currentGeneration << " (max " << LogFixed(calculateMaxGenerationTime(), 1) << "s per generation)");
+    LOG_INFO("Population Size: " << aiCars.size() << " cars");
+    LOG_INFO("Press the buttons to control the simulation.");
 }
 
 void Game::pauseAILearning()
 {
     aiLearningPaused = !aiLearningPaused;
-    std::cout << "AI Learning " << (aiLearningPaused ? "PAUSED" : "RESUMED") << std::endl;
+    LOG_INFO("AI Learning " << (aiLearningPaused ? "PAUSED" : "RESUMED"));
 }
 
 void Game::stopAILearning()
 {
     aiLearningEnabled = false;
     aiLearningPaused = false;
-    std::cout << "=== AI LEARNING SIMULATION STOPPED ===" << std::endl;
+    LOG_INFO("=== AI LEARNING SIMULATION STOPPED ===");
+}
+
+TrainingState Game::getTrainingState() const
+{
+    TrainingState state;
+    state.bestFitnessGeneration = bestFitnessGeneration;
+    state.raceLaps = raceLaps;
+    return state;
 }
 
 void Game::saveAITrainingData()
 {
-    // TODO: Implement saving the best neural network to file
-    std::cout << "AI training data saved!" << std::endl;
+    if (!aiPopulation)
+        return;
+
+    // Serializing is quick, the file is written in the background
+    std::vector<char> data = TrainingCheckpoint::encode(*aiPopulation, getTrainingState());
+    LOG_INFO("AI training data saved (generation " << aiPopulation->getGeneration() << ", "
+             << data.size() / 1024 << " KB) to " << checkpointPath);
+    checkpointWriter->save(checkpointPath, std::move(data));
+}
+
+bool Game::loadAITrainingData()
+{
+    if (!aiPopulation)
+        return false;
+
+    // Make sure a save that is still being written is the one that gets loaded
+    checkpointWriter->flush();
+
+    std::vector<char> data;
+    if (!CheckpointWriter::readFile(checkpointPath, data))
+    {
+        LOG_WARNING("No AI training data found at " << checkpointPath);
+        return false;
+    }
+
+    // The network visualization points into the population, keep the render thread off it while it changes
+    std::lock_guard<std::recursive_mutex> lock(uiMutex);
+
+    TrainingState state;
+    if (!TrainingCheckpoint::decode(data, *aiPopulation, state))
+    {
+        LOG_WARNING("AI training data could not be loaded, training continues unchanged");
+        return false;
+    }
+
+    restartLoadedGeneration(state);
+    LOG_INFO("AI training data loaded: generation " << currentGeneration << ", "
+             << aiPopulation->getControllers().size() << " cars, "
+             << aiPopulation->getSpeciesCount() << " species");
+    return true;
+}
+
+bool Game::resumeFromArchive(int generation)
+{
+    if (!aiPopulation)
+        return false;
+
+    // Only the index and the one record are read, however long the archive is
+    PopulationArchiveReader reader;
+    if (!reader.open(archivePath) || reader.getEntryCount() == 0)
+    {
+        LOG_WARNING("No archived generations found at " << archivePath);
+        return false;
+    }
+
+    ArchiveEntry entry;
+    if (generation < 0)
+        entry = reader.getEntry(reader.getEntryCount() - 1);
+    else if (!reader.findGeneration(generation, entry))
+    {
+        LOG_WARNING("Generation " << generation << " is not in the archive");
+        return false;
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(uiMutex);
+
+    TrainingState state;
+    if (!reader.loadPopulation(entry, *aiPopulation, state))
+    {
+        LOG_WARNING("Archived generation " << entry.generation << " could not be loaded, training continues unchanged");
+        return false;
+    }
+
+    restartLoadedGeneration(state);
+    LOG_INFO("Resumed after archived generation " << entry.generation << " (champion fitness " << entry.bestFitness
+             << "), now at generation " << currentGeneration);
+    return true;
+}
+
+bool Game::exportChampion()
+{
+    if (!aiPopulation)
+        return false;
+
+    std::shared_ptr<AIController> best = aiPopulation->getBestController();
+    if (!best)
+        return false;
+
+    FrozenNetwork champion = FrozenNetwork::fromGenome(best->getBrain());
+    if (!champion.saveToFile(championPath))
+    {
+        LOG_WARNING("Could not export the champion to " << championPath);
+        return false;
+    }
+
+    LOG_INFO("Champion exported to " << championPath << " (fitness " << best->getFitness() << ", "
+             << champion.getNodeCount() << " nodes, " << champion.getConnectionCount() << " connections)");
+    return true;
+}
+
+bool Game::playReplay(const std::string &path)
+{
+    // The replay may be one this run saved and the writer hasn't finished
+    replayWriter->flush();
+
+    ReplayData replay;
+    if (!ReplayFile::load(path, replay))
+    {
+        LOG_WARNING("No replay loaded from " << path);
+        return false;
+    }
+
+    // The same inputs only drive the same run on the same layout
+    if (replay.trackId != track->getLayoutId())
+    {
+        LOG_WARNING("Replay " << path << " was recorded on a different track");
+        return false;
+    }
+
+    VehicleParams vehicleParams;
+    vehicleParams.loadFromFile(config.vehiclesPath, replay.vehicleClass);
+
+    LOG_INFO("Playing replay of generation " << replay.generation << " (" << replay.cars.size() << " cars, "
+             << LogFixed(replay.tickCount * replay.simulationStep, 1) << "s)");
+    replayPlayer->start(std::move(replay), vehicleParams);
+    return true;
+}
+
+void Game::stopReplay()
+{
+    replayPlayer->stop();
+}
+
+bool Game::isReplayPlaying() const
+{
+    return replayPlayer->isPlaying();
 }
 
-void Game::loadAITrainingData()
+bool Game::addGhost(const ReplayData &replay, std::vector<GhostLap> &ghostLaps) const
 {
-    // TODO: Implement loading neural network from file
-    std::cout << "AI training data loaded!" << std::endl;
+    // The same inputs only drive the same run on the same layout
+    if (replay.cars.empty() || replay.trackId != track->getLayoutId())
+        return false;
+
+    VehicleParams vehicleParams;
+    vehicleParams.loadFromFile(config.vehiclesPath, replay.vehicleClass);
+
+    GhostLap ghost;
+    if (!ghost.buildFromReplay(replay, 0, *track, vehicleParams))
+        return false;
+
+    ghostLaps.push_back(std::move(ghost));
+    return true;
+}
+
+bool Game::showGhosts()
+{
+    // The newest best runs of one run: this one once it saved a replay, otherwise the newest earlier run
+    // (champions of unrelated runs are never mixed). Each is driven once here and only interpolated afterwards.
+    std::string runName = replayRunName;
+    std::vector<std::string> replays = ReplayFile::findFiles(replayDirectory, runName);
+    if (replays.empty())
+    {
+        replays = ReplayFile::findFiles(replayDirectory);
+        runName = replays.empty() ? std::string() : ReplayFile::getRunName(replays.back());
+        if (!runName.empty())
+            replays = ReplayFile::findFiles(replayDirectory, runName);
+    }
+
+    auto ghostLaps = std::make_shared<std::vector<GhostLap>>();
+    for (auto it = replays.rbegin(); it != replays.rend() && ghostLaps->size() < maxGhosts; ++it)
+    {
+        ReplayData replay;
+        if (ReplayFile::load(*it, replay))
+            addGhost(replay, *ghostLaps);
+    }
+
+    if (ghostLaps->empty())
+    {
+        LOG_INFO("No replays of this track in " << replayDirectory);
+        return false;
+    }
+
+    std::reverse(ghostLaps->begin(), ghostLaps->end());
+    ghosts = std::move(ghostLaps);
+    ghostRunName = runName;
+    LOG_INFO("Showing " << ghosts->size() << " ghosts");
+    return true;
+}
+
+void Game::hideGhosts()
+{
+    ghosts.reset();
+}
+
+void Game::restartLoadedGeneration(const TrainingState &state)
+{
+    currentGeneration = aiPopulation->getGeneration();
+    bestFitnessGeneration = state.bestFitnessGeneration;
+    raceLaps = std::max(1, state.raceLaps);
+    checkpointHandler->setRaceLaps(raceLaps);
+
+    // Start the loaded generation from the beginning
+    checkpointHandler->setMaxCars(aiPopulation->getPopulationSize());
+    createAICars();
+    checkpointHandler->resetAllCarProgress();
+    generationTime = 0.0f;
+    bestLapTime = 0.0f;
+    updateNetworkVisualization();
 }
 
 float Game::calculateMaxGenerationTime() const
 {
-    // Dynamic generation time based on generation number
-    if (currentGeneration < 25)
-        return 5.0f; // 5 seconds for generations 0-24
-    else if (currentGeneration < 50)
-        return 10.0f; // 10 seconds for generations 25-49
-    else if (currentGeneration < 75)
-        return 15.0f; // 15 seconds for generations 50-74
-    else
-        return 20.0f; // 20 seconds for generations 75+
+    // Dynamic generation time based on generation number (per lap in race mode, see generation.lapTimeSchedule)
+    return config.getLapTime(currentGeneration) * raceLaps;
+}
+
+void Game::setRaceLaps(int laps)
+{
+    raceLaps = std::max(1, laps);
+    checkpointHandler->setRaceLaps(raceLaps);
+
+    // Restart the current generation so every car races the same distance
+    resetAICars();
+
+    LOG_INFO("Race mode: " << raceLaps << (raceLaps == 1 ? " lap" : " laps") << " per generation");
 }
 
 void Game::evolvePopulation()
@@ -395,18 +1298,26 @@ void Game::evolvePopulation()
     if (!aiPopulation)
         return;
 
-    // Capture fitness values BEFORE evolution and reset
+    // The network visualization points into the population, keep the render thread off it while it changes
+    std::lock_guard<std::recursive_mutex> lock(uiMutex);
+
+    // Capture the results of every car BEFORE evolution replaces the controllers
     const auto &controllers = aiPopulation->getControllers();
-    std::vector<double> fitnessValues;
-    std::vector<int> checkpointValues;
-    std::vector<float> timeValues;
+    GenerationTelemetry telemetry;
+    telemetry.generation = aiPopulation->getGeneration();
+    telemetry.generationTime = generationTime;
+    float evaluatedBestLapTime = bestLapTime; // Resetting the cars clears it
 
     for (const auto &controller : controllers)
     {
-        fitnessValues.push_back(controller->getFitness());
-        checkpointValues.push_back(controller->getCheckpointsHit());
-        timeValues.push_back(controller->getTimeAlive());
+        const NeuralNetwork &brain = controller->getBrain();
+        telemetry.fitness.push_back(controller->getFitness());
+        telemetry.checkpoints.push_back(controller->getCheckpointsHit());
+        telemetry.timeAlive.push_back(controller->getTimeAlive());
+        telemetry.genomeNodes.push_back(static_cast<std::uint32_t>(brain.getNumInputs() + brain.getNumHidden() + brain.getNumOutputs()));
+        telemetry.genomeConnections.push_back(static_cast<std::uint32_t>(brain.getConnections().size()));
     }
+    const std::vector<double> &fitnessValues = telemetry.fitness;
 
     // Update the population's best fitness tracking before evolution
     double currentBestFitness = 0.0;
@@ -421,6 +1332,49 @@ void Game::evolvePopulation()
     // Update the population's best fitness (this will be used by the UI)
     aiPopulation->setBestFitness(currentBestFitness);
 
+    // Keep the champion of the evaluated generation for the archive (evolving replaces the controllers)
+    int evaluatedGeneration = aiPopulation->getGeneration();
+    NeuralNetwork champion;
+    std::size_t championIndex = 0;
+    if (!fitnessValues.empty())
+    {
+        championIndex = std::max_element(fitnessValues.begin(), fitnessValues.end()) - fitnessValues.begin();
+        champion = controllers[championIndex]->getBrain();
+    }
+
+    // A new best run is kept as a replay, the recording ends with this generation either way
+    if (!fitnessValues.empty() && currentBestFitness > replayRecordFitness && replayRecorder->isRecording())
+    {
+        ReplayData replay = replayRecorder->extract({championIndex});
+        if (!replay.cars.empty())
+        {
+            replay.cars[0].fitness = currentBestFitness;
+
+            // Queued behind any replay that isn't written yet, makePath also avoids the names of those
+            lastReplayPath = ReplayFile::makePath(replayDirectory, replayRunName, evaluatedGeneration, savedReplayPaths);
+            savedReplayPaths.insert(lastReplayPath);
+            replayWriter->save(lastReplayPath, ReplayFile::encode(replay));
+            replayRecordFitness = currentBestFitness;
+            LOG_INFO("New best run, replay saved to " << lastReplayPath);
+
+            // Shown ghosts get the new best run right away (a new list, the render thread may still use the old one),
+            // ghosts of an earlier run make way for this run's
+            if (ghosts)
+            {
+                auto ghostLaps = ghostRunName == replayRunName ? std::make_shared<std::vector<GhostLap>>(*ghosts)
+                                                               : std::make_shared<std::vector<GhostLap>>();
+                if (addGhost(replay, *ghostLaps))
+                {
+                    if (ghostLaps->size() > maxGhosts)
+                        ghostLaps->erase(ghostLaps->begin());
+                    ghosts = std::move(ghostLaps);
+                    ghostRunName = replayRunName;
+                }
+            }
+        }
+    }
+    replayRecorder->stop();
+
     // Evolve the population
     aiPopulation->evolve();
     currentGeneration = aiPopulation->getGeneration();
@@ -435,37 +1389,55 @@ void Game::evolvePopulation()
         bestFitnessGeneration = currentGeneration;
     }
 
-    std::cout << "=== GENERATION " << currentGeneration << " COMPLETED ===" << std::endl;
-    std::cout << "Best Fitness: " << evolvedBestFitness << std::endl;
-    std::cout << "Generation Time: " << std::fixed << std::setprecision(1) << generationTime << "s" << std::endl;
-    std::cout << "Max Generation Time: " << std::fixed << std::setprecision(1) << calculateMaxGenerationTime() << "s" << std::endl;
-    std::cout << "Species Count: " << aiPopulation->getSpeciesCount() << std::endl;
+    // Species as they were evaluated (evolving culls them afterwards)
+    telemetry.species.assign(aiPopulation->getEvaluatedSpeciesIds().begin(), aiPopulation->getEvaluatedSpeciesIds().end());
+    for (const auto &species : aiPopulation->getEvaluatedSpecies())
+    {
+        telemetry.speciesId.push_back(species.id);
+        telemetry.speciesSize.push_back(static_cast<std::uint32_t>(species.size));
+        telemetry.speciesAverageFitness.push_back(species.averageFitness);
+        telemetry.speciesBestFitness.push_back(species.bestFitness);
+        telemetry.speciesStaleness.push_back(species.staleness);
+    }
 
-    // Show fitness breakdown for the best car using captured values
-    if (!fitnessValues.empty())
+    // One line on the console, the per car and per species rows go to the telemetry file
+    if (Logger::isEnabled(LogLevel::Info))
     {
-        auto bestIndex = std::max_element(fitnessValues.begin(), fitnessValues.end()) - fitnessValues.begin();
-        double bestFitness = fitnessValues[bestIndex];
-        int bestCheckpoints = checkpointValues[bestIndex];
-        float bestTime = timeValues[bestIndex];
+        LogLine summary;
+        summary << "Generation " << evaluatedGeneration << ": best " << LogFixed(currentBestFitness, 0);
+        if (!fitnessValues.empty())
+        {
+            auto bestIndex = std::max_element(fitnessValues.begin(), fitnessValues.end()) - fitnessValues.begin();
+            double averageFitness = std::accumulate(fitnessValues.begin(), fitnessValues.end(), 0.0) / fitnessValues.size();
+            summary << " (" << telemetry.checkpoints[bestIndex] << " checkpoints, " << LogFixed(telemetry.timeAlive[bestIndex], 1)
+                    << "s), avg " << LogFixed(averageFitness, 0);
+        }
+        summary << ", " << telemetry.speciesId.size() << " species, " << LogFixed(telemetry.generationTime, 1) << "s";
+        if (evaluatedBestLapTime > 0.0f)
+        {
+            summary << ", best lap " << LogFixed(evaluatedBestLapTime, 2) << "s";
+        }
+        Logger::write(LogLevel::Info, summary);
+    }
 
-        std::cout << "Best Car - Checkpoints: " << bestCheckpoints
-                  << ", Time Alive: " << std::fixed << std::setprecision(1) << bestTime << "s"
-                  << ", Speed: " << std::fixed << std::setprecision(2) << (bestTime > 0.0f ? (bestCheckpoints / bestTime) : 0.0f) << " checkpoints/s" << std::endl;
+    if (telemetryWriter->isOpen())
+    {
+        telemetryWriter->append(std::move(telemetry));
     }
 
-    // Output fitness for all cars using captured values
-    std::cout << "\n=== ALL CARS FITNESS ===" << std::endl;
-    for (size_t i = 0; i < fitnessValues.size(); ++i)
+    // Archive every generation, resuming from it continues with the population evolved from it
+    if (populationArchive->isOpen())
     {
-        std::cout << "Car " << i << ": Fitness=" << std::fixed << std::setprecision(0) << fitnessValues[i]
-                  << ", Checkpoints=" << checkpointValues[i]
-                  << ", Time=" << std::fixed << std::setprecision(1) << timeValues[i] << "s"
-                  << ", Speed=" << std::fixed << std::setprecision(2) << (timeValues[i] > 0.0f ? (checkpointValues[i] / timeValues[i]) : 0.0f) << " c/s"
-                  << ", Alive=" << (timeValues[i] > 0.0f ? "Yes" : "No") << std::endl;
+        populationArchive->append(evaluatedGeneration, static_cast<std::uint32_t>(aiPopulation->getControllers().size()),
+                                  static_cast<std::uint32_t>(aiPopulation->getSpeciesCount()), currentBestFitness, champion,
+                                  TrainingCheckpoint::encode(*aiPopulation, getTrainingState()));
     }
 
-    std::cout << "Starting next generation..." << std::endl;
+    // Periodic checkpoint, so a crash or restart loses at most a few generations
+    if (checkpointInterval > 0 && currentGeneration % checkpointInterval == 0)
+    {
+        saveAITrainingData();
+    }
 
     // Update network visualization after evolution
     updateNetworkVisualization();
@@ -487,7 +1459,15 @@ void Game::resetAICars()
         controllers[i]->reset(startPos, startRotation);
     }
 
+    // Checkpoint progress, lap times and stuck timers belong to the generation that just ended
+    checkpointHandler->resetAllCarProgress();
+    stuckDetector->resetAll(startPos);
+
     generationTime = 0.0f;
+    bestLapTime = 0.0f;
+
+    // The next tick starts a new recording from the start positions
+    replayRecorder->stop();
 }
 
 void Game::updateAICars(float deltaTime)
@@ -497,47 +1477,45 @@ void Game::updateAICars(float deltaTime)
 
     const auto &controllers = aiPopulation->getControllers();
 
-    for (size_t i = 0; i < aiCars.size() && i < controllers.size(); ++i)
+    // Record the inputs for replays (a reset or a new generation starts a new recording)
+    if (!replayRecorder->isRecording() && !replayDirectory.empty())
     {
-        auto &car = aiCars[i];
-        auto &controller = controllers[i];
-
-        // Store previous position for checkpoint detection
-        sf::Vector2f previousPosition = sf::Vector2f(car->getX(), car->getY());
-
-        // Update car physics
-        car->update(deltaTime);
-
-        // Update ray sensors
-        car->updateRaySensors(track->getInnerEdgePoints(), track->getOuterEdgePoints());
-
-        // Handle collisions with track edges (bounce back instead of instant kill)
-        car->handleCollision(track->getInnerEdgePoints(), track->getOuterEdgePoints());
-
-        // Check checkpoint progress
-        sf::Vector2f currentPosition = sf::Vector2f(car->getX(), car->getY());
-        checkpointHandler->checkCarPositionWithLine(i, previousPosition, currentPosition);
-
-        // Update checkpoint count for this controller
-        int currentCheckpoints = checkpointHandler->getHitCheckpoints(i);
-        controller->setCheckpointsHit(currentCheckpoints);
-
-        // Get sensor data
-        std::vector<float> rayDistances = car->getRayDistances();
+        ReplayData header;
+        header.trackId = track->getLayoutId();
+        std::string randomState = Random::getState();
+        header.seed = fnv1a(randomState.data(), randomState.size());
+        header.generation = aiPopulation->getGeneration();
+        header.simulationStep = deltaTime;
+        header.vehicleClass = vehicleClass;
+        replayRecorder->begin(header, aiCars);
+    }
 
-        // Control the car with AI
-        controller->controlCar(*car, rayDistances);
+    // Every car only touches its own car, controller, checkpoint progress, stuck timer and replay channel,
+    // so the cars are stepped in parallel; values shared between cars are combined afterwards
+    size_t carCount = std::min(aiCars.size(), controllers.size());
+    completedLapTimes.assign(carCount, 0.0f);
+    workerPool->parallelFor(carCount, [this, deltaTime](size_t begin, size_t end)
+                            {
+                                for (size_t i = begin; i < end; ++i)
+                                    stepAICar(i, deltaTime); });
 
-        // Update fitness
-        controller->updateFitness(deltaTime);
+    for (float lapTime : completedLapTimes)
+    {
+        if (lapTime > 0.0f && (bestLapTime == 0.0f || lapTime < bestLapTime))
+            bestLapTime = lapTime;
+    }
 
-        // Check if car is stuck (but don't check for crashes again since we already did)
-        if (checkCarStuck(*car))
+    // Resolve car-to-car collisions between the cars still racing
+    if (carCollisionsEnabled)
+    {
+        std::vector<bool> activeCars(aiCars.size(), false);
+        for (size_t i = 0; i < aiCars.size() && i < controllers.size(); ++i)
         {
-            controller->kill();
-            std::cout << "Car " << i << " killed for being stuck" << std::endl;
+            activeCars[i] = controllers[i]->isCarAlive();
         }
+        carCollision->step(aiCars, activeCars);
     }
+    replayRecorder->endTick(aiCars);
 
     // Update generation timer
     generationTime += deltaTime;
@@ -549,73 +1527,151 @@ void Game::updateAICars(float deltaTime)
 
     if (timeExpired || allFinished)
     {
-        std::cout << "Generation ending - Time: " << std::fixed << std::setprecision(1) << generationTime
-                  << "s / " << currentMaxTime << "s, All Finished: " << (allFinished ? "Yes" : "No") << std::endl;
+        LOG_DEBUG("Generation ending - Time: " << LogFixed(generationTime, 1) << "s / " << LogFixed(currentMaxTime, 1)
+                                               << "s, All Finished: " << (allFinished ? "Yes" : "No"));
+        endGeneration();
+    }
+}
+
+void Game::endGeneration()
+{
+    // Evolving and resetting the cars clear the results, take them first
+    GenerationResult result = getGenerationResult();
+
+    if (evolutionEnabled)
+    {
         evolvePopulation();
     }
+    else
+    {
+        // Evaluation only: the same population drives again, nothing is saved
+        LOG_INFO("Generation " << result.generation << " evaluated: best " << LogFixed(result.bestFitness, 0) << ", avg "
+                               << LogFixed(result.averageFitness, 0) << ", " << result.finishedCars << " finished");
+        resetAICars();
+    }
+
+    ++evaluatedGenerations;
+    if (generationCallback)
+    {
+        generationCallback(result);
+    }
 }
 
-bool Game::allAICarsFinished() const
+GenerationResult Game::getGenerationResult() const
 {
-    if (!aiPopulation)
-        return true;
+    GenerationResult result;
+    result.generation = aiPopulation->getGeneration();
+    result.bestFitness = 0.0;
+    result.averageFitness = 0.0;
+    result.bestCheckpoints = 0;
+    result.bestTimeAlive = 0.0f;
+    result.bestLapTime = bestLapTime;
+    result.finishedCars = 0;
+    result.speciesCount = static_cast<int>(aiPopulation->getSpeciesCount());
+    result.generationTime = generationTime;
 
     const auto &controllers = aiPopulation->getControllers();
-    for (const auto &controller : controllers)
+    for (size_t i = 0; i < controllers.size(); ++i)
     {
-        if (controller->isCarAlive())
-            return false;
+        double fitness = controllers[i]->getFitness();
+        result.averageFitness += fitness;
+        if (i == 0 || fitness > result.bestFitness)
+        {
+            result.bestFitness = fitness;
+            result.bestCheckpoints = controllers[i]->getCheckpointsHit();
+            result.bestTimeAlive = controllers[i]->getTimeAlive();
+        }
+        if (checkpointHandler->isRaceFinished(i))
+        {
+            result.finishedCars++;
+        }
     }
-    return true;
+    if (!controllers.empty())
+    {
+        result.averageFitness /= controllers.size();
+    }
+    return result;
 }
 
-bool Game::checkCarStuck(const Car &car) const
+void Game::stepAICar(size_t carIndex, float deltaTime)
 {
-    // Check if car hasn't moved much in the last few seconds
-    // This is a simple implementation - could be improved
-    static std::unordered_map<const Car *, sf::Vector2f> lastPositions;
-    static std::unordered_map<const Car *, float> stuckTimers;
-    static int frameCounter = 0;
+    auto &car = aiCars[carIndex];
+    auto &controller = aiPopulation->getControllers()[carIndex];
+
+    // Store previous position for checkpoint detection
+    sf::Vector2f previousPosition = sf::Vector2f(car->getX(), car->getY());
+
+    // Update car physics
+    car->update(deltaTime);
+
+    // Update ray sensors
+    car->updateRaySensors(track->getInnerEdgePoints(), track->getOuterEdgePoints());
 
-    // Only check every 10 frames for better performance
-    frameCounter++;
-    if (frameCounter % 10 != 0)
+    // Handle collisions with track edges (bounce back instead of instant kill)
+    car->handleCollision(track->getInnerEdgePoints(), track->getOuterEdgePoints(),
+                         track->getInnerEdgeGrid(), track->getOuterEdgeGrid());
+
+    // Check checkpoint progress (the race clock is the generation time at the end of this step)
+    sf::Vector2f currentPosition = sf::Vector2f(car->getX(), car->getY());
+    if (controller->isCarAlive())
     {
-        return false;
+        int lapsBefore = checkpointHandler->getLapsCompleted(carIndex);
+        checkpointHandler->checkCarPositionWithLine(carIndex, previousPosition, currentPosition, generationTime + deltaTime, deltaTime);
+
+        // Update checkpoint count and lap stats for this controller
+        int lapsCompleted = checkpointHandler->getLapsCompleted(carIndex);
+        controller->setCheckpointsHit(checkpointHandler->getTotalHitCheckpoints(carIndex));
+        controller->setLapStats(lapsCompleted, checkpointHandler->getTotalLapTime(carIndex));
+
+        if (lapsCompleted > lapsBefore)
+        {
+            // The best lap of the generation is picked after all cars were stepped
+            completedLapTimes[carIndex] = checkpointHandler->getLapTime(carIndex, lapsCompleted - 1);
+        }
     }
 
-    sf::Vector2f currentPos(car.getX(), car.getY());
+    // Get sensor data
+    std::vector<float> rayDistances = car->getRayDistances();
+
+    // Control the car with AI
+    controller->controlCar(*car, rayDistances, config.sensorRange);
+    replayRecorder->recordControls(carIndex, *car, controller->isCarAlive());
+
+    // Update fitness
+    controller->updateFitness(deltaTime);
 
-    // Initialize if first time seeing this car
-    if (lastPositions.find(&car) == lastPositions.end())
+    // Cars that finished every lap stop scoring so their lap pace is kept
+    if (controller->isCarAlive() && checkpointHandler->isRaceFinished(carIndex))
     {
-        lastPositions[&car] = currentPos;
-        stuckTimers[&car] = 0.0f;
-        return false;
+        controller->markFinished();
     }
 
-    sf::Vector2f lastPos = lastPositions[&car];
-    float dx = currentPos.x - lastPos.x;
-    float dy = currentPos.y - lastPos.y;
-    float distance = std::sqrt(dx * dx + dy * dy);
-
-    if (distance < 5.0f) // Less than 5 pixels movement
+    // Check if car is stuck (but don't check for crashes again since we already did)
+    if (controller->isCarAlive() && checkCarStuck(carIndex, *car, deltaTime))
     {
-        stuckTimers[&car] += this->deltaTime;
-        if (stuckTimers[&car] > 3.0f) // Stuck for 3 seconds
-        {
-            stuckTimers[&car] = 0.0f;
-            lastPositions[&car] = currentPos;
-            return true;
-        }
+        controller->kill();
+        LOG_DEBUG("Car " << carIndex << " killed for being stuck");
     }
-    else
+}
+
+bool Game::allAICarsFinished() const
+{
+    if (!aiPopulation)
+        return true;
+
+    const auto &controllers = aiPopulation->getControllers();
+    for (const auto &controller : controllers)
     {
-        stuckTimers[&car] = 0.0f;
+        if (controller->isCarAlive())
+            return false;
     }
+    return true;
+}
 
-    lastPositions[&car] = currentPos;
-    return false;
+bool Game::checkCarStuck(size_t carIndex, const Car &car, float deltaTime)
+{
+    // Stuck state lives in a dense per-car array, updated once per simulation step
+    return stuckDetector->update(carIndex, sf::Vector2f(car.getX(), car.getY()), deltaTime);
 }
 
 bool Game::checkCarCrashed(const Car &car) const
@@ -665,36 +1721,41 @@ bool Game::checkCarCrashed(const Car &car) const
     return false;
 }
 
-void Game::drawAIStats()
+void Game::drawAIStats(const SimulationSnapshot &snapshot)
 {
-    if (!performanceFontLoaded || !fpsText || !aiPopulation)
+    // Only rebuild the text when one of the shown values changes
+    const std::array<int, 13> stats = {
+        snapshot.aiLearningEnabled ? 1 : 0,
+        snapshot.aiLearningPaused ? 1 : 0,
+        snapshot.generation,
+        static_cast<int>(snapshot.bestFitness),
+        snapshot.speciesCount,
+        static_cast<int>(snapshot.generationTime),
+        static_cast<int>(snapshot.maxGenerationTime),
+        snapshot.raceLaps,
+        snapshot.carCollisionsEnabled ? 1 : 0,
+        snapshot.fastForward ? 1 : 0,
+        static_cast<int>(snapshot.cars.size()),
+        static_cast<int>(carViewMode.load()),
+        static_cast<int>(drawnCarCount)};
+    if (stats == shownAIStats)
         return;
-
-    try
-    {
-        // Create AI stats text
-        sf::Text aiStatsText(performanceFont, "", 16);
-        aiStatsText.setFillColor(sf::Color::Green);
-        aiStatsText.setOutlineColor(sf::Color::Black);
-        aiStatsText.setOutlineThickness(1.0f);
-        aiStatsText.setPosition(sf::Vector2f(10.0f, 10.0f));
-
-        std::string aiStats = "=== AI LEARNING SIMULATION ===\n";
-        aiStats += "Status: " + std::string(aiLearningEnabled ? "ACTIVE" : "STOPPED") + "\n";
-        aiStats += "Paused: " + std::string(aiLearningPaused ? "YES" : "NO") + "\n";
-        aiStats += "Generation: " + std::to_string(currentGeneration) + "\n";
-        aiStats += "Best Fitness: " + std::to_string(static_cast<int>(aiPopulation->getBestFitness())) + "\n";
-        aiStats += "Species Count: " + std::to_string(aiPopulation->getSpeciesCount()) + "\n";
-        aiStats += "Generation Time: " + std::to_string(static_cast<int>(generationTime)) + "/20s\n";
-        aiStats += "Active Cars: " + std::to_string(aiCars.size()) + "\n";
-
-        aiStatsText.setString(aiStats);
-        window->draw(aiStatsText);
-    }
-    catch (...)
-    {
-        // Silently fail if text rendering fails
-    }
+    shownAIStats = stats;
+
+    std::string aiStats = "=== AI LEARNING SIMULATION ===\n";
+    aiStats += "Status: " + std::string(snapshot.aiLearningEnabled ? "ACTIVE" : "STOPPED") + "\n";
+    aiStats += "Paused: " + std::string(snapshot.aiLearningPaused ? "YES" : "NO") + "\n";
+    aiStats += "Generation: " + std::to_string(snapshot.generation) + "\n";
+    aiStats += "Best Fitness: " + std::to_string(stats[3]) + "\n";
+    aiStats += "Species Count: " + std::to_string(snapshot.speciesCount) + "\n";
+    aiStats += "Generation Time: " + std::to_string(stats[5]) + "/" + std::to_string(stats[6]) + "s\n";
+    aiStats += "Race Laps: " + std::to_string(snapshot.raceLaps) + "\n";
+    aiStats += "Car Collisions: " + std::string(snapshot.carCollisionsEnabled ? "On" : "Off") + "\n";
+    aiStats += "Fast Forward: " + std::string(snapshot.fastForward ? "On" : "Off") + "\n";
+    aiStats += "Active Cars: " + std::to_string(snapshot.cars.size()) + "\n";
+    aiStats += "View: " + CarViewFilter::getModeName(carViewMode) + " (" + std::to_string(drawnCarCount) + " drawn)\n";
+
+    hud->setText(aiStatsLabel, aiStats);
 }
 
 void Game::updateNetworkVisualization()
@@ -707,19 +1768,22 @@ void Game::updateNetworkVisualization()
     if (!controllers.empty())
     {
         // Find the best controller
-        auto bestController = controllers[0];
-        double bestFitness = bestController->getFitness();
+        size_t bestIndex = 0;
+        double bestFitness = controllers[0]->getFitness();
 
-        for (const auto &controller : controllers)
+        for (size_t i = 1; i < controllers.size(); ++i)
         {
-            if (controller->getFitness() > bestFitness)
+            if (controllers[i]->getFitness() > bestFitness)
             {
-                bestFitness = controller->getFitness();
-                bestController = controller;
+                bestFitness = controllers[i]->getFitness();
+                bestIndex = i;
             }
         }
 
-        // Update network visualization with the best brain
-        networkRenderHandler->setNetwork(&bestController->getBrain());
+        // Update network visualization with the best brain (the render thread draws it)
+        // Only the parts of the genome that differ from the shown one are updated
+        std::lock_guard<std::recursive_mutex> lock(uiMutex);
+        networkRenderHandler->setNetwork(&controllers[bestIndex]->getBrain());
+        networkCarIndex = static_cast<int>(bestIndex);
     }
 }
\ No newline at end of file
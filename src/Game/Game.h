@@ -1,11 +1,19 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include "../Recording/FrameRecorder.h"
+#include "GameConfig.h"
+#include <array>
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <vector>
 #include <string>
 
 // Forward declarations
 class Background;
+class StaticLayer;
 class Track;
 class Car;
 class TimerLogic;
@@ -16,13 +24,52 @@ class UIManager;
 class NetworkRenderHandler;
 class Population;
 class AIController;
+class StuckDetector;
+class CarCollision;
+class FleetRenderer;
+class HudRenderer;
+class CarViewFilter;
+class Camera;
+class SensorRenderer;
+class CheckpointWriter;
+class PopulationArchiveWriter;
+class TelemetryWriter;
+class ReplayRecorder;
+class ReplayPlayer;
+class GhostLap;
+struct ReplayData;
+struct TrainingState;
+enum class CarViewMode;
+struct SimulationSnapshot;
+template <typename T>
+class TripleBuffer;
+class WorkerPool;
+
+// Results of one evaluated generation, reported to batch runs (see BatchRunner)
+struct GenerationResult
+{
+    int generation;
+    double bestFitness;
+    double averageFitness;
+    int bestCheckpoints;  // Checkpoints of the best car
+    float bestTimeAlive;  // Seconds the best car drove
+    float bestLapTime;    // Best lap of the generation (0 if no car completed one)
+    int finishedCars;     // Cars that drove every lap
+    int speciesCount;
+    float generationTime; // Simulated seconds
+};
 
 class Game
 {
 private:
+    GameConfig config; // Startup settings (see Config/racecar.ini)
     std::unique_ptr<sf::RenderWindow> window;
     std::unique_ptr<Background> background;
     std::unique_ptr<Track> track;
+    std::unique_ptr<StaticLayer> staticLayer; // Cached background + track composite
+    std::unique_ptr<Camera> camera;           // World view (zoom, pan, follow), shared by input and rendering
+    bool panning;                             // Mouse drag in progress (main thread)
+    sf::Vector2i lastPanPixel;
     std::unique_ptr<TimerLogic> timerLogic;
     std::unique_ptr<TimerRenderer> timerRenderer;
     std::unique_ptr<CheckpointHandler> checkpointHandler;
@@ -32,6 +79,17 @@ private:
     // AI Population management
     std::unique_ptr<Population> aiPopulation;
     std::vector<std::unique_ptr<Car>> aiCars;
+    std::unique_ptr<StuckDetector> stuckDetector; // Per-car stuck state, indexed like aiCars
+    std::unique_ptr<WorkerPool> workerPool;       // Steps the cars in parallel
+    std::vector<float> completedLapTimes;         // Lap a car completed in the current tick (0 if none), indexed like aiCars
+    std::unique_ptr<CarCollision> carCollision;   // Car-to-car collisions (race evaluation)
+    bool carCollisionsEnabled;
+    std::unique_ptr<FleetRenderer> fleetRenderer; // Draws all AI cars in one batch
+    std::unique_ptr<CarViewFilter> carViewFilter; // Picks which cars are drawn (render thread)
+    std::atomic<CarViewMode> carViewMode;         // Set from input, read by the renderer
+    std::size_t drawnCarCount;                    // Cars drawn in the last frame (after culling)
+    std::unique_ptr<SensorRenderer> sensorRenderer; // Ray sensor debug layer
+    std::atomic<bool> showSensors;                  // Sensor distances are only published while shown
     bool aiLearningEnabled;
     bool aiLearningPaused;
     float generationTime;
@@ -39,24 +97,104 @@ private:
     int currentGeneration;
     int bestFitnessGeneration;
 
-    // Performance monitoring
+    // Race mode (number of laps each car has to drive per generation)
+    int raceLaps;
+    float bestLapTime; // Best lap of the current generation (0 if none yet)
+
+    // Vehicle class from Config/vehicles.ini used for every AI car
+    std::string vehicleClass;
+
+    // Fixed step simulation (the renderer only ever sees published snapshots)
+    float simulationStep;           // Length of one simulation tick in seconds
+    float simulationAccumulator;    // Real time that hasn't been simulated yet
+    unsigned long long simulationTick;
+    bool fastForward;               // Simulate as fast as possible instead of in real time
+    int fastForwardTicks;           // Ticks per update while fast forwarding
+    sf::Clock simulationRateClock;
+    int simulationRateTicks;
+    float simulationRate;           // Measured ticks per second
+    std::unique_ptr<TripleBuffer<SimulationSnapshot>> snapshots;
+
+    // Render thread (events and simulation stay on the main thread)
+    bool renderThreadEnabled;
+    std::atomic<bool> closeRequested;
+    std::recursive_mutex uiMutex; // Guards the UI manager and network visualization, used by both threads
+    std::atomic<bool> resizePending;
+    std::atomic<unsigned int> pendingWidth;
+    std::atomic<unsigned int> pendingHeight;
+
+    // Performance monitoring (render thread)
     sf::Clock performanceClock;
     sf::Clock fpsClock;
-    float deltaTime;
+    sf::Clock renderClock;
+    float deltaTime;       // Real time of the last main loop iteration
+    float renderFrameTime; // Real time of the last rendered frame
     float fps;
     int frameCount;
-    sf::Font performanceFont;
-    sf::Text* fpsText;
-    bool performanceFontLoaded;
+
+    // HUD text (batched, labels are only laid out again when their values change)
+    std::unique_ptr<HudRenderer> hud;
+    int fpsLabel;
+    int aiStatsLabel;
+    std::array<int, 5> shownPerformanceStats; // Values currently shown in the fps label (-1 before the first frame)
+    std::array<int, 13> shownAIStats;         // Values currently shown in the AI stats label
     
+    // Off-screen recording of simulation ticks: the simulation selects the ticks and copies their snapshots,
+    // the render thread draws them (a headless game draws them itself). Input only requests start/stop.
+    std::unique_ptr<FrameRecorder> frameRecorder;
+    RecordingSettings recordingSettings; // Guarded by uiMutex
+    std::atomic<bool> recordingRequested;
+    std::mutex captureMutex;                       // Guards the two lists below
+    std::vector<SimulationSnapshot> capturedTicks; // Selected ticks the render thread hasn't drawn yet
+    std::vector<SimulationSnapshot> spareCaptures; // Drawn snapshots, reused so capturing doesn't allocate
+    std::vector<SimulationSnapshot> drawnCaptures; // Render thread only
+
+    // Training checkpoints (written in the background, see TrainingCheckpoint for the format)
+    std::unique_ptr<CheckpointWriter> checkpointWriter;
+    std::string checkpointPath;
+    int checkpointInterval; // Save automatically every N generations (0 disables)
+    std::unique_ptr<PopulationArchiveWriter> populationArchive; // Every generation, for resuming and analysis
+    std::string archivePath;                                    // Without the .arc/.idx extension
+    std::string championPath;                                   // Frozen best network (see FrozenNetwork)
+    std::unique_ptr<TelemetryWriter> telemetryWriter;           // Per car and per species rows of every generation
+    std::string telemetryPath;                                  // Without the extension
+
+    // Replays: the inputs of every generation are recorded, the champion of each new best run is kept (see ReplayFile)
+    std::unique_ptr<ReplayRecorder> replayRecorder;
+    std::unique_ptr<ReplayPlayer> replayPlayer; // Drives the recorded cars instead of the population while playing
+    std::unique_ptr<CheckpointWriter> replayWriter;
+    std::string replayDirectory;  // One <run>_generation_<n>.rcrp per best run
+    std::string replayRunName;    // Starts the names of this run's replays (see ReplayFile::makeRunName)
+    std::string lastReplayPath;   // Newest replay saved by this run
+    std::set<std::string> savedReplayPaths; // Every replay saved by this run, some may still wait for the writer
+    double replayRecordFitness;   // Fitness of the newest replay, a better generation gets its own
+    std::shared_ptr<const std::vector<GhostLap>> ghosts; // Shown ghosts (replaced, never changed, the snapshots share it)
+    std::string ghostRunName;     // Run the shown ghosts were recorded in
+    std::size_t maxGhosts;
+
+    // Track file loaded at start, written with baked geometry when missing (see TrackFile)
+    std::string trackPath;
+
     // Network visualization
     std::unique_ptr<NetworkRenderHandler> networkRenderHandler;
+    int networkCarIndex; // Car whose brain is shown (its activations go into the snapshot), -1 if none
+
+    // Batch runs: limits that end run() and the generations reported so far
+    int generationLimit;          // Evaluated generations before run() returns, 0 for no limit
+    float timeLimit;              // Seconds of real time before run() returns, 0 for no limit
+    bool timeLimitReached;
+    bool evolutionEnabled;        // Off: every generation evaluates the same population again
+    bool closeWhenIdle;           // End run() once there is nothing left to simulate (replay over, learning stopped)
+    int evaluatedGenerations;
+    std::function<void(const GenerationResult &)> generationCallback;
+    sf::Clock runClock;
 
     // Game state
     sf::Clock deltaClock;
 
 public:
-    Game(unsigned int width, unsigned int height);
+    // The window size in the config has to be resolved (non-zero) unless the game is headless
+    explicit Game(const GameConfig &gameConfig);
     ~Game();
 
     void run();
@@ -74,20 +212,87 @@ public:
     void pauseAILearning();
     void stopAILearning();
     void saveAITrainingData();
-    void loadAITrainingData();
+    bool loadAITrainingData();
+    bool resumeFromArchive(int generation = -1); // Continue after an archived generation (-1 for the newest)
+    bool exportChampion();                       // Write the best network as an inference-only file
+    bool playReplay(const std::string &path);    // Show a recorded run instead of the population until it ends
+    void stopReplay();
+    bool isReplayPlaying() const;
+    bool showGhosts();                           // Ghosts of the newest recorded best runs next to the live cars
+    void hideGhosts();
+    bool areGhostsShown() const { return ghosts != nullptr; }
     void evolvePopulation();
     void resetAICars();
     void updateAICars(float deltaTime);
+    void stepAICar(size_t carIndex, float deltaTime); // One car's part of a tick (called from the worker threads)
     float calculateMaxGenerationTime() const;
     bool allAICarsFinished() const;
-    bool checkCarStuck(const Car& car) const;
+    bool checkCarStuck(size_t carIndex, const Car& car, float deltaTime);
     bool checkCarCrashed(const Car& car) const;
 
+    // Race mode
+    void setRaceLaps(int laps);
+    int getRaceLaps() const { return raceLaps; }
+
+    // Car-to-car collisions (off for training, cars drive through each other)
+    void setCarCollisionsEnabled(bool enabled) { carCollisionsEnabled = enabled; }
+    bool areCarCollisionsEnabled() const { return carCollisionsEnabled; }
+
+    // Rendering on a separate thread (must be set before run())
+    void setRenderThreadEnabled(bool enabled) { renderThreadEnabled = enabled; }
+    bool isRenderThreadEnabled() const { return renderThreadEnabled; }
+
+    // Which AI cars are drawn (all, top fitness, random sample, best only)
+    void setCarViewMode(CarViewMode mode) { carViewMode = mode; }
+    CarViewMode getCarViewMode() const { return carViewMode; }
+
+    // Ray sensor visualization for the drawn cars
+    void setShowSensors(bool show) { showSensors = show; }
+    bool isShowingSensors() const { return showSensors; }
+
+    // Record every frameSkip-th simulation tick to disk (PNG sequence or raw RGBA), also headless (see recording.*)
+    void startRecording(const RecordingSettings &settings);
+    void startRecording();
+    void stopRecording();
+    bool isRecording() const { return recordingRequested; }
+
+    // Simulation speed
+    void setFastForward(bool enabled) { fastForward = enabled; }
+    bool isFastForward() const { return fastForward; }
+    bool isHeadless() const { return config.headless; }
+    unsigned long long getSimulationTick() const { return simulationTick; }
+    std::size_t getSimulationThreadCount() const;
+
+    // Batch runs (set before run()); the callback is called on the simulation thread after every generation
+    void setGenerationLimit(int generations) { generationLimit = generations; }
+    void setTimeLimit(float seconds) { timeLimit = seconds; }
+    void setEvolutionEnabled(bool enabled) { evolutionEnabled = enabled; }
+    void setCloseWhenIdle(bool enabled) { closeWhenIdle = enabled; }
+    void setGenerationCallback(std::function<void(const GenerationResult &)> callback) { generationCallback = std::move(callback); }
+    bool wasTimeLimitReached() const { return timeLimitReached; }
+    int getEvaluatedGenerations() const { return evaluatedGenerations; }
+
 private:
+    void runHeadless();
+    bool checkRunLimits();
+    void endGeneration();
+    GenerationResult getGenerationResult() const;
+    void stepSimulation();
+    void publishSnapshot();
+    void fillSnapshot(SimulationSnapshot &snapshot);
+    void renderLoop();
+    void renderScene(sf::RenderTarget &target, const SimulationSnapshot &snapshot, bool useStaticLayer);
+    void updateRecording(sf::Vector2u frameSize); // Start or stop the recorder as requested (on the thread that renders)
+    void captureTick();                           // Simulation thread, after every tick
+    void drawCapturedTicks();                     // Render thread
+    void applyPendingResize();
     void updatePerformanceStats();
-    void drawPerformanceStats();
-    void drawAIStats();
+    void drawPerformanceStats(const SimulationSnapshot &snapshot, sf::Vector2u targetSize);
+    void drawAIStats(const SimulationSnapshot &snapshot);
     void initializeAIPopulation();
     void createAICars();
     void updateNetworkVisualization();
+    TrainingState getTrainingState() const;
+    void restartLoadedGeneration(const TrainingState &state);
+    bool addGhost(const ReplayData &replay, std::vector<GhostLap> &ghostLaps) const;
 }; 
\ No newline at end of file
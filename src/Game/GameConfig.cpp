@@ -0,0 +1,367 @@
+#include "GameConfig.h"
+#include "../Logging/Logger.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+
+namespace
+{
+    std::string trim(const std::string &text)
+    {
+        size_t first = text.find_first_not_of(" \t\r");
+        size_t last = text.find_last_not_of(" \t\r");
+        return first == std::string::npos ? std::string() : text.substr(first, last - first + 1);
+    }
+
+    // The whole value has to be a number, "12abc" is rejected
+    bool parseInt(const std::string &text, int &result, int minimum)
+    {
+        char *end = nullptr;
+        errno = 0;
+        long value = std::strtol(text.c_str(), &end, 10);
+        if (text.empty() || *end != '\0' || errno != 0 || value < minimum || value > 1000000000L)
+            return false;
+        result = static_cast<int>(value);
+        return true;
+    }
+
+    bool parseFloat(const std::string &text, float &result)
+    {
+        char *end = nullptr;
+        float value = std::strtof(text.c_str(), &end);
+        if (text.empty() || *end != '\0' || !std::isfinite(value))
+            return false;
+        result = value;
+        return true;
+    }
+
+    bool parseBool(const std::string &text, bool &result)
+    {
+        if (text == "true" || text == "on" || text == "yes" || text == "1")
+            result = true;
+        else if (text == "false" || text == "off" || text == "no" || text == "0")
+            result = false;
+        else
+            return false;
+        return true;
+    }
+
+    // Comma separated list
+    std::vector<std::string> split(const std::string &text)
+    {
+        std::vector<std::string> items;
+        size_t start = 0;
+        while (start <= text.size())
+        {
+            size_t comma = text.find(',', start);
+            if (comma == std::string::npos)
+                comma = text.size();
+            items.push_back(trim(text.substr(start, comma - start)));
+            start = comma + 1;
+        }
+        return items;
+    }
+}
+
+GameConfig::GameConfig()
+    : windowWidth(0), windowHeight(0), renderThread(true), headless(false), fontPath("../../Fonts/ARIAL.TTF"),
+      tickRate(60.0f), fastForwardTicks(20), threadCount(0), vehicleClass("default"), raceLaps(1), carCollisions(false),
+      seed(0), populationSize(25), hiddenNodes(-1),
+      lapTimeSchedule{{0, 5.0f}, {25, 10.0f}, {50, 15.0f}, {75, 20.0f}}, checkpointInterval(10),
+      sensorAngles{0.0f, 45.0f, 90.0f, 135.0f, 180.0f, 225.0f, 270.0f, 315.0f}, sensorRange(150.0f),
+      recordFrames(false), recordingDirectory("../../Recordings"), recordingRaw(false), recordingFrameSkip(2),
+      recordingMaxQueuedFrames(8), recordingWidth(1280), recordingHeight(720),
+      vehiclesPath("../../Config/vehicles.ini"), trackPath("../../Tracks/default.rctrack"),
+      checkpointPath("../../Saves/training.ckpt"), archivePath("../../Saves/population"),
+      championPath("../../Saves/champion.rcnet"), telemetryPath("../../Saves/telemetry"), telemetryCsv(false),
+      replayDirectory("../../Replays")
+{
+}
+
+float GameConfig::getLapTime(int generation) const
+{
+    float lapTime = lapTimeSchedule.empty() ? 20.0f : lapTimeSchedule.front().lapTime;
+    for (const auto &step : lapTimeSchedule)
+    {
+        if (generation >= step.firstGeneration)
+            lapTime = step.lapTime;
+    }
+    return lapTime;
+}
+
+bool GameConfig::loadFromFile(const std::string &filename)
+{
+    std::ifstream file(filename);
+    if (!file.is_open())
+    {
+        LOG_INFO("Config " << filename << " not found, using the defaults");
+        return false;
+    }
+
+    std::string section;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        line = trim(line.substr(0, line.find_first_of(";#")));
+        if (line.empty())
+            continue;
+
+        // Section header
+        if (line.front() == '[' && line.back() == ']')
+        {
+            section = trim(line.substr(1, line.size() - 2));
+            continue;
+        }
+
+        size_t equals = line.find('=');
+        if (equals == std::string::npos)
+            continue;
+
+        set(section + "." + trim(line.substr(0, equals)), trim(line.substr(equals + 1)));
+    }
+
+    return true;
+}
+
+bool GameConfig::applyOverride(const std::string &assignment)
+{
+    size_t equals = assignment.find('=');
+    if (equals == std::string::npos)
+    {
+        LOG_WARNING("Expected section.key=value, got '" << assignment << "'");
+        return false;
+    }
+    return set(trim(assignment.substr(0, equals)), trim(assignment.substr(equals + 1)));
+}
+
+bool GameConfig::set(const std::string &key, const std::string &value)
+{
+    bool valid = false;
+    int number = 0;
+
+    if (key == "window.width" || key == "window.height")
+    {
+        valid = parseInt(value, number, 0);
+        if (valid)
+            (key == "window.width" ? windowWidth : windowHeight) = static_cast<unsigned int>(number);
+    }
+    else if (key == "window.render")
+    {
+        valid = value == "threaded" || value == "single" || value == "headless";
+        if (valid)
+        {
+            renderThread = value == "threaded";
+            headless = value == "headless";
+        }
+    }
+    else if (key == "window.font")
+    {
+        valid = !value.empty();
+        if (valid)
+            fontPath = value;
+    }
+    else if (key == "simulation.tickRate")
+    {
+        float rate = 0.0f;
+        valid = parseFloat(value, rate) && rate >= 1.0f && rate <= 1000.0f;
+        if (valid)
+            tickRate = rate;
+    }
+    else if (key == "simulation.fastForwardTicks")
+    {
+        valid = parseInt(value, fastForwardTicks, 1);
+    }
+    else if (key == "simulation.threads")
+    {
+        valid = parseInt(value, threadCount, 0);
+    }
+    else if (key == "simulation.vehicleClass")
+    {
+        valid = !value.empty();
+        if (valid)
+            vehicleClass = value;
+    }
+    else if (key == "simulation.raceLaps")
+    {
+        valid = parseInt(value, raceLaps, 1);
+    }
+    else if (key == "simulation.carCollisions")
+    {
+        valid = parseBool(value, carCollisions);
+    }
+    else if (key == "simulation.seed")
+    {
+        valid = parseInt(value, number, 0);
+        if (valid)
+            seed = static_cast<unsigned int>(number);
+    }
+    else if (key == "population.size")
+    {
+        valid = parseInt(value, populationSize, 2);
+    }
+    else if (key == "population.hiddenNodes")
+    {
+        valid = parseInt(value, hiddenNodes, -1);
+    }
+    else if (key == "generation.lapTimeSchedule")
+    {
+        // "generation:seconds, ..." e.g. 0:5, 25:10
+        std::vector<LapTimeStep> schedule;
+        valid = true;
+        for (const std::string &item : split(value))
+        {
+            size_t colon = item.find(':');
+            LapTimeStep step;
+            if (colon == std::string::npos || !parseInt(trim(item.substr(0, colon)), step.firstGeneration, 0) ||
+                !parseFloat(trim(item.substr(colon + 1)), step.lapTime) || step.lapTime <= 0.0f)
+            {
+                valid = false;
+                break;
+            }
+            schedule.push_back(step);
+        }
+        if (valid)
+        {
+            std::sort(schedule.begin(), schedule.end(), [](const LapTimeStep &a, const LapTimeStep &b)
+                      { return a.firstGeneration < b.firstGeneration; });
+            lapTimeSchedule = std::move(schedule);
+        }
+    }
+    else if (key == "generation.checkpointInterval")
+    {
+        valid = parseInt(value, checkpointInterval, 0);
+    }
+    else if (key == "sensors.angles")
+    {
+        std::vector<float> angles;
+        valid = true;
+        for (const std::string &item : split(value))
+        {
+            float angle = 0.0f;
+            if (!parseFloat(item, angle))
+            {
+                valid = false;
+                break;
+            }
+            angles.push_back(angle);
+        }
+        if (valid)
+            sensorAngles = std::move(angles);
+    }
+    else if (key == "sensors.range")
+    {
+        float range = 0.0f;
+        valid = parseFloat(value, range) && range > 0.0f;
+        if (valid)
+            sensorRange = range;
+    }
+    else if (key == "recording.enabled")
+    {
+        valid = parseBool(value, recordFrames);
+    }
+    else if (key == "recording.directory")
+    {
+        valid = !value.empty();
+        if (valid)
+            recordingDirectory = value;
+    }
+    else if (key == "recording.format")
+    {
+        valid = value == "png" || value == "rgba";
+        if (valid)
+            recordingRaw = value == "rgba";
+    }
+    else if (key == "recording.frameSkip")
+    {
+        valid = parseInt(value, recordingFrameSkip, 1);
+    }
+    else if (key == "recording.maxQueuedFrames")
+    {
+        valid = parseInt(value, recordingMaxQueuedFrames, 1);
+    }
+    else if (key == "recording.width" || key == "recording.height")
+    {
+        valid = parseInt(value, number, 1);
+        if (valid)
+            (key == "recording.width" ? recordingWidth : recordingHeight) = static_cast<unsigned int>(number);
+    }
+    else if (key == "files.telemetryFormat")
+    {
+        valid = value == "binary" || value == "csv";
+        if (valid)
+            telemetryCsv = value == "csv";
+    }
+    else if (key.compare(0, 6, "files.") == 0)
+    {
+        // Outputs can be turned off with an empty path, the inputs always need one
+        struct FileKey
+        {
+            const char *name;
+            std::string *path;
+            bool optional;
+        };
+        const FileKey files[] = {{"vehicles", &vehiclesPath, false}, {"track", &trackPath, false},
+                                 {"checkpoint", &checkpointPath, false}, {"champion", &championPath, false},
+                                 {"archive", &archivePath, true}, {"telemetry", &telemetryPath, true},
+                                 {"replays", &replayDirectory, true}};
+        const FileKey *file = nullptr;
+        for (const FileKey &candidate : files)
+        {
+            if (key.compare(6, std::string::npos, candidate.name) == 0)
+                file = &candidate;
+        }
+        if (!file)
+        {
+            LOG_WARNING("Unknown config key '" << key << "'");
+            return false;
+        }
+        valid = file->optional || !value.empty();
+        if (valid)
+            *file->path = value;
+    }
+    else
+    {
+        LOG_WARNING("Unknown config key '" << key << "'");
+        return false;
+    }
+
+    if (!valid)
+    {
+        LOG_WARNING("Invalid value '" << value << "' for " << key);
+    }
+    return valid;
+}
+
+const char *GameConfig::getKeyHelp()
+{
+    return "  window.width, window.height   Window size in pixels (0 fits the desktop)\n"
+           "  window.render                 threaded, single (draw on the simulation thread) or headless (no window)\n"
+           "  window.font                   Font file for the HUD and buttons\n"
+           "  simulation.tickRate           Fixed simulation ticks per second\n"
+           "  simulation.fastForwardTicks   Ticks per update while fast forwarding\n"
+           "  simulation.threads            Threads stepping the cars (0 = all hardware threads)\n"
+           "  simulation.vehicleClass       Vehicle class from Config/vehicles.ini\n"
+           "  simulation.raceLaps           Laps per generation\n"
+           "  simulation.carCollisions      Car-to-car collisions (true/false)\n"
+           "  simulation.seed               Seed of evolution's random numbers (0 = new every run)\n"
+           "  population.size               Cars per generation\n"
+           "  population.hiddenNodes        Hidden nodes of the first networks (-1 = 0 to 3 at random)\n"
+           "  generation.lapTimeSchedule    Seconds per lap from a generation on, e.g. 0:5, 25:10\n"
+           "  generation.checkpointInterval Save a checkpoint every N generations (0 = never)\n"
+           "  sensors.angles                Ray directions in degrees, one network input each\n"
+           "  sensors.range                 Ray length in pixels\n"
+           "  recording.enabled             Record frames from the start (P toggles recording in the window)\n"
+           "  recording.directory           A run_<date>_<time> folder per recording is created in here\n"
+           "  recording.format              png (one file per frame) or rgba (all frames in one raw file)\n"
+           "  recording.frameSkip           Record every Nth simulation tick\n"
+           "  recording.maxQueuedFrames     Frames waiting to be drawn or written (a window drops frames beyond this)\n"
+           "  recording.width, .height      Frame size of headless recordings (windowed ones use the window size)\n"
+           "  files.vehicles, files.track   Vehicle classes and the track file\n"
+           "  files.checkpoint              Training checkpoint (saved, loaded and resumed)\n"
+           "  files.champion                Exported champion network\n"
+           "  files.archive, files.telemetry, files.replays\n"
+           "                                Generation archive, telemetry and replay directory (empty = off)\n"
+           "  files.telemetryFormat         binary (one .rctl file) or csv (_cars.csv and _species.csv)\n";
+}
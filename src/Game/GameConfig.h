@@ -0,0 +1,82 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Lap time allowed per generation from a generation on (the generation time is this times the race laps)
+struct LapTimeStep
+{
+    int firstGeneration;
+    float lapTime; // Seconds
+};
+
+// Startup settings from Config/racecar.ini, every key can be overridden on the command line
+// Keys are written "section.key" (e.g. population.size), values that are missing keep the defaults below.
+struct GameConfig
+{
+    // [window]
+    unsigned int windowWidth;  // 0 fits the desktop (up to 2560x1440)
+    unsigned int windowHeight;
+    bool renderThread;         // render = threaded (draw on a second thread) or single
+    bool headless;             // render = headless: no window, the simulation runs as fast as it can
+    std::string fontPath;
+
+    // [simulation]
+    float tickRate;       // Fixed simulation ticks per second
+    int fastForwardTicks; // Ticks per update while fast forwarding
+    int threadCount;      // Worker threads stepping the cars, 0 uses every hardware thread
+    std::string vehicleClass;
+    int raceLaps;
+    bool carCollisions;
+    unsigned int seed; // Evolution's random sequence, 0 picks a new one every run
+
+    // [population]
+    int populationSize;
+    int hiddenNodes; // Hidden nodes of the first networks, -1 picks 0-3 per network
+
+    // [generation]
+    std::vector<LapTimeStep> lapTimeSchedule; // Sorted by generation
+    int checkpointInterval;                   // Save a checkpoint every N generations (0 disables)
+
+    // [sensors]
+    std::vector<float> sensorAngles; // Degrees relative to the car's heading, one network input each
+    float sensorRange;
+
+    // [recording] frames of the simulation for a video (see FrameRecorder)
+    bool recordFrames;              // enabled: record from the start (P toggles it in the window)
+    std::string recordingDirectory; // A run_<date>_<time> folder per recording is created in here
+    bool recordingRaw;              // format = rgba (all frames in one raw file) or png (one file per frame)
+    int recordingFrameSkip;         // One frame every N simulation ticks
+    int recordingMaxQueuedFrames;   // Frames waiting to be drawn or written, a window drops frames beyond this
+    unsigned int recordingWidth;    // Frame size of headless recordings (the window size otherwise)
+    unsigned int recordingHeight;
+
+    // [files] (an empty archive, telemetry or replays path turns that output off)
+    std::string vehiclesPath;
+    std::string trackPath;
+    std::string checkpointPath;
+    std::string archivePath;   // Without the .arc/.idx extension
+    std::string championPath;
+    std::string telemetryPath; // Without the extension
+    bool telemetryCsv;         // CSV files instead of the binary telemetry file
+    std::string replayDirectory;
+
+    GameConfig();
+
+    // Network inputs: one per sensor plus speed and rotation
+    int getInputCount() const { return static_cast<int>(sensorAngles.size()) + 2; }
+
+    // Lap time for a generation from the schedule
+    float getLapTime(int generation) const;
+
+    // Read an INI file, returns false if it can't be opened (unknown keys and bad values are reported and skipped)
+    bool loadFromFile(const std::string &filename);
+
+    // Set one key ("section.key"), returns false if the key is unknown or the value invalid
+    bool set(const std::string &key, const std::string &value);
+
+    // Command line override "section.key=value"
+    bool applyOverride(const std::string &assignment);
+
+    // Keys and their meaning for --help
+    static const char *getKeyHelp();
+};
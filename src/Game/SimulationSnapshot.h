@@ -0,0 +1,62 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+class GhostLap;
+
+// Pose of one car at the end of a simulation tick
+struct CarSnapshot
+{
+    float x, y;
+    float rotation; // Degrees
+    float fitness;  // Current fitness of the car's controller
+    bool alive;
+};
+
+// Everything the renderer needs from one simulation tick
+// Written by the simulation, read by the render thread through a TripleBuffer, never shared while written
+struct SimulationSnapshot
+{
+    unsigned long long tick; // Simulation tick this snapshot was taken at
+    float simulationRate;    // Simulation ticks per second (measured)
+
+    // Cars
+    std::vector<CarSnapshot> cars;
+
+    // Ray sensors: angles relative to the car, distances per car (cars.size() * sensorAngles.size())
+    // Only filled while the sensor layer is shown
+    std::vector<float> sensorAngles;
+    std::vector<float> sensorDistances;
+    float sensorRange; // Maximum ray length
+
+    // Ghost cars of recorded runs (never changed once published, shared with the simulation) and the time they're shown at
+    std::shared_ptr<const std::vector<GhostLap>> ghosts;
+    float ghostTime;
+    bool replaying; // The cars are a replay, not the population
+
+    // Node values of the network shown in the visualization (indexed by node id, empty if none)
+    std::vector<double> networkActivations;
+
+    // HUD stats
+    bool aiLearningEnabled;
+    bool aiLearningPaused;
+    int generation;
+    double bestFitness;
+    int speciesCount;
+    float generationTime;
+    float maxGenerationTime;
+    int raceLaps;
+    bool carCollisionsEnabled;
+    bool fastForward;
+    std::string timeString;
+    int hitCheckpoints;
+    int totalCheckpoints;
+
+    SimulationSnapshot()
+        : tick(0), simulationRate(0.0f), sensorRange(0.0f), ghostTime(0.0f), replaying(false), aiLearningEnabled(false), aiLearningPaused(false),
+          generation(0), bestFitness(0.0), speciesCount(0), generationTime(0.0f), maxGenerationTime(0.0f),
+          raceLaps(1), carCollisionsEnabled(false), fastForward(false), hitCheckpoints(0), totalCheckpoints(0)
+    {
+    }
+};
@@ -0,0 +1,46 @@
+#pragma once
+#include <atomic>
+
+// Lock-free single producer / single consumer triple buffer
+// The writer always has a private slot to fill, publishing swaps it with the shared middle slot,
+// the reader swaps the middle slot into its own slot only when something new was published.
+// Neither side ever waits for the other, the reader simply sees the latest published value.
+template <typename T>
+class TripleBuffer
+{
+private:
+    static const int IndexMask = 0x3;
+    static const int FreshBit = 0x4; // Set in middle when it holds a value the reader hasn't taken yet
+
+    T buffers[3];
+    std::atomic<int> middle; // Index of the shared slot plus the fresh bit
+    int writeIndex;          // Only touched by the writer
+    int readIndex;           // Only touched by the reader
+
+public:
+    TripleBuffer() : middle(1), writeIndex(0), readIndex(2) {}
+
+    TripleBuffer(const TripleBuffer &) = delete;
+    TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+    // Writer side: fill this slot, then publish it
+    T &getWriteBuffer() { return buffers[writeIndex]; }
+
+    void publish()
+    {
+        // Hand the written slot to the middle and take back whatever was there
+        writeIndex = middle.exchange(writeIndex | FreshBit, std::memory_order_acq_rel) & IndexMask;
+    }
+
+    // Reader side: returns true if a newer value was taken (getReadBuffer() changed)
+    bool acquire()
+    {
+        if ((middle.load(std::memory_order_acquire) & FreshBit) == 0)
+            return false;
+
+        readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & IndexMask;
+        return true;
+    }
+
+    const T &getReadBuffer() const { return buffers[readIndex]; }
+};
@@ -0,0 +1,89 @@
+#include "WorkerPool.h"
+#include <algorithm>
+
+WorkerPool::WorkerPool(unsigned int threadCount)
+    : job(nullptr), jobCount(0), chunkSize(1), nextIndex(0), jobNumber(0), busyWorkers(0), stopping(false)
+{
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    for (unsigned int i = 1; i < threadCount; ++i)
+    {
+        workers.emplace_back(&WorkerPool::workerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    startCondition.notify_all();
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+void WorkerPool::parallelFor(std::size_t count, const RangeFunction &body)
+{
+    if (workers.empty() || count <= 1)
+    {
+        body(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &body;
+        jobCount = count;
+
+        // A few chunks per thread, so a thread with slow cars (long sensor casts) doesn't hold up the others
+        chunkSize = std::max<std::size_t>(1, count / (getThreadCount() * 4));
+        nextIndex.store(0, std::memory_order_relaxed);
+        busyWorkers = workers.size();
+        ++jobNumber;
+    }
+    startCondition.notify_all();
+
+    runChunks();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCondition.wait(lock, [this]
+                       { return busyWorkers == 0; });
+    job = nullptr;
+}
+
+void WorkerPool::runChunks()
+{
+    while (true)
+    {
+        std::size_t begin = nextIndex.fetch_add(chunkSize, std::memory_order_relaxed);
+        if (begin >= jobCount)
+            break;
+        (*job)(begin, std::min(begin + chunkSize, jobCount));
+    }
+}
+
+void WorkerPool::workerLoop()
+{
+    unsigned long long finishedJob = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            startCondition.wait(lock, [this, finishedJob]
+                                { return stopping || jobNumber != finishedJob; });
+            if (stopping)
+                return;
+            finishedJob = jobNumber;
+        }
+
+        runChunks();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busyWorkers == 0)
+            doneCondition.notify_all();
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A fixed set of threads that split index loops (one index per car)
+// parallelFor() hands out chunks of the range and returns once every chunk is done. The calling thread works on
+// chunks too, so a pool of one thread runs the loop inline without any synchronization.
+class WorkerPool
+{
+public:
+    using RangeFunction = std::function<void(std::size_t begin, std::size_t end)>;
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable startCondition;
+    std::condition_variable doneCondition;
+
+    // The current loop (set under the mutex before a new job is announced)
+    const RangeFunction *job;
+    std::size_t jobCount;
+    std::size_t chunkSize;
+    std::atomic<std::size_t> nextIndex;
+    unsigned long long jobNumber; // Counts up per loop, workers wake when it changes
+    std::size_t busyWorkers;
+    bool stopping;
+
+    void workerLoop();
+    void runChunks();
+
+public:
+    // threadCount includes the calling thread, 0 uses every hardware thread
+    explicit WorkerPool(unsigned int threadCount = 0);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    std::size_t getThreadCount() const { return workers.size() + 1; }
+
+    // Call body for disjoint ranges covering [0, count) and wait for all of them
+    void parallelFor(std::size_t count, const RangeFunction &body);
+};
@@ -6,5 +6,5 @@ class IRenderable
 {
 public:
     virtual ~IRenderable() = default;
-    virtual void draw(sf::RenderWindow& window) const = 0;
+    virtual void draw(sf::RenderTarget& target) const = 0;
 }; 
\ No newline at end of file
@@ -0,0 +1,208 @@
+#include "Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+std::atomic<int> Logger::minimumLevel(static_cast<int>(LogLevel::Info));
+
+// LogLine
+
+void LogLine::append(const char *characters, std::size_t count)
+{
+    count = std::min(count, Capacity - length);
+    std::memcpy(text + length, characters, count);
+    length += count;
+}
+
+template <typename T>
+LogLine &LogLine::appendFormatted(const char *format, T value)
+{
+    char number[48];
+    int count = std::snprintf(number, sizeof(number), format, value);
+    if (count > 0)
+        append(number, std::min(static_cast<std::size_t>(count), sizeof(number) - 1));
+    return *this;
+}
+
+LogLine &LogLine::operator<<(const char *value)
+{
+    if (value)
+        append(value, std::strlen(value));
+    return *this;
+}
+
+LogLine &LogLine::operator<<(const std::string &value)
+{
+    append(value.data(), value.size());
+    return *this;
+}
+
+LogLine &LogLine::operator<<(char value)
+{
+    append(&value, 1);
+    return *this;
+}
+
+LogLine &LogLine::operator<<(int value) { return appendFormatted("%d", value); }
+LogLine &LogLine::operator<<(unsigned int value) { return appendFormatted("%u", value); }
+LogLine &LogLine::operator<<(long value) { return appendFormatted("%ld", value); }
+LogLine &LogLine::operator<<(unsigned long value) { return appendFormatted("%lu", value); }
+LogLine &LogLine::operator<<(long long value) { return appendFormatted("%lld", value); }
+LogLine &LogLine::operator<<(unsigned long long value) { return appendFormatted("%llu", value); }
+LogLine &LogLine::operator<<(float value) { return appendFormatted("%g", static_cast<double>(value)); }
+LogLine &LogLine::operator<<(double value) { return appendFormatted("%g", value); }
+
+LogLine &LogLine::operator<<(const LogFixed &value)
+{
+    char number[48];
+    int count = std::snprintf(number, sizeof(number), "%.*f", value.precision, value.value);
+    if (count > 0)
+        append(number, std::min(static_cast<std::size_t>(count), sizeof(number) - 1));
+    return *this;
+}
+
+// Logger
+
+Logger::Logger() : writePosition(0), readPosition(0), droppedMessages(0), running(true)
+{
+    for (std::size_t i = 0; i < RingSize; ++i)
+    {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    flusherThread = std::thread(&Logger::flusherLoop, this);
+}
+
+Logger::~Logger()
+{
+    running.store(false, std::memory_order_release);
+    if (flusherThread.joinable())
+        flusherThread.join();
+}
+
+Logger &Logger::instance()
+{
+    static Logger logger;
+    return logger;
+}
+
+void Logger::write(LogLevel level, const LogLine &line)
+{
+    instance().push(level, line.data(), line.size());
+}
+
+bool Logger::push(LogLevel level, const char *text, std::size_t length)
+{
+    // Claim a slot: a producer owns position p once it moves writePosition past it
+    std::size_t position = writePosition.load(std::memory_order_relaxed);
+    Slot *slot;
+    while (true)
+    {
+        slot = &slots[position & (RingSize - 1)];
+        std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        if (sequence == position)
+        {
+            if (writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (sequence < position)
+        {
+            // The flusher hasn't freed this slot yet, the ring is full
+            droppedMessages.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        else
+        {
+            position = writePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->level = level;
+    slot->length = static_cast<std::uint16_t>(std::min(length, LogLine::Capacity));
+    std::memcpy(slot->text, text, slot->length);
+
+    // Publish to the flusher
+    slot->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+bool Logger::drain(std::string &output)
+{
+    bool any = false;
+    while (true)
+    {
+        Slot &slot = slots[readPosition & (RingSize - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != readPosition + 1)
+            break;
+
+        if (slot.level != LogLevel::Info)
+        {
+            output += '[';
+            output += getLevelName(slot.level);
+            output += "] ";
+        }
+        output.append(slot.text, slot.length);
+        output += '\n';
+
+        // Free the slot for the producer one lap ahead
+        slot.sequence.store(readPosition + RingSize, std::memory_order_release);
+        ++readPosition;
+        any = true;
+    }
+    return any;
+}
+
+void Logger::flusherLoop()
+{
+    std::string output;
+    std::size_t reportedDrops = 0;
+
+    while (true)
+    {
+        // Read the flag first, so the last pass sees every message pushed before shutdown
+        bool stopping = !running.load(std::memory_order_acquire);
+
+        output.clear();
+        bool wrote = drain(output);
+
+        std::size_t dropped = droppedMessages.load(std::memory_order_relaxed);
+        if (dropped != reportedDrops)
+        {
+            output += "[warning] " + std::to_string(dropped - reportedDrops) + " log messages dropped\n";
+            reportedDrops = dropped;
+            wrote = true;
+        }
+
+        // One write and flush per batch instead of one per message
+        if (wrote)
+        {
+            std::cout.write(output.data(), static_cast<std::streamsize>(output.size()));
+            std::cout.flush();
+        }
+
+        if (stopping)
+            break;
+        if (!wrote)
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+}
+
+const char *Logger::getLevelName(LogLevel level)
+{
+    switch (level)
+    {
+    case LogLevel::Trace:
+        return "trace";
+    case LogLevel::Debug:
+        return "debug";
+    case LogLevel::Info:
+        return "info";
+    case LogLevel::Warning:
+        return "warning";
+    case LogLevel::Error:
+        return "error";
+    default:
+        return "off";
+    }
+}
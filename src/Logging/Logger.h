@@ -0,0 +1,150 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+enum class LogLevel : std::uint8_t
+{
+    Trace = 0,
+    Debug = 1,
+    Info = 2,
+    Warning = 3,
+    Error = 4,
+    Off = 5
+};
+
+// Trace messages are compiled out of release builds, define RACECAR_LOG_COMPILE_LEVEL to choose
+#ifndef RACECAR_LOG_COMPILE_LEVEL
+#ifdef NDEBUG
+#define RACECAR_LOG_COMPILE_LEVEL 1
+#else
+#define RACECAR_LOG_COMPILE_LEVEL 0
+#endif
+#endif
+
+// Fixed point number for log lines, like std::fixed << std::setprecision(precision)
+struct LogFixed
+{
+    double value;
+    int precision;
+
+    LogFixed(double number, int digits) : value(number), precision(digits) {}
+};
+
+// One message, formatted into a fixed buffer on the caller's stack (never allocates, long messages are cut)
+class LogLine
+{
+public:
+    static constexpr std::size_t Capacity = 240;
+
+private:
+    char text[Capacity];
+    std::size_t length;
+
+    void append(const char *characters, std::size_t count);
+    template <typename T>
+    LogLine &appendFormatted(const char *format, T value);
+
+public:
+    LogLine() : length(0) {}
+
+    LogLine &operator<<(const char *value);
+    LogLine &operator<<(const std::string &value);
+    LogLine &operator<<(char value);
+    LogLine &operator<<(int value);
+    LogLine &operator<<(unsigned int value);
+    LogLine &operator<<(long value);
+    LogLine &operator<<(unsigned long value);
+    LogLine &operator<<(long long value);
+    LogLine &operator<<(unsigned long long value);
+    LogLine &operator<<(float value);
+    LogLine &operator<<(double value);
+    LogLine &operator<<(const LogFixed &value);
+
+    const char *data() const { return text; }
+    std::size_t size() const { return length; }
+};
+
+// Asynchronous console logger
+// Messages go into a lock-free ring buffer (any number of producer threads) and a background thread writes them,
+// so logging never waits for the console. When the ring is full new messages are dropped and counted.
+class Logger
+{
+public:
+    static constexpr std::size_t RingSize = 1024; // Power of two
+
+private:
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence; // Equals the write position when free, position + 1 when filled
+        LogLevel level;
+        std::uint16_t length;
+        char text[LogLine::Capacity];
+    };
+
+    Slot slots[RingSize];
+    std::atomic<std::size_t> writePosition;
+    std::size_t readPosition; // Flusher thread only
+    std::atomic<std::size_t> droppedMessages;
+    std::atomic<bool> running;
+    std::thread flusherThread;
+
+    static std::atomic<int> minimumLevel;
+
+    Logger();
+    ~Logger();
+
+    bool push(LogLevel level, const char *text, std::size_t length);
+    bool drain(std::string &output);
+    void flusherLoop();
+
+public:
+    Logger(const Logger &) = delete;
+    Logger &operator=(const Logger &) = delete;
+
+    static Logger &instance();
+
+    // Messages below the level are skipped before they are formatted
+    static void setLevel(LogLevel level) { minimumLevel.store(static_cast<int>(level), std::memory_order_relaxed); }
+    static LogLevel getLevel() { return static_cast<LogLevel>(minimumLevel.load(std::memory_order_relaxed)); }
+    static bool isEnabled(LogLevel level) { return static_cast<int>(level) >= minimumLevel.load(std::memory_order_relaxed); }
+
+    // Queue a message, returns immediately
+    static void write(LogLevel level, const LogLine &line);
+
+    static const char *getLevelName(LogLevel level);
+};
+
+#define RACECAR_LOG(level, message)                  \
+    do                                               \
+    {                                                \
+        if (Logger::isEnabled(level))                \
+        {                                            \
+            LogLine racecarLogLine;                  \
+            racecarLogLine << message;               \
+            Logger::write(level, racecarLogLine);    \
+        }                                            \
+    } while (0)
+
+#define RACECAR_LOG_DISABLED(message) \
+    do                                \
+    {                                 \
+    } while (0)
+
+#if RACECAR_LOG_COMPILE_LEVEL <= 0
+#define LOG_TRACE(message) RACECAR_LOG(LogLevel::Trace, message)
+#else
+#define LOG_TRACE(message) RACECAR_LOG_DISABLED(message)
+#endif
+
+#if RACECAR_LOG_COMPILE_LEVEL <= 1
+#define LOG_DEBUG(message) RACECAR_LOG(LogLevel::Debug, message)
+#else
+#define LOG_DEBUG(message) RACECAR_LOG_DISABLED(message)
+#endif
+
+#define LOG_INFO(message) RACECAR_LOG(LogLevel::Info, message)
+#define LOG_WARNING(message) RACECAR_LOG(LogLevel::Warning, message)
+#define LOG_ERROR(message) RACECAR_LOG(LogLevel::Error, message)
@@ -0,0 +1,126 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Queue plus writer thread shared by everything that writes files while the game runs
+// The owner queues items and returns immediately, the write function runs on the writer thread and gets every
+// item that queued up since its previous call, oldest first. stop() returns once everything queued is written.
+template <typename Item>
+class BackgroundWriter
+{
+public:
+    using WriteFunction = std::function<void(std::deque<Item> &items)>;
+
+private:
+    WriteFunction write;
+    std::thread writerThread;
+    mutable std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<Item> queue;
+    bool writing;
+    bool stopWriter;
+
+    void writerLoop()
+    {
+        std::deque<Item> items;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            condition.wait(lock, [this]
+                           { return !queue.empty() || stopWriter; });
+
+            // Exit only after every queued item is written
+            if (queue.empty())
+                break;
+
+            items.swap(queue);
+            writing = true;
+
+            lock.unlock();
+            write(items);
+            items.clear();
+            lock.lock();
+
+            writing = false;
+            condition.notify_all();
+        }
+    }
+
+public:
+    BackgroundWriter() : writing(false), stopWriter(false) {}
+    ~BackgroundWriter() { stop(); }
+
+    BackgroundWriter(const BackgroundWriter &) = delete;
+    BackgroundWriter &operator=(const BackgroundWriter &) = delete;
+
+    void start(WriteFunction writeFunction)
+    {
+        stop();
+        write = std::move(writeFunction);
+        stopWriter = false;
+        writerThread = std::thread(&BackgroundWriter::writerLoop, this);
+    }
+
+    // Writes what is still queued, then ends the thread
+    void stop()
+    {
+        if (!writerThread.joinable())
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopWriter = true;
+        }
+        condition.notify_all();
+        writerThread.join();
+    }
+
+    bool isRunning() const { return writerThread.joinable(); }
+
+    void push(Item item)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(std::move(item));
+        }
+        condition.notify_all();
+    }
+
+    // Drop whatever wasn't written yet and queue this instead (when only the newest item matters)
+    void replace(Item item)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.clear();
+            queue.push_back(std::move(item));
+        }
+        condition.notify_all();
+    }
+
+    // Block until everything queued so far is written
+    void flush()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this]
+                       { return queue.empty() && !writing; });
+    }
+
+    // Block while count or more items wait for the writer (a producer that must not outrun the disk)
+    void waitUntilQueuedBelow(std::size_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this, count]
+                       { return queue.size() < count || stopWriter; });
+    }
+
+    // Items waiting for the writer (not counting the ones being written)
+    std::size_t getQueued() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return queue.size();
+    }
+};
@@ -0,0 +1,197 @@
+#include "BinaryIO.h"
+#include <cstring>
+
+void BinaryWriter::writeU8(std::uint8_t value)
+{
+    buffer.push_back(static_cast<char>(value));
+}
+
+void BinaryWriter::writeU32(std::uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+void BinaryWriter::writeU64(std::uint64_t value)
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+void BinaryWriter::writeI32(std::int32_t value)
+{
+    writeU32(static_cast<std::uint32_t>(value));
+}
+
+void BinaryWriter::writeF32(float value)
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeU32(bits);
+}
+
+void BinaryWriter::writeF64(double value)
+{
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeU64(bits);
+}
+
+void BinaryWriter::writeVarU32(std::uint32_t value)
+{
+    // Seven bits per byte, low bits first, the high bit marks that another byte follows
+    while (value >= 0x80)
+    {
+        buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<char>(value));
+}
+
+void BinaryWriter::writeString(const std::string &value)
+{
+    writeU32(static_cast<std::uint32_t>(value.size()));
+    writeBytes(value.data(), value.size());
+}
+
+void BinaryWriter::writeBytes(const void *data, std::size_t size)
+{
+    const char *bytes = static_cast<const char *>(data);
+    buffer.insert(buffer.end(), bytes, bytes + size);
+}
+
+BinaryReader::BinaryReader(const void *bytes, std::size_t byteCount)
+    : data(static_cast<const char *>(bytes)), size(byteCount), offset(0), failed(false)
+{
+}
+
+bool BinaryReader::take(std::size_t count)
+{
+    if (failed || count > size - offset)
+    {
+        failed = true;
+        return false;
+    }
+    return true;
+}
+
+std::uint8_t BinaryReader::readU8()
+{
+    if (!take(1))
+        return 0;
+    return static_cast<std::uint8_t>(data[offset++]);
+}
+
+std::uint32_t BinaryReader::readU32()
+{
+    if (!take(4))
+        return 0;
+
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        value |= static_cast<std::uint32_t>(static_cast<unsigned char>(data[offset++])) << (8 * i);
+    }
+    return value;
+}
+
+std::uint64_t BinaryReader::readU64()
+{
+    if (!take(8))
+        return 0;
+
+    std::uint64_t value = 0;
+    for (int i = 0; i < 8; ++i)
+    {
+        value |= static_cast<std::uint64_t>(static_cast<unsigned char>(data[offset++])) << (8 * i);
+    }
+    return value;
+}
+
+std::int32_t BinaryReader::readI32()
+{
+    return static_cast<std::int32_t>(readU32());
+}
+
+float BinaryReader::readF32()
+{
+    std::uint32_t bits = readU32();
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+double BinaryReader::readF64()
+{
+    std::uint64_t bits = readU64();
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+std::uint32_t BinaryReader::readVarU32()
+{
+    std::uint32_t value = 0;
+    for (int shift = 0; shift < 35; shift += 7)
+    {
+        std::uint8_t byte = readU8();
+        if (failed)
+            return 0;
+
+        value |= static_cast<std::uint32_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return value;
+    }
+
+    // More than five bytes can't be a 32 bit value
+    failed = true;
+    return 0;
+}
+
+std::string BinaryReader::readString()
+{
+    std::uint32_t length = readCount(1);
+    if (!take(length))
+        return std::string();
+
+    std::string value(data + offset, length);
+    offset += length;
+    return value;
+}
+
+bool BinaryReader::readBytes(void *destination, std::size_t count)
+{
+    if (!take(count))
+        return false;
+
+    std::memcpy(destination, data + offset, count);
+    offset += count;
+    return true;
+}
+
+std::uint32_t BinaryReader::readCount(std::size_t minElementSize)
+{
+    std::uint32_t count = readU32();
+    if (minElementSize > 0 && count > getRemaining() / minElementSize)
+    {
+        failed = true;
+        return 0;
+    }
+    return count;
+}
+
+std::uint32_t fnv1a(const void *data, std::size_t size)
+{
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
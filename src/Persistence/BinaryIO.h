@@ -0,0 +1,71 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Little endian binary encoding for save files
+// Values are packed byte by byte, so files are the same on every platform and need no alignment.
+
+class BinaryWriter
+{
+private:
+    std::vector<char> &buffer;
+
+public:
+    explicit BinaryWriter(std::vector<char> &output) : buffer(output) {}
+
+    void writeU8(std::uint8_t value);
+    void writeU32(std::uint32_t value);
+    void writeU64(std::uint64_t value);
+    void writeI32(std::int32_t value);
+    void writeF32(float value);
+    void writeF64(double value);
+    void writeVarU32(std::uint32_t value); // 1 to 5 bytes, small values take fewer
+    void writeBool(bool value) { writeU8(value ? 1 : 0); }
+    void writeString(const std::string &value); // u32 length + bytes
+    void writeBytes(const void *data, std::size_t size);
+
+    std::size_t getSize() const { return buffer.size(); }
+};
+
+// Reads what BinaryWriter wrote, never past the end of the data
+// After the first failed read every read returns 0 and ok() is false, so callers check once at the end.
+class BinaryReader
+{
+private:
+    const char *data;
+    std::size_t size;
+    std::size_t offset;
+    bool failed;
+
+    bool take(std::size_t count);
+
+public:
+    BinaryReader(const void *bytes, std::size_t byteCount);
+
+    std::uint8_t readU8();
+    std::uint32_t readU32();
+    std::uint64_t readU64();
+    std::int32_t readI32();
+    float readF32();
+    double readF64();
+    std::uint32_t readVarU32();
+    bool readBool() { return readU8() != 0; }
+    std::string readString();
+    bool readBytes(void *destination, std::size_t count);
+
+    // Element count of a following array, fails if the remaining data can't hold that many elements of minElementSize bytes
+    // (a corrupt count never triggers a huge allocation)
+    std::uint32_t readCount(std::size_t minElementSize);
+
+    // Mark the data as invalid (a value was read fine but makes no sense)
+    void fail() { failed = true; }
+
+    bool ok() const { return !failed; }
+    std::size_t getOffset() const { return offset; }
+    std::size_t getRemaining() const { return size - offset; }
+};
+
+// FNV-1a of a byte range: the checksum at the end of every save file, also used to fingerprint the random state
+std::uint32_t fnv1a(const void *data, std::size_t size);
@@ -0,0 +1,89 @@
+#include "CheckpointWriter.h"
+#include "../Logging/Logger.h"
+#include <filesystem>
+#include <fstream>
+
+CheckpointWriter::CheckpointWriter(bool keepEveryFile) : writtenFiles(0), failedFiles(0), keepEveryFile(keepEveryFile)
+{
+    backgroundWriter.start([this](std::deque<PendingFile> &files)
+                           { writeFiles(files); });
+}
+
+CheckpointWriter::~CheckpointWriter()
+{
+    backgroundWriter.stop();
+}
+
+void CheckpointWriter::save(const std::string &path, std::vector<char> data)
+{
+    PendingFile file;
+    file.path = path;
+    file.data = std::move(data);
+    if (keepEveryFile)
+        backgroundWriter.push(std::move(file));
+    else
+        backgroundWriter.replace(std::move(file));
+}
+
+void CheckpointWriter::flush()
+{
+    backgroundWriter.flush();
+}
+
+void CheckpointWriter::writeFiles(std::deque<PendingFile> &files)
+{
+    for (const PendingFile &file : files)
+    {
+        if (writeFileAtomically(file.path, file.data))
+            writtenFiles++;
+        else
+            failedFiles++;
+    }
+}
+
+bool CheckpointWriter::writeFileAtomically(const std::string &path, const std::vector<char> &data)
+{
+    std::filesystem::path target(path);
+    std::filesystem::path temporary(path + ".tmp");
+
+    std::error_code error;
+    if (target.has_parent_path())
+        std::filesystem::create_directories(target.parent_path(), error);
+
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        file.flush();
+        if (!file)
+        {
+            LOG_ERROR("Checkpoint: could not write " << temporary.string());
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+    }
+
+    // Replaces the old file in one step (std::filesystem::rename overwrites on every platform)
+    std::filesystem::rename(temporary, target, error);
+    if (error)
+    {
+        LOG_ERROR("Checkpoint: could not replace " << target.string() << ": " << error.message());
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
+
+bool CheckpointWriter::readFile(const std::string &path, std::vector<char> &data)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+        return false;
+
+    std::streamsize size = file.tellg();
+    if (size < 0)
+        return false;
+
+    data.resize(static_cast<std::size_t>(size));
+    file.seekg(0);
+    return static_cast<bool>(file.read(data.data(), size));
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "BackgroundWriter.h"
+#include <atomic>
+#include <string>
+#include <vector>
+
+// Writes save files on a background thread so the simulation never waits for the disk
+// Each file is written to <path>.tmp and then renamed over <path>, so a crash mid-write
+// leaves the previous file intact instead of a truncated one.
+class CheckpointWriter
+{
+private:
+    struct PendingFile
+    {
+        std::string path;
+        std::vector<char> data;
+    };
+
+    std::atomic<std::size_t> writtenFiles;
+    std::atomic<std::size_t> failedFiles;
+    bool keepEveryFile; // Every save is written, otherwise only the newest data matters and a pending save is replaced
+
+    BackgroundWriter<PendingFile> backgroundWriter;
+
+    void writeFiles(std::deque<PendingFile> &files);
+
+public:
+    // keepEveryFile for files that each have their own path (replays), a checkpoint only needs its newest save
+    explicit CheckpointWriter(bool keepEveryFile = false);
+    ~CheckpointWriter(); // Finishes the pending writes
+
+    CheckpointWriter(const CheckpointWriter &) = delete;
+    CheckpointWriter &operator=(const CheckpointWriter &) = delete;
+
+    // Queue data for writing, returns immediately
+    void save(const std::string &path, std::vector<char> data);
+
+    // Block until everything queued so far is on disk
+    void flush();
+
+    std::size_t getWrittenFiles() const { return writtenFiles; }
+    std::size_t getFailedFiles() const { return failedFiles; }
+
+    // Synchronous helpers (also used by the writer thread)
+    static bool writeFileAtomically(const std::string &path, const std::vector<char> &data);
+    static bool readFile(const std::string &path, std::vector<char> &data);
+};
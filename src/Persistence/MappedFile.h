@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of a whole file
+// Pages are loaded on first access, so opening a large file costs nothing until parts of it are read.
+// The mapping shows the file as it was when opened, call open() again to see later appends.
+class MappedFile
+{
+private:
+    const char *data;
+    std::size_t size;
+
+#ifdef _WIN32
+    void *fileHandle;
+    void *mappingHandle;
+#else
+    int fileDescriptor;
+#endif
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    // Map the file, returns false if it can't be opened (an empty file opens with no data)
+    bool open(const std::string &path);
+    void close();
+
+    bool isOpen() const;
+    const char *getData() const { return data; }
+    std::size_t getSize() const { return size; }
+};
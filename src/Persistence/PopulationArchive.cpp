@@ -0,0 +1,312 @@
+#include "PopulationArchive.h"
+#include "BinaryIO.h"
+#include "TrainingCheckpoint.h"
+#include "../AI/NeuralNetwork.h"
+#include "../Logging/Logger.h"
+#include <filesystem>
+
+namespace
+{
+    const std::uint32_t DataMagic = 0x52414352;  // "RCAR" in file order
+    const std::uint32_t IndexMagic = 0x58494352; // "RCIX" in file order
+    const std::uint32_t ArchiveVersion = 1;
+    const std::size_t DataHeaderSize = 8;
+    const std::size_t IndexHeaderSize = 16;
+    const std::size_t EntrySize = 48;
+
+    void writeEntry(BinaryWriter &writer, const ArchiveEntry &entry)
+    {
+        writer.writeI32(entry.generation);
+        writer.writeU32(entry.populationSize);
+        writer.writeF64(entry.bestFitness);
+        writer.writeU64(entry.checkpointOffset);
+        writer.writeU64(entry.checkpointSize);
+        writer.writeU64(entry.championOffset);
+        writer.writeU32(entry.championSize);
+        writer.writeU32(entry.speciesCount);
+    }
+
+    // Check the magic and version of an existing file, the index also stores its entry size
+    bool checkHeader(const char *data, std::size_t size, std::uint32_t magic, bool isIndex)
+    {
+        BinaryReader reader(data, size);
+        bool valid = reader.readU32() == magic && reader.readU32() == ArchiveVersion;
+        if (isIndex)
+        {
+            valid = valid && reader.readU32() == EntrySize;
+            reader.readU32(); // Reserved, but the full header must be there
+        }
+        return valid && reader.ok();
+    }
+
+    bool readHeader(const std::string &path, std::size_t headerSize, std::uint32_t magic, bool isIndex)
+    {
+        std::vector<char> header(headerSize);
+        std::ifstream file(path, std::ios::binary);
+        if (!file.read(header.data(), static_cast<std::streamsize>(headerSize)))
+            return false;
+        return checkHeader(header.data(), header.size(), magic, isIndex);
+    }
+
+    // After a failed write: close the file (nothing stays buffered), cut a file of fixed size entries back to whole entries
+    // and open it for appending again. An entry size of 0 keeps whatever reached the disk. Returns the file's size.
+    std::uintmax_t reopenAfterFailedWrite(std::ofstream &file, const std::string &path, std::size_t headerSize, std::size_t entrySize)
+    {
+        file.clear();
+        file.close();
+
+        std::error_code error;
+        std::uintmax_t size = std::filesystem::file_size(path, error);
+        if (!error && entrySize > 0 && size > headerSize)
+        {
+            std::uintmax_t wholeEntries = headerSize + (size - headerSize) / entrySize * entrySize;
+            if (wholeEntries != size)
+            {
+                std::filesystem::resize_file(path, wholeEntries, error);
+                size = wholeEntries;
+            }
+        }
+
+        file.open(path, std::ios::binary | std::ios::app);
+        return size;
+    }
+}
+
+// Writer
+
+PopulationArchiveWriter::PopulationArchiveWriter() : dataSize(0), opened(false)
+{
+}
+
+PopulationArchiveWriter::~PopulationArchiveWriter()
+{
+    close();
+}
+
+bool PopulationArchiveWriter::open(const std::string &archiveBasePath)
+{
+    close();
+    basePath = archiveBasePath;
+    std::string dataPath = basePath + ".arc";
+    std::string indexPath = basePath + ".idx";
+
+    std::error_code error;
+    std::filesystem::path parent = std::filesystem::path(dataPath).parent_path();
+    if (!parent.empty())
+        std::filesystem::create_directories(parent, error);
+
+    std::uintmax_t existingData = std::filesystem::exists(dataPath, error) ? std::filesystem::file_size(dataPath, error) : 0;
+    std::uintmax_t existingIndex = std::filesystem::exists(indexPath, error) ? std::filesystem::file_size(indexPath, error) : 0;
+
+    // Records without an index are never thrown away (their sizes and fitness are only in the index, so it can't be rebuilt)
+    if (existingIndex == 0 && existingData > DataHeaderSize)
+    {
+        LOG_WARNING("Archive: " << indexPath << " is missing, move " << dataPath << " away to start a new archive");
+        return false;
+    }
+
+    // New archive: write both headers
+    if (existingIndex == 0)
+    {
+        std::vector<char> header;
+        BinaryWriter writer(header);
+        writer.writeU32(DataMagic);
+        writer.writeU32(ArchiveVersion);
+        std::ofstream(dataPath, std::ios::binary | std::ios::trunc).write(header.data(), header.size());
+
+        header.clear();
+        writer.writeU32(IndexMagic);
+        writer.writeU32(ArchiveVersion);
+        writer.writeU32(EntrySize);
+        writer.writeU32(0);
+        std::ofstream(indexPath, std::ios::binary | std::ios::trunc).write(header.data(), header.size());
+    }
+    else
+    {
+        if (!readHeader(dataPath, DataHeaderSize, DataMagic, false) || !readHeader(indexPath, IndexHeaderSize, IndexMagic, true))
+        {
+            LOG_WARNING("Archive: " << basePath << " is not a population archive of version " << ArchiveVersion);
+            return false;
+        }
+
+        // Drop a half written index entry left by a crash
+        std::uintmax_t entryBytes = (existingIndex - IndexHeaderSize) / EntrySize * EntrySize;
+        if (IndexHeaderSize + entryBytes != existingIndex)
+            std::filesystem::resize_file(indexPath, IndexHeaderSize + entryBytes, error);
+    }
+
+    dataFile.open(dataPath, std::ios::binary | std::ios::app);
+    indexFile.open(indexPath, std::ios::binary | std::ios::app);
+    if (!dataFile || !indexFile)
+    {
+        LOG_WARNING("Archive: could not open " << basePath << " for appending");
+        dataFile.close();
+        indexFile.close();
+        return false;
+    }
+
+    dataSize = std::filesystem::file_size(dataPath, error);
+    backgroundWriter.start([this](std::deque<Record> &records)
+                           { writeRecords(records); });
+    opened = true;
+    return true;
+}
+
+void PopulationArchiveWriter::close()
+{
+    if (!opened)
+        return;
+
+    backgroundWriter.stop();
+    dataFile.close();
+    indexFile.close();
+    opened = false;
+}
+
+void PopulationArchiveWriter::append(int generation, std::uint32_t populationSize, std::uint32_t speciesCount, double bestFitness,
+                                     const NeuralNetwork &champion, std::vector<char> checkpoint)
+{
+    if (!opened)
+        return;
+
+    Record record;
+    record.entry.generation = generation;
+    record.entry.populationSize = populationSize;
+    record.entry.speciesCount = speciesCount;
+    record.entry.bestFitness = bestFitness;
+    BinaryWriter writer(record.champion);
+    champion.serialize(writer);
+    record.checkpoint = std::move(checkpoint);
+
+    backgroundWriter.push(std::move(record));
+}
+
+void PopulationArchiveWriter::writeRecords(std::deque<Record> &records)
+{
+    for (Record &record : records)
+    {
+        if (!writeRecord(record))
+            LOG_ERROR("Archive: generation " << record.entry.generation << " could not be written");
+    }
+}
+
+bool PopulationArchiveWriter::writeRecord(Record &record)
+{
+    record.entry.championOffset = dataSize;
+    record.entry.championSize = static_cast<std::uint32_t>(record.champion.size());
+    record.entry.checkpointOffset = dataSize + record.champion.size();
+    record.entry.checkpointSize = record.checkpoint.size();
+
+    // Data first, the index entry only once the record is complete
+    dataFile.write(record.champion.data(), static_cast<std::streamsize>(record.champion.size()));
+    dataFile.write(record.checkpoint.data(), static_cast<std::streamsize>(record.checkpoint.size()));
+    dataFile.flush();
+    if (!dataFile)
+    {
+        // Continue after whatever made it to disk, that space is simply never indexed
+        dataSize = reopenAfterFailedWrite(dataFile, basePath + ".arc", DataHeaderSize, 0);
+        return false;
+    }
+    dataSize += record.champion.size() + record.checkpoint.size();
+
+    std::vector<char> entryBytes;
+    entryBytes.reserve(EntrySize);
+    BinaryWriter writer(entryBytes);
+    writeEntry(writer, record.entry);
+    indexFile.write(entryBytes.data(), static_cast<std::streamsize>(entryBytes.size()));
+    indexFile.flush();
+    if (!indexFile)
+    {
+        // A partly written entry would shift every later one, cut the index back to whole entries
+        reopenAfterFailedWrite(indexFile, basePath + ".idx", IndexHeaderSize, EntrySize);
+        return false;
+    }
+    return true;
+}
+
+// Reader
+
+PopulationArchiveReader::PopulationArchiveReader() : entryCount(0)
+{
+}
+
+bool PopulationArchiveReader::open(const std::string &archiveBasePath)
+{
+    close();
+    if (!dataFile.open(archiveBasePath + ".arc") || !indexFile.open(archiveBasePath + ".idx"))
+    {
+        close();
+        return false;
+    }
+
+    if (!checkHeader(dataFile.getData(), dataFile.getSize(), DataMagic, false) ||
+        !checkHeader(indexFile.getData(), indexFile.getSize(), IndexMagic, true))
+    {
+        LOG_WARNING("Archive: " << archiveBasePath << " is not a population archive of version " << ArchiveVersion);
+        close();
+        return false;
+    }
+
+    // A trailing partial entry (crash while appending) is ignored
+    entryCount = (indexFile.getSize() - IndexHeaderSize) / EntrySize;
+    return true;
+}
+
+void PopulationArchiveReader::close()
+{
+    dataFile.close();
+    indexFile.close();
+    entryCount = 0;
+}
+
+ArchiveEntry PopulationArchiveReader::getEntry(std::size_t index) const
+{
+    ArchiveEntry entry;
+    if (index >= entryCount)
+        return entry;
+
+    // Fixed size entries, so this is a direct seek into the mapping
+    BinaryReader reader(indexFile.getData() + IndexHeaderSize + index * EntrySize, EntrySize);
+    entry.generation = reader.readI32();
+    entry.populationSize = reader.readU32();
+    entry.bestFitness = reader.readF64();
+    entry.checkpointOffset = reader.readU64();
+    entry.checkpointSize = reader.readU64();
+    entry.championOffset = reader.readU64();
+    entry.championSize = reader.readU32();
+    entry.speciesCount = reader.readU32();
+    return entry;
+}
+
+bool PopulationArchiveReader::findGeneration(int generation, ArchiveEntry &entry) const
+{
+    // Newest first: generations repeat when a run was resumed from an older checkpoint
+    for (std::size_t i = entryCount; i > 0; --i)
+    {
+        ArchiveEntry candidate = getEntry(i - 1);
+        if (candidate.generation == generation)
+        {
+            entry = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PopulationArchiveReader::loadChampion(const ArchiveEntry &entry, NeuralNetwork &network) const
+{
+    if (entry.championOffset > dataFile.getSize() || entry.championSize > dataFile.getSize() - entry.championOffset)
+        return false;
+
+    BinaryReader reader(dataFile.getData() + entry.championOffset, entry.championSize);
+    return network.deserialize(reader);
+}
+
+bool PopulationArchiveReader::loadPopulation(const ArchiveEntry &entry, Population &population, TrainingState &state) const
+{
+    if (entry.checkpointOffset > dataFile.getSize() || entry.checkpointSize > dataFile.getSize() - entry.checkpointOffset)
+        return false;
+
+    return TrainingCheckpoint::decode(dataFile.getData() + entry.checkpointOffset,
+                                      static_cast<std::size_t>(entry.checkpointSize), population, state);
+}
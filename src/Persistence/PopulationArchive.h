@@ -0,0 +1,109 @@
+#pragma once
+#include "BackgroundWriter.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class NeuralNetwork;
+class Population;
+struct TrainingState;
+
+// Append-only archive of every generation: <base>.arc holds the records, <base>.idx one fixed size entry per record
+//
+// .arc: header (magic "RCAR", u32 version), then records back to back.
+//       A record is the champion genome followed by a TrainingCheckpoint of the evolved population.
+// .idx: header (magic "RCIX", u32 version, u32 entry size, u32 reserved), then 48 byte entries.
+//
+// A record is fully written before its index entry, so after a crash the index never points at missing data
+// (an unindexed record at the end of the .arc is just skipped space).
+
+// Index entry of one archived generation
+struct ArchiveEntry
+{
+    int generation;                   // Generation that was evaluated
+    std::uint32_t populationSize;
+    double bestFitness;               // Fitness of the champion
+    std::uint64_t checkpointOffset;   // Population after evolving this generation (resumes at generation + 1)
+    std::uint64_t checkpointSize;
+    std::uint64_t championOffset;     // Best genome of this generation
+    std::uint32_t championSize;
+    std::uint32_t speciesCount;
+
+    ArchiveEntry()
+        : generation(0), populationSize(0), bestFitness(0.0), checkpointOffset(0), checkpointSize(0),
+          championOffset(0), championSize(0), speciesCount(0)
+    {
+    }
+};
+
+// Appends generations on a background thread (the simulation only serializes)
+class PopulationArchiveWriter
+{
+private:
+    struct Record
+    {
+        ArchiveEntry entry; // Offsets are filled in by the writer
+        std::vector<char> champion;
+        std::vector<char> checkpoint;
+    };
+
+    std::string basePath;
+    std::ofstream dataFile;
+    std::ofstream indexFile;
+    std::uint64_t dataSize; // Where the next record starts
+    bool opened;
+
+    BackgroundWriter<Record> backgroundWriter;
+
+    void writeRecords(std::deque<Record> &records);
+    bool writeRecord(Record &record);
+
+public:
+    PopulationArchiveWriter();
+    ~PopulationArchiveWriter();
+
+    PopulationArchiveWriter(const PopulationArchiveWriter &) = delete;
+    PopulationArchiveWriter &operator=(const PopulationArchiveWriter &) = delete;
+
+    // Open (or create) <base>.arc and <base>.idx for appending
+    // Fails instead of starting over if the .arc holds records but the .idx is missing.
+    bool open(const std::string &archiveBasePath);
+
+    // Waits for queued records, then closes the files
+    void close();
+
+    bool isOpen() const { return opened; }
+
+    // Queue one generation (champion genome and TrainingCheckpoint bytes)
+    void append(int generation, std::uint32_t populationSize, std::uint32_t speciesCount, double bestFitness,
+                const NeuralNetwork &champion, std::vector<char> checkpoint);
+};
+
+// Memory maps an archive read-only, any generation is found through the index without parsing the others
+class PopulationArchiveReader
+{
+private:
+    MappedFile dataFile;
+    MappedFile indexFile;
+    std::size_t entryCount;
+
+public:
+    PopulationArchiveReader();
+
+    // Map <base>.arc and <base>.idx (shows the archive as it is now, open again to see newer generations)
+    bool open(const std::string &archiveBasePath);
+    void close();
+
+    std::size_t getEntryCount() const { return entryCount; }
+    ArchiveEntry getEntry(std::size_t index) const;
+
+    // Newest entry for a generation (a resumed run can archive a generation again), false if it isn't archived
+    bool findGeneration(int generation, ArchiveEntry &entry) const;
+
+    // Decode straight from the mapping
+    bool loadChampion(const ArchiveEntry &entry, NeuralNetwork &network) const;
+    bool loadPopulation(const ArchiveEntry &entry, Population &population, TrainingState &state) const;
+};
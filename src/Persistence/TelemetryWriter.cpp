@@ -0,0 +1,243 @@
+#include "TelemetryWriter.h"
+#include "BinaryIO.h"
+#include "../Logging/Logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+
+namespace
+{
+    // True if the file is missing or empty (a new file needs its header)
+    bool isNewFile(const std::string &path)
+    {
+        std::error_code error;
+        return !std::filesystem::exists(path, error) || std::filesystem::file_size(path, error) == 0;
+    }
+
+    void appendNumber(std::string &row, const char *format, double value)
+    {
+        char text[64];
+        int length = std::snprintf(text, sizeof(text), format, value);
+        if (length > 0)
+            row.append(text, static_cast<std::size_t>(std::min<int>(length, sizeof(text) - 1)));
+    }
+}
+
+TelemetryWriter::TelemetryWriter() : format(Format::Binary), opened(false)
+{
+}
+
+TelemetryWriter::~TelemetryWriter()
+{
+    close();
+}
+
+bool TelemetryWriter::open(const std::string &basePath, Format fileFormat)
+{
+    close();
+    format = fileFormat;
+
+    std::error_code error;
+    std::filesystem::path parent = std::filesystem::path(basePath).parent_path();
+    if (!parent.empty())
+        std::filesystem::create_directories(parent, error);
+
+    if (format == Format::Binary)
+    {
+        std::string path = basePath + ".rctl";
+        bool newFile = isNewFile(path);
+        if (!newFile)
+        {
+            // Only append to a telemetry file of this version
+            char header[8] = {};
+            std::ifstream existing(path, std::ios::binary);
+            existing.read(header, sizeof(header));
+            BinaryReader reader(header, existing ? sizeof(header) : 0);
+            if (reader.readU32() != Magic || reader.readU32() != Version)
+            {
+                LOG_WARNING("Telemetry: " << path << " is not a telemetry file of version " << Version);
+                return false;
+            }
+        }
+
+        carsFile.open(path, std::ios::binary | std::ios::app);
+        if (newFile && carsFile)
+        {
+            std::vector<char> header;
+            BinaryWriter writer(header);
+            writer.writeU32(Magic);
+            writer.writeU32(Version);
+            carsFile.write(header.data(), static_cast<std::streamsize>(header.size()));
+        }
+    }
+    else
+    {
+        std::string carsPath = basePath + "_cars.csv";
+        std::string speciesPath = basePath + "_species.csv";
+        bool newCars = isNewFile(carsPath);
+        bool newSpecies = isNewFile(speciesPath);
+
+        carsFile.open(carsPath, std::ios::binary | std::ios::app);
+        speciesFile.open(speciesPath, std::ios::binary | std::ios::app);
+        if (newCars && carsFile)
+            carsFile << "generation,car,fitness,checkpoints,time_alive,species,genome_nodes,genome_connections\n";
+        if (newSpecies && speciesFile)
+            speciesFile << "generation,species,size,average_fitness,best_fitness,staleness\n";
+    }
+
+    if (!carsFile || (format == Format::Csv && !speciesFile))
+    {
+        LOG_WARNING("Telemetry: could not open " << basePath);
+        carsFile.close();
+        speciesFile.close();
+        return false;
+    }
+
+    backgroundWriter.start([this](std::deque<GenerationTelemetry> &generations)
+                           { writeGenerations(generations); });
+    opened = true;
+    return true;
+}
+
+void TelemetryWriter::close()
+{
+    if (!opened)
+        return;
+
+    backgroundWriter.stop();
+    carsFile.close();
+    speciesFile.close();
+    opened = false;
+}
+
+void TelemetryWriter::append(GenerationTelemetry telemetry)
+{
+    if (!opened)
+        return;
+
+    // Every car column has a value per car, so the encoders need no checks
+    std::size_t carCount = telemetry.fitness.size();
+    telemetry.checkpoints.resize(carCount, 0);
+    telemetry.timeAlive.resize(carCount, 0.0f);
+    telemetry.species.resize(carCount, -1);
+    telemetry.genomeNodes.resize(carCount, 0);
+    telemetry.genomeConnections.resize(carCount, 0);
+
+    std::size_t speciesCount = telemetry.speciesId.size();
+    telemetry.speciesSize.resize(speciesCount, 0);
+    telemetry.speciesAverageFitness.resize(speciesCount, 0.0);
+    telemetry.speciesBestFitness.resize(speciesCount, 0.0);
+    telemetry.speciesStaleness.resize(speciesCount, 0);
+
+    backgroundWriter.push(std::move(telemetry));
+}
+
+void TelemetryWriter::writeGenerations(std::deque<GenerationTelemetry> &generations)
+{
+    // Everything that queued up goes out in one write per file
+    binary.clear();
+    carRows.clear();
+    speciesRows.clear();
+    for (const auto &telemetry : generations)
+    {
+        if (format == Format::Binary)
+            encodeBinary(telemetry, binary);
+        else
+            encodeCsv(telemetry, carRows, speciesRows);
+    }
+
+    if (format == Format::Binary)
+    {
+        carsFile.write(binary.data(), static_cast<std::streamsize>(binary.size()));
+    }
+    else
+    {
+        carsFile.write(carRows.data(), static_cast<std::streamsize>(carRows.size()));
+        speciesFile.write(speciesRows.data(), static_cast<std::streamsize>(speciesRows.size()));
+        speciesFile.flush();
+    }
+    carsFile.flush();
+
+    if (!carsFile || (format == Format::Csv && !speciesFile))
+    {
+        LOG_ERROR("Telemetry: write failed");
+        carsFile.clear();
+        speciesFile.clear();
+    }
+}
+
+void TelemetryWriter::encodeBinary(const GenerationTelemetry &telemetry, std::vector<char> &output)
+{
+    std::uint32_t carCount = static_cast<std::uint32_t>(telemetry.fitness.size());
+    std::uint32_t speciesCount = static_cast<std::uint32_t>(telemetry.speciesId.size());
+
+    BinaryWriter writer(output);
+    writer.writeU32(16 + carCount * 28 + speciesCount * 28);
+    writer.writeI32(telemetry.generation);
+    writer.writeF32(telemetry.generationTime);
+    writer.writeU32(carCount);
+    writer.writeU32(speciesCount);
+
+    for (double value : telemetry.fitness)
+        writer.writeF64(value);
+    for (std::int32_t value : telemetry.checkpoints)
+        writer.writeI32(value);
+    for (float value : telemetry.timeAlive)
+        writer.writeF32(value);
+    for (std::int32_t value : telemetry.species)
+        writer.writeI32(value);
+    for (std::uint32_t value : telemetry.genomeNodes)
+        writer.writeU32(value);
+    for (std::uint32_t value : telemetry.genomeConnections)
+        writer.writeU32(value);
+
+    for (std::int32_t value : telemetry.speciesId)
+        writer.writeI32(value);
+    for (std::uint32_t value : telemetry.speciesSize)
+        writer.writeU32(value);
+    for (double value : telemetry.speciesAverageFitness)
+        writer.writeF64(value);
+    for (double value : telemetry.speciesBestFitness)
+        writer.writeF64(value);
+    for (std::int32_t value : telemetry.speciesStaleness)
+        writer.writeI32(value);
+}
+
+void TelemetryWriter::encodeCsv(const GenerationTelemetry &telemetry, std::string &carRows, std::string &speciesRows)
+{
+    std::string generation = std::to_string(telemetry.generation) + ",";
+
+    for (std::size_t i = 0; i < telemetry.fitness.size(); ++i)
+    {
+        carRows += generation;
+        carRows += std::to_string(i);
+        carRows += ',';
+        appendNumber(carRows, "%.3f", telemetry.fitness[i]);
+        carRows += ',';
+        carRows += std::to_string(telemetry.checkpoints[i]);
+        carRows += ',';
+        appendNumber(carRows, "%.2f", telemetry.timeAlive[i]);
+        carRows += ',';
+        carRows += std::to_string(telemetry.species[i]);
+        carRows += ',';
+        carRows += std::to_string(telemetry.genomeNodes[i]);
+        carRows += ',';
+        carRows += std::to_string(telemetry.genomeConnections[i]);
+        carRows += '\n';
+    }
+
+    for (std::size_t i = 0; i < telemetry.speciesId.size(); ++i)
+    {
+        speciesRows += generation;
+        speciesRows += std::to_string(telemetry.speciesId[i]);
+        speciesRows += ',';
+        speciesRows += std::to_string(telemetry.speciesSize[i]);
+        speciesRows += ',';
+        appendNumber(speciesRows, "%.3f", telemetry.speciesAverageFitness[i]);
+        speciesRows += ',';
+        appendNumber(speciesRows, "%.3f", telemetry.speciesBestFitness[i]);
+        speciesRows += ',';
+        speciesRows += std::to_string(telemetry.speciesStaleness[i]);
+        speciesRows += '\n';
+    }
+}
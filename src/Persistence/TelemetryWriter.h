@@ -0,0 +1,88 @@
+#pragma once
+#include "BackgroundWriter.h"
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// One evaluated generation, stored by column like the files
+struct GenerationTelemetry
+{
+    int generation;
+    float generationTime;
+
+    // Per car, all parallel
+    std::vector<double> fitness;
+    std::vector<std::int32_t> checkpoints;
+    std::vector<float> timeAlive;
+    std::vector<std::int32_t> species;         // Species id (-1 if unknown)
+    std::vector<std::uint32_t> genomeNodes;    // Input, hidden and output nodes
+    std::vector<std::uint32_t> genomeConnections;
+
+    // Per species, all parallel
+    std::vector<std::int32_t> speciesId;
+    std::vector<std::uint32_t> speciesSize;
+    std::vector<double> speciesAverageFitness;
+    std::vector<double> speciesBestFitness;
+    std::vector<std::int32_t> speciesStaleness;
+
+    GenerationTelemetry() : generation(0), generationTime(0.0f) {}
+};
+
+// Appends per car and per species rows of every generation, encoding and writing happen on a background thread
+//
+// Binary (<base>.rctl, little endian): magic "RCTL", u32 version, then one block per generation:
+// u32 block size (bytes after this field), i32 generation, f32 generation time, u32 car count, u32 species count,
+// car columns (f64 fitness, i32 checkpoints, f32 time alive, i32 species, u32 genome nodes, u32 genome connections),
+// species columns (i32 id, u32 size, f64 average fitness, f64 best fitness, i32 staleness).
+// Each column is stored contiguously, so one value of every car is read without touching the others.
+//
+// CSV: <base>_cars.csv and <base>_species.csv, one row per car / species with the generation in the first column.
+class TelemetryWriter
+{
+public:
+    enum class Format
+    {
+        Binary,
+        Csv
+    };
+
+    static constexpr std::uint32_t Magic = 0x4C544352; // "RCTL" in file order
+    static constexpr std::uint32_t Version = 1;
+
+private:
+    Format format;
+    std::ofstream carsFile;    // Binary: the only file
+    std::ofstream speciesFile; // CSV only
+    bool opened;
+
+    // Encoding buffers of the writer thread, they keep their capacity between writes
+    std::vector<char> binary;
+    std::string carRows;
+    std::string speciesRows;
+
+    BackgroundWriter<GenerationTelemetry> backgroundWriter;
+
+    void writeGenerations(std::deque<GenerationTelemetry> &generations);
+    static void encodeBinary(const GenerationTelemetry &telemetry, std::vector<char> &output);
+    static void encodeCsv(const GenerationTelemetry &telemetry, std::string &carRows, std::string &speciesRows);
+
+public:
+    TelemetryWriter();
+    ~TelemetryWriter();
+
+    TelemetryWriter(const TelemetryWriter &) = delete;
+    TelemetryWriter &operator=(const TelemetryWriter &) = delete;
+
+    // Open (or create) the files for appending
+    bool open(const std::string &basePath, Format fileFormat = Format::Binary);
+
+    // Waits for queued generations, then closes the files
+    void close();
+
+    bool isOpen() const { return opened; }
+
+    // Queue one generation, returns immediately
+    void append(GenerationTelemetry telemetry);
+};
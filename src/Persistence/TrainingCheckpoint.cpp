@@ -0,0 +1,80 @@
+#include "TrainingCheckpoint.h"
+#include "BinaryIO.h"
+#include "../AI/Population.h"
+#include "../AI/Random.h"
+#include "../Logging/Logger.h"
+
+std::vector<char> TrainingCheckpoint::encode(const Population &population, const TrainingState &state)
+{
+    std::vector<char> data;
+    BinaryWriter writer(data);
+
+    writer.writeU32(Magic);
+    writer.writeU32(Version);
+    writer.writeString(Random::getState());
+
+    writer.writeI32(state.bestFitnessGeneration);
+    writer.writeI32(state.raceLaps);
+
+    population.serialize(writer);
+
+    writer.writeU32(fnv1a(data.data(), data.size()));
+    return data;
+}
+
+bool TrainingCheckpoint::decode(const std::vector<char> &data, Population &population, TrainingState &state)
+{
+    return decode(data.data(), data.size(), population, state);
+}
+
+bool TrainingCheckpoint::decode(const char *data, std::size_t size, Population &population, TrainingState &state)
+{
+    if (size < 12)
+    {
+        LOG_WARNING("Checkpoint: file is too small");
+        return false;
+    }
+
+    // Verify the checksum before trusting any field
+    std::size_t payloadSize = size - 4;
+    BinaryReader checksumReader(data + payloadSize, 4);
+    if (checksumReader.readU32() != fnv1a(data, payloadSize))
+    {
+        LOG_WARNING("Checkpoint: checksum mismatch, the file is damaged");
+        return false;
+    }
+
+    BinaryReader reader(data, payloadSize);
+    if (reader.readU32() != Magic)
+    {
+        LOG_WARNING("Checkpoint: not a training checkpoint");
+        return false;
+    }
+
+    std::uint32_t version = reader.readU32();
+    if (version != Version)
+    {
+        LOG_WARNING("Checkpoint: unsupported version " << version << " (expected " << Version << ")");
+        return false;
+    }
+
+    std::string randomState = reader.readString();
+
+    TrainingState loadedState;
+    loadedState.bestFitnessGeneration = reader.readI32();
+    loadedState.raceLaps = reader.readI32();
+
+    // The population is the last thing that can fail, it only changes when fully valid
+    if (!reader.ok() || !population.deserialize(reader))
+    {
+        LOG_WARNING("Checkpoint: invalid population data");
+        return false;
+    }
+
+    // A random state from another standard library may not parse, training still resumes
+    if (!Random::setState(randomState))
+        LOG_WARNING("Checkpoint: random state not restored");
+
+    state = loadedState;
+    return true;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Population;
+
+// Game counters saved next to the population
+struct TrainingState
+{
+    int bestFitnessGeneration;
+    int raceLaps;
+
+    TrainingState() : bestFitnessGeneration(0), raceLaps(1) {}
+};
+
+// Versioned binary training checkpoint
+// Layout: magic "RCKP", u32 version, random engine state, TrainingState, Population, u32 FNV-1a checksum of everything before it.
+// A resumed run continues with the same genomes, species, innovation history and random sequence.
+class TrainingCheckpoint
+{
+public:
+    static constexpr std::uint32_t Magic = 0x504B4352; // "RCKP" in file order
+    static constexpr std::uint32_t Version = 2; // 2: species ids and the next species id
+
+    // Serialize on the simulation thread (fast, no I/O), the bytes are written elsewhere
+    static std::vector<char> encode(const Population &population, const TrainingState &state);
+
+    // Restore population, state and random engine; nothing changes unless the whole checkpoint is valid
+    static bool decode(const std::vector<char> &data, Population &population, TrainingState &state);
+    static bool decode(const char *data, std::size_t size, Population &population, TrainingState &state);
+};
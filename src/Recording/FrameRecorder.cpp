@@ -0,0 +1,209 @@
+#include "FrameRecorder.h"
+#include "../Logging/Logger.h"
+#include <cmath>
+#include <ctime>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+
+FrameRecorder::FrameRecorder()
+    : recording(false), captureInterval(1), queueLimit(1), waitForWriter(false), writtenFrames(0), droppedFrames(0),
+      failedFrames(0), frameIndex(0)
+{
+}
+
+FrameRecorder::~FrameRecorder()
+{
+    stop();
+}
+
+bool FrameRecorder::start(const RecordingSettings &recordingSettings, sf::Vector2u frameSize)
+{
+    if (recording)
+        return true;
+
+    settings = recordingSettings;
+    if (settings.frameSkip < 1)
+        settings.frameSkip = 1;
+    if (!(settings.tickRate > 0.0f))
+        settings.tickRate = 60.0f;
+    if (settings.maxQueuedFrames < 1)
+        settings.maxQueuedFrames = 1;
+
+    if (!texture.resize(frameSize))
+    {
+        LOG_WARNING("Recording: could not create a " << frameSize.x << "x" << frameSize.y << " render texture");
+        return false;
+    }
+
+    // One folder per recording, named after the start time
+    std::time_t now = std::time(nullptr);
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "run_%Y%m%d_%H%M%S", std::localtime(&now));
+    outputDirectory = (std::filesystem::path(settings.directory) / stamp).string();
+
+    std::error_code error;
+    std::filesystem::create_directories(outputDirectory, error);
+    if (error)
+    {
+        LOG_WARNING("Recording: could not create " << outputDirectory << ": " << error.message());
+        return false;
+    }
+
+    // Describe the frames so they can be turned into a video later
+    // Most frame skips don't divide the tick rate, ffmpeg gets the rate as an exact fraction (60/7) so the video keeps time
+    double framesPerSecond = static_cast<double>(settings.tickRate) / settings.frameSkip;
+    std::ostringstream frameRate;
+    if (settings.tickRate == std::floor(settings.tickRate))
+        frameRate << static_cast<long>(settings.tickRate) << "/" << settings.frameSkip;
+    else
+        frameRate << std::setprecision(9) << framesPerSecond;
+
+    std::ofstream info(std::filesystem::path(outputDirectory) / "recording.txt");
+    info << "width " << frameSize.x << "\n";
+    info << "height " << frameSize.y << "\n";
+    info << "frame_skip " << settings.frameSkip << "\n";
+    info << "fps " << std::setprecision(9) << framesPerSecond << "\n";
+    if (settings.format == FrameFormat::RawRGBA)
+    {
+        info << "format rgba\n";
+        info << "# ffmpeg -f rawvideo -pix_fmt rgba -s " << frameSize.x << "x" << frameSize.y
+             << " -r " << frameRate.str() << " -i frames.rgba -pix_fmt yuv420p run.mp4\n";
+    }
+    else
+    {
+        info << "format png\n";
+        info << "# ffmpeg -framerate " << frameRate.str() << " -i frame_%06d.png -pix_fmt yuv420p run.mp4\n";
+    }
+
+    if (settings.format == FrameFormat::RawRGBA)
+        rawFile.open(std::filesystem::path(outputDirectory) / "frames.rgba", std::ios::binary | std::ios::trunc);
+    indexFile.open(std::filesystem::path(outputDirectory) / "frames.csv", std::ios::trunc);
+    indexFile << "frame,tick\n";
+
+    writtenFrames = 0;
+    droppedFrames = 0;
+    failedFrames = 0;
+    frameIndex = 0;
+    captureInterval = settings.frameSkip;
+    queueLimit = settings.maxQueuedFrames;
+    waitForWriter = settings.waitForWriter;
+
+    backgroundWriter.start([this](std::deque<Frame> &frames)
+                           { writeFrames(frames); });
+    recording = true;
+
+    LOG_INFO("Recording to " << outputDirectory);
+    return true;
+}
+
+void FrameRecorder::stop()
+{
+    if (!recording)
+        return;
+
+    // No new ticks are selected, let the writer drain the queue, then wait for it
+    recording = false;
+    backgroundWriter.stop();
+    rawFile.close();
+    indexFile.close();
+
+    if (Logger::isEnabled(LogLevel::Info))
+    {
+        LogLine summary;
+        summary << "Recording stopped: " << writtenFrames << " frames written, " << droppedFrames << " dropped";
+        if (failedFrames > 0)
+        {
+            summary << ", " << failedFrames << " failed";
+        }
+        Logger::write(LogLevel::Info, summary);
+    }
+}
+
+bool FrameRecorder::shouldCapture(unsigned long long tick, std::size_t pendingFrames)
+{
+    if (!recording || tick % static_cast<unsigned long long>(captureInterval) != 0)
+        return false;
+
+    std::size_t limit = queueLimit;
+    if (waitForWriter)
+    {
+        backgroundWriter.waitUntilQueuedBelow(limit);
+        return true;
+    }
+
+    // Skip the frame entirely (no render, no readback) if the renderer or the writer can't keep up
+    if (pendingFrames + backgroundWriter.getQueued() >= limit)
+    {
+        droppedFrames++;
+        return false;
+    }
+    return true;
+}
+
+sf::RenderTarget &FrameRecorder::beginFrame()
+{
+    return texture;
+}
+
+void FrameRecorder::endFrame(unsigned long long tick)
+{
+    // GPU readback happens here, encoding and disk writes on the writer thread
+    texture.display();
+    Frame frame;
+    frame.tick = tick;
+    frame.image = texture.getTexture().copyToImage();
+
+    backgroundWriter.push(std::move(frame));
+}
+
+void FrameRecorder::writeFrames(std::deque<Frame> &frames)
+{
+    for (const Frame &frame : frames)
+    {
+        if (writeFrame(frame))
+        {
+            writtenFrames++;
+            frameIndex++;
+        }
+        else
+        {
+            failedFrames++;
+        }
+    }
+}
+
+bool FrameRecorder::writeFrame(const Frame &frame)
+{
+    if (settings.format == FrameFormat::RawRGBA)
+    {
+        sf::Vector2u size = frame.image.getSize();
+        std::streamsize frameBytes = static_cast<std::streamsize>(size.x) * size.y * 4;
+        rawFile.write(reinterpret_cast<const char *>(frame.image.getPixelsPtr()), frameBytes);
+        if (!rawFile)
+        {
+            // Cut a partly written frame off so the file keeps matching frames.csv, the next frame may succeed
+            std::filesystem::path rawPath = std::filesystem::path(outputDirectory) / "frames.rgba";
+            rawFile.clear();
+            rawFile.close();
+            std::error_code error;
+            std::filesystem::resize_file(rawPath, static_cast<std::uintmax_t>(frameBytes) * frameIndex, error);
+            rawFile.open(rawPath, std::ios::binary | std::ios::app);
+            if (failedFrames == 0)
+            {
+                LOG_WARNING("Recording: could not write frame " << frameIndex << " to " << rawPath.string());
+            }
+            return false;
+        }
+    }
+    else
+    {
+        std::ostringstream name;
+        name << "frame_" << std::setw(6) << std::setfill('0') << frameIndex << ".png";
+        if (!frame.image.saveToFile(std::filesystem::path(outputDirectory) / name.str()))
+            return false;
+    }
+
+    indexFile << frameIndex << "," << frame.tick << "\n";
+    return true;
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include "../Persistence/BackgroundWriter.h"
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <fstream>
+#include <string>
+
+// How captured frames are written
+enum class FrameFormat
+{
+    PngSequence, // frame_000000.png, frame_000001.png, ...
+    RawRGBA      // All frames appended to frames.rgba (for ffmpeg -f rawvideo -pix_fmt rgba)
+};
+
+struct RecordingSettings
+{
+    std::string directory;       // A new run_<date>_<time> folder is created in here
+    FrameFormat format;
+    int frameSkip;               // Capture every frameSkip-th simulation tick
+    float tickRate;              // Simulation ticks per second, the video plays at tickRate / frameSkip
+    std::size_t maxQueuedFrames; // Frames waiting to be rendered or written, new frames are dropped beyond this
+    bool waitForWriter;          // Hold the simulation instead of dropping frames (headless, nothing has to stay smooth)
+
+    RecordingSettings()
+        : directory("../../Recordings"), format(FrameFormat::PngSequence), frameSkip(2), tickRate(60.0f), maxQueuedFrames(8),
+          waitForWriter(false)
+    {
+    }
+};
+
+// Off-screen recording of simulation ticks
+// The simulation selects every frameSkip-th tick, the thread that renders draws each selected tick into a render texture
+// and reads it back, a background thread encodes and writes the frames so disk I/O never stalls rendering or the simulation.
+// shouldCapture is called from the simulation thread, everything else from the thread that renders
+// (the same thread in a headless game).
+class FrameRecorder
+{
+private:
+    struct Frame
+    {
+        unsigned long long tick;
+        sf::Image image;
+    };
+
+    RecordingSettings settings;
+    sf::RenderTexture texture;
+    std::atomic<bool> recording;
+    std::string outputDirectory;
+
+    // Tick selection, read by the simulation thread (copied from the settings before recording starts)
+    std::atomic<int> captureInterval;
+    std::atomic<std::size_t> queueLimit;
+    std::atomic<bool> waitForWriter;
+
+    // Statistics
+    std::atomic<std::size_t> writtenFrames;
+    std::atomic<std::size_t> droppedFrames;
+    std::atomic<std::size_t> failedFrames;
+
+    // Writer side (only touched by the writer thread while recording)
+    std::ofstream rawFile;
+    std::ofstream indexFile; // Maps frame numbers to simulation ticks
+    std::size_t frameIndex;
+
+    // Bounded by settings.maxQueuedFrames (see shouldCapture)
+    BackgroundWriter<Frame> backgroundWriter;
+
+    void writeFrames(std::deque<Frame> &frames);
+    bool writeFrame(const Frame &frame);
+
+public:
+    FrameRecorder();
+    ~FrameRecorder();
+
+    FrameRecorder(const FrameRecorder &) = delete;
+    FrameRecorder &operator=(const FrameRecorder &) = delete;
+
+    // Start recording frames of the given size, returns false if the texture or folder can't be created
+    bool start(const RecordingSettings &recordingSettings, sf::Vector2u frameSize);
+
+    // Stop recording, waits until every queued frame is written
+    void stop();
+
+    bool isRecording() const { return recording; }
+
+    // Simulation thread, once per tick: true if the tick is to be rendered and handed to endFrame
+    // pendingFrames are selected ticks that weren't handed over yet, with those and the writer's queue full
+    // the tick is dropped and counted (or the call waits for the writer, see RecordingSettings::waitForWriter).
+    bool shouldCapture(unsigned long long tick, std::size_t pendingFrames);
+
+    // Target to render the frame into
+    sf::RenderTarget &beginFrame();
+
+    // Read the frame back and hand it to the writer
+    void endFrame(unsigned long long tick);
+
+    // Statistics
+    std::size_t getWrittenFrames() const { return writtenFrames; }
+    std::size_t getDroppedFrames() const { return droppedFrames; }
+    const std::string &getOutputDirectory() const { return outputDirectory; }
+};
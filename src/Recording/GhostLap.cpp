@@ -0,0 +1,82 @@
+#include "GhostLap.h"
+#include "ReplayPlayer.h"
+#include "../Car/car.h"
+#include <algorithm>
+#include <cmath>
+
+GhostLap::GhostLap() : generation(0), fitness(0.0), keyframeInterval(0.1f), duration(0.0f)
+{
+}
+
+bool GhostLap::buildFromReplay(const ReplayData &replay, std::size_t carIndex, const Track &track,
+                               const VehicleParams &params, int ticksPerKeyframe)
+{
+    if (carIndex >= replay.cars.size() || replay.tickCount == 0)
+        return false;
+
+    ticksPerKeyframe = std::max(1, ticksPerKeyframe);
+    const ReplayCar &recorded = replay.cars[carIndex];
+
+    // Only drive the car that becomes the ghost
+    ReplayData single;
+    single.trackId = replay.trackId;
+    single.seed = replay.seed;
+    single.generation = replay.generation;
+    single.simulationStep = replay.simulationStep;
+    single.vehicleClass = replay.vehicleClass;
+    single.tickCount = std::max<std::uint32_t>(recorded.activeTicks, 1);
+    single.cars.push_back(recorded);
+
+    generation = replay.generation;
+    fitness = recorded.fitness;
+    keyframeInterval = replay.simulationStep * ticksPerKeyframe;
+    duration = single.tickCount * replay.simulationStep;
+
+    ReplayPlayer player;
+    player.start(std::move(single), params);
+
+    keyframes.clear();
+    keyframes.reserve(player.getReplay().tickCount / ticksPerKeyframe + 2);
+    const Car &car = *player.getCars()[0];
+    keyframes.push_back({car.getX(), car.getY(), car.getRotation()});
+
+    bool playing = true;
+    while (playing)
+    {
+        playing = player.step(track);
+        if (player.getTick() % ticksPerKeyframe == 0 || !playing)
+            keyframes.push_back({car.getX(), car.getY(), car.getRotation()});
+    }
+
+    return true;
+}
+
+bool GhostLap::getPose(float time, GhostPose &pose) const
+{
+    if (keyframes.empty() || time < 0.0f || time > duration)
+        return false;
+
+    float position = time / keyframeInterval;
+    std::size_t index = std::min(static_cast<std::size_t>(position), keyframes.size() - 1);
+    if (index + 1 >= keyframes.size())
+    {
+        pose = keyframes.back();
+        return true;
+    }
+
+    const GhostPose &from = keyframes[index];
+    const GhostPose &to = keyframes[index + 1];
+
+    // The last keyframe is the end of the run, it can be closer than one interval
+    float segmentStart = index * keyframeInterval;
+    float segmentLength = index + 2 == keyframes.size() ? duration - segmentStart : keyframeInterval;
+    float t = segmentLength > 0.0f ? std::min(1.0f, (time - segmentStart) / segmentLength) : 1.0f;
+
+    // Turn the short way round when the heading wraps
+    float turn = std::remainder(to.rotation - from.rotation, 360.0f);
+
+    pose.x = from.x + (to.x - from.x) * t;
+    pose.y = from.y + (to.y - from.y) * t;
+    pose.rotation = from.rotation + turn * t;
+    return true;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include "ReplayFile.h"
+#include <cstddef>
+#include <vector>
+
+class Track;
+
+// Pose of a ghost car at one keyframe
+struct GhostPose
+{
+    float x, y;
+    float rotation; // Degrees
+};
+
+// A recorded car reduced to poses at a fixed interval
+// The replay is driven once when the ghost is built, afterwards showing it is an interpolation between two keyframes,
+// no physics and no network. At the default interval a one minute lap is about 7 KB.
+class GhostLap
+{
+private:
+    int generation;
+    double fitness;
+    float keyframeInterval; // Seconds between keyframes
+    float duration;         // The ghost disappears after this time (when the car crashed, finished or the recording ended)
+    std::vector<GhostPose> keyframes;
+
+public:
+    GhostLap();
+
+    // Drive one car of a replay (physics only) and keep the pose every ticksPerKeyframe ticks
+    // Returns false if the car isn't in the replay
+    bool buildFromReplay(const ReplayData &replay, std::size_t carIndex, const Track &track, const VehicleParams &params,
+                         int ticksPerKeyframe = 6);
+
+    // Pose at a time since the start of the run, false once the ghost is gone
+    bool getPose(float time, GhostPose &pose) const;
+
+    int getGeneration() const { return generation; }
+    double getFitness() const { return fitness; }
+    float getDuration() const { return duration; }
+    std::size_t getKeyframeCount() const { return keyframes.size(); }
+};
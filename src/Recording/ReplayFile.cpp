@@ -0,0 +1,289 @@
+#include "ReplayFile.h"
+#include "../Persistence/BinaryIO.h"
+#include "../Persistence/CheckpointWriter.h"
+#include "../Persistence/MappedFile.h"
+#include "../Logging/Logger.h"
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+
+namespace
+{
+    std::uint32_t floatBits(float value)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    float bitsToFloat(std::uint32_t bits)
+    {
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    // Neighbouring floats of the same sign have neighbouring bit patterns, so slowly changing inputs give small deltas
+    void writeInputDelta(BinaryWriter &writer, float previous, float current)
+    {
+        std::uint32_t delta = floatBits(current) - floatBits(previous);
+        std::uint32_t zigzag = (delta << 1) ^ (0u - (delta >> 31));
+        writer.writeVarU32(zigzag);
+    }
+
+    float readInputDelta(BinaryReader &reader, float previous)
+    {
+        std::uint32_t zigzag = reader.readVarU32();
+        std::uint32_t delta = (zigzag >> 1) ^ (0u - (zigzag & 1));
+        return bitsToFloat(floatBits(previous) + delta);
+    }
+
+    bool isValidInput(float value)
+    {
+        return value >= -1.0f && value <= 1.0f;
+    }
+
+    void writeState(BinaryWriter &writer, const VehicleState &state)
+    {
+        writer.writeF32(state.x);
+        writer.writeF32(state.y);
+        writer.writeF32(state.rotation);
+        writer.writeF32(state.velocity);
+        writer.writeF32(state.lateralVelocity);
+        writer.writeF32(state.yawRate);
+    }
+
+    void readState(BinaryReader &reader, VehicleState &state)
+    {
+        state.x = reader.readF32();
+        state.y = reader.readF32();
+        state.rotation = reader.readF32();
+        state.velocity = reader.readF32();
+        state.lateralVelocity = reader.readF32();
+        state.yawRate = reader.readF32();
+        if (!std::isfinite(state.x) || !std::isfinite(state.y) || !std::isfinite(state.rotation) ||
+            !std::isfinite(state.velocity) || !std::isfinite(state.lateralVelocity) || !std::isfinite(state.yawRate))
+            reader.fail();
+    }
+}
+
+std::vector<char> ReplayFile::encode(const ReplayData &replay)
+{
+    std::vector<char> data;
+    BinaryWriter writer(data);
+
+    writer.writeU32(Magic);
+    writer.writeU32(Version);
+    writer.writeU32(replay.trackId);
+    writer.writeU32(replay.seed);
+    writer.writeI32(replay.generation);
+    writer.writeF32(replay.simulationStep);
+    writer.writeString(replay.vehicleClass);
+    writer.writeU32(replay.tickCount);
+
+    writer.writeU32(static_cast<std::uint32_t>(replay.cars.size()));
+    for (const auto &car : replay.cars)
+    {
+        writer.writeI32(car.carIndex);
+        writer.writeF64(car.fitness);
+        writer.writeU32(car.activeTicks);
+        writeState(writer, car.startState);
+        writer.writeF32(car.startSteering);
+        writer.writeF32(car.startThrottle);
+
+        writer.writeU32(static_cast<std::uint32_t>(car.contacts.size()));
+        std::uint32_t previousTick = 0;
+        for (const auto &contact : car.contacts)
+        {
+            writer.writeVarU32(contact.tick - previousTick);
+            writeState(writer, contact.state);
+            previousTick = contact.tick;
+        }
+
+        float steering = car.startSteering;
+        float throttle = car.startThrottle;
+        for (std::uint32_t tick = 0; tick < replay.tickCount; ++tick)
+        {
+            writeInputDelta(writer, steering, car.steering[tick]);
+            writeInputDelta(writer, throttle, car.throttle[tick]);
+            steering = car.steering[tick];
+            throttle = car.throttle[tick];
+        }
+    }
+
+    writer.writeU32(fnv1a(data.data(), data.size()));
+    return data;
+}
+
+bool ReplayFile::decode(const char *data, std::size_t size, ReplayData &result)
+{
+    if (size < 8)
+    {
+        LOG_WARNING("Replay: file is too small");
+        return false;
+    }
+
+    // Verify the checksum before trusting any field
+    std::size_t payloadSize = size - 4;
+    BinaryReader checksumReader(data + payloadSize, 4);
+    if (checksumReader.readU32() != fnv1a(data, payloadSize))
+    {
+        LOG_WARNING("Replay: checksum mismatch, the file is damaged");
+        return false;
+    }
+
+    BinaryReader reader(data, payloadSize);
+    if (reader.readU32() != Magic)
+    {
+        LOG_WARNING("Replay: not a replay file");
+        return false;
+    }
+
+    std::uint32_t version = reader.readU32();
+    if (version != Version)
+    {
+        LOG_WARNING("Replay: unsupported version " << version << " (expected " << Version << ")");
+        return false;
+    }
+
+    ReplayData loaded;
+    loaded.trackId = reader.readU32();
+    loaded.seed = reader.readU32();
+    loaded.generation = reader.readI32();
+    loaded.simulationStep = reader.readF32();
+    loaded.vehicleClass = reader.readString();
+    loaded.tickCount = reader.readU32();
+    if (!(loaded.simulationStep > 0.0f) || !std::isfinite(loaded.simulationStep))
+        reader.fail();
+
+    // Every car takes at least 52 bytes plus two per tick, a count that doesn't fit the file is wrong
+    std::uint32_t carCount = reader.readCount(52);
+    if (reader.ok() && carCount > 0 && loaded.tickCount > reader.getRemaining() / carCount / 2)
+        reader.fail();
+
+    loaded.cars.resize(reader.ok() ? carCount : 0);
+    for (auto &car : loaded.cars)
+    {
+        car.carIndex = reader.readI32();
+        car.fitness = reader.readF64();
+        car.activeTicks = reader.readU32();
+        readState(reader, car.startState);
+        car.startSteering = reader.readF32();
+        car.startThrottle = reader.readF32();
+        if (car.activeTicks > loaded.tickCount || !isValidInput(car.startSteering) || !isValidInput(car.startThrottle))
+            reader.fail();
+
+        std::uint32_t contactCount = reader.readCount(25);
+        car.contacts.resize(contactCount);
+        std::uint32_t tick = 0;
+        for (std::size_t i = 0; i < car.contacts.size(); ++i)
+        {
+            std::uint32_t delta = reader.readVarU32();
+            if ((i > 0 && delta == 0) || delta >= loaded.tickCount - tick)
+                reader.fail();
+            tick += delta;
+            car.contacts[i].tick = tick;
+            readState(reader, car.contacts[i].state);
+        }
+
+        if (!reader.ok())
+            break;
+
+        car.steering.resize(loaded.tickCount);
+        car.throttle.resize(loaded.tickCount);
+        float steering = car.startSteering;
+        float throttle = car.startThrottle;
+        for (std::uint32_t i = 0; i < loaded.tickCount; ++i)
+        {
+            steering = readInputDelta(reader, steering);
+            throttle = readInputDelta(reader, throttle);
+            car.steering[i] = steering;
+            car.throttle[i] = throttle;
+            if (!isValidInput(steering) || !isValidInput(throttle))
+                reader.fail();
+        }
+    }
+
+    if (!reader.ok() || reader.getRemaining() != 0)
+    {
+        LOG_WARNING("Replay: invalid replay data");
+        return false;
+    }
+
+    result = std::move(loaded);
+    return true;
+}
+
+bool ReplayFile::save(const std::string &path, const ReplayData &replay)
+{
+    if (!CheckpointWriter::writeFileAtomically(path, encode(replay)))
+        return false;
+
+    LOG_INFO("Replay saved to " << path);
+    return true;
+}
+
+bool ReplayFile::load(const std::string &path, ReplayData &result)
+{
+    MappedFile file;
+    if (!file.open(path))
+        return false;
+
+    return decode(file.getData(), file.getSize(), result);
+}
+
+std::string ReplayFile::makeRunName()
+{
+    auto now = std::chrono::system_clock::now();
+    std::time_t seconds = std::chrono::system_clock::to_time_t(now);
+    int milliseconds = static_cast<int>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000);
+
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "run_%Y%m%d_%H%M%S", std::localtime(&seconds));
+    char name[40];
+    std::snprintf(name, sizeof(name), "%s_%03d", stamp, milliseconds);
+    return name;
+}
+
+std::string ReplayFile::makePath(const std::string &directory, const std::string &runName, int generation,
+                                 const std::set<std::string> &takenPaths)
+{
+    char fileName[64];
+    std::snprintf(fileName, sizeof(fileName), "%s_generation_%06d", runName.c_str(), generation);
+    std::filesystem::path base = std::filesystem::path(directory) / fileName;
+
+    // A generation saved twice (a checkpoint was loaded again) or a run started in the same millisecond
+    // gets a numbered name, which sorts after the first one
+    std::filesystem::path path = base.string() + ".rcrp";
+    std::error_code error;
+    for (int copy = 2; takenPaths.count(path.string()) > 0 || std::filesystem::exists(path, error); ++copy)
+        path = base.string() + "_" + std::to_string(copy) + ".rcrp";
+    return path.string();
+}
+
+std::string ReplayFile::getRunName(const std::string &path)
+{
+    std::string stem = std::filesystem::path(path).stem().string();
+    std::size_t end = stem.find("_generation_");
+    return end == std::string::npos ? std::string() : stem.substr(0, end);
+}
+
+std::vector<std::string> ReplayFile::findFiles(const std::string &directory, const std::string &runName)
+{
+    std::vector<std::string> files;
+    std::error_code error;
+    for (std::filesystem::directory_iterator it(directory, error), end; !error && it != end; it.increment(error))
+    {
+        if (it->is_regular_file(error) && it->path().extension() == ".rcrp" &&
+            (runName.empty() || getRunName(it->path().string()) == runName))
+            files.push_back(it->path().string());
+    }
+
+    std::sort(files.begin(), files.end());
+    return files;
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include "../Car/VehicleDynamics.h"
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
+// State of a car after car-to-car contacts moved it (contacts aren't replayed, their result is stored)
+struct ReplayContact
+{
+    std::uint32_t tick;
+    VehicleState state;
+};
+
+// Control inputs of one recorded car
+struct ReplayCar
+{
+    int carIndex;             // Index in the population when it was recorded
+    double fitness;           // Fitness at the end of the recording
+    std::uint32_t activeTicks; // Ticks until the car crashed or finished (it keeps rolling afterwards)
+
+    VehicleState startState;
+    float startSteering;
+    float startThrottle;
+
+    // Inputs set in each tick (applied by the next tick's update), one value per tick
+    std::vector<float> steering;
+    std::vector<float> throttle;
+    std::vector<ReplayContact> contacts; // Sorted by tick
+
+    ReplayCar() : carIndex(-1), fitness(0.0), activeTicks(0), startSteering(0.0f), startThrottle(0.0f) {}
+};
+
+// One recorded run: everything needed to drive the cars again through the same physics
+struct ReplayData
+{
+    std::uint32_t trackId; // Track::getLayoutId() of the track it was recorded on
+    std::uint32_t seed;    // Fingerprint of the evolution random state when the recording began
+    int generation;
+    float simulationStep;
+    std::string vehicleClass; // Class in Config/vehicles.ini the cars used
+    std::uint32_t tickCount;
+    std::vector<ReplayCar> cars;
+
+    ReplayData() : trackId(0), seed(0), generation(0), simulationStep(1.0f / 60.0f), tickCount(0) {}
+};
+
+// Replay file (.rcrp, little endian)
+//
+// Layout: magic "RCRP", u32 version, u32 track id, u32 seed, i32 generation, f32 step, string vehicle class,
+// u32 tick count, u32 car count, per car: i32 index, f64 fitness, u32 active ticks, f32 x6 start state,
+// f32 start steering, f32 start throttle, u32 contact count, per contact: varint tick delta and f32 x6 state,
+// then per tick: varint steering delta, varint throttle delta.
+// Ends with a u32 FNV-1a checksum of everything before it.
+//
+// Inputs are stored exactly: each delta is the difference of the float's bit pattern to the previous tick's,
+// zigzag and varint encoded. Inputs that hold still (saturated or a crashed car) take one byte, smooth
+// steering two or three, so a one minute lap of a car takes around twenty kilobytes.
+class ReplayFile
+{
+public:
+    static constexpr std::uint32_t Magic = 0x50524352; // "RCRP" in file order
+    static constexpr std::uint32_t Version = 1;
+
+    static std::vector<char> encode(const ReplayData &replay);
+    static bool decode(const char *data, std::size_t size, ReplayData &result);
+
+    // Written atomically
+    static bool save(const std::string &path, const ReplayData &replay);
+
+    // Result is only changed when the whole file is valid
+    static bool load(const std::string &path, ReplayData &result);
+
+    // Replays are named <run>_generation_<n>.rcrp, the run name starts with the time the run started,
+    // so sorting by name puts runs in the order they started and each run's files in generation order
+
+    // Name for a new run: run_<date>_<time>_<milliseconds>
+    static std::string makeRunName();
+
+    // Path for a run's replay of a generation, never the path of an existing file or one in takenPaths
+    // (files queued for writing but not on disk yet)
+    static std::string makePath(const std::string &directory, const std::string &runName, int generation,
+                                const std::set<std::string> &takenPaths = {});
+
+    // Run a replay belongs to, empty for files named generation_<n>.rcrp by older versions
+    static std::string getRunName(const std::string &path);
+
+    // Replay files in a folder sorted by name (oldest first), only those of one run if a run name is given,
+    // empty if there is none
+    static std::vector<std::string> findFiles(const std::string &directory, const std::string &runName = std::string());
+};
@@ -0,0 +1,63 @@
+#include "ReplayPlayer.h"
+#include "../Car/car.h"
+#include "../Track/track.h"
+
+ReplayPlayer::ReplayPlayer() : tick(0), playing(false)
+{
+}
+
+ReplayPlayer::~ReplayPlayer() = default;
+
+void ReplayPlayer::start(ReplayData data, const VehicleParams &params)
+{
+    replay = std::move(data);
+    tick = 0;
+
+    cars.clear();
+    nextContact.assign(replay.cars.size(), 0);
+    for (const auto &recorded : replay.cars)
+    {
+        auto car = std::make_unique<Car>(recorded.startState.x, recorded.startState.y);
+        car->setVehicleParams(params);
+        car->setVehicleState(recorded.startState);
+        car->setAIInputs(recorded.startSteering, recorded.startThrottle);
+        cars.push_back(std::move(car));
+    }
+
+    playing = !cars.empty() && replay.tickCount > 0;
+}
+
+void ReplayPlayer::stop()
+{
+    playing = false;
+}
+
+bool ReplayPlayer::step(const Track &track)
+{
+    if (!playing)
+        return false;
+
+    // The same order as the training loop: physics, track collision, then the inputs for the next tick
+    for (std::size_t i = 0; i < cars.size(); ++i)
+    {
+        Car &car = *cars[i];
+        const ReplayCar &recorded = replay.cars[i];
+
+        car.update(replay.simulationStep);
+        car.handleCollision(track.getInnerEdgePoints(), track.getOuterEdgePoints(),
+                            track.getInnerEdgeGrid(), track.getOuterEdgeGrid());
+        car.setAIInputs(recorded.steering[tick], recorded.throttle[tick]);
+
+        std::size_t &contact = nextContact[i];
+        if (contact < recorded.contacts.size() && recorded.contacts[contact].tick == tick)
+        {
+            car.setVehicleState(recorded.contacts[contact].state);
+            contact++;
+        }
+    }
+
+    tick++;
+    if (tick >= replay.tickCount)
+        playing = false;
+    return playing;
+}
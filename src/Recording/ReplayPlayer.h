@@ -0,0 +1,45 @@
+#pragma once
+#include "ReplayFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Car;
+class Track;
+
+// Drives recorded cars again: the stored inputs go through the same fixed step physics and track collisions,
+// no network is evaluated and no sensors are cast, so playing a replay costs a fraction of the original run.
+// Because the inputs are stored exactly, the cars follow the recorded run tick for tick.
+class ReplayPlayer
+{
+private:
+    ReplayData replay;
+    std::vector<std::unique_ptr<Car>> cars; // Indexed like replay.cars
+    std::vector<std::size_t> nextContact;
+    std::uint32_t tick;
+    bool playing;
+
+public:
+    ReplayPlayer();
+    ~ReplayPlayer();
+
+    ReplayPlayer(const ReplayPlayer &) = delete;
+    ReplayPlayer &operator=(const ReplayPlayer &) = delete;
+
+    // Place the cars at their recorded start, params are the vehicle class the replay names
+    void start(ReplayData data, const VehicleParams &params);
+    void stop();
+
+    bool isPlaying() const { return playing; }
+
+    // Advance one tick with the recorded step, returns false (and stops) once every recorded tick was played
+    bool step(const Track &track);
+
+    const ReplayData &getReplay() const { return replay; }
+    const std::vector<std::unique_ptr<Car>> &getCars() const { return cars; }
+    std::uint32_t getTick() const { return tick; }
+
+    // The car hadn't crashed or finished yet at the current tick
+    bool isCarActive(std::size_t index) const { return index < replay.cars.size() && tick < replay.cars[index].activeTicks; }
+};
@@ -0,0 +1,112 @@
+#include "ReplayRecorder.h"
+#include "../Car/car.h"
+
+namespace
+{
+    bool sameState(const VehicleState &a, const VehicleState &b)
+    {
+        return a.x == b.x && a.y == b.y && a.rotation == b.rotation && a.velocity == b.velocity &&
+               a.lateralVelocity == b.lateralVelocity && a.yawRate == b.yawRate;
+    }
+}
+
+ReplayRecorder::ReplayRecorder() : recordingActive(false)
+{
+}
+
+void ReplayRecorder::begin(const ReplayData &header, const std::vector<std::unique_ptr<Car>> &cars)
+{
+    recording.trackId = header.trackId;
+    recording.seed = header.seed;
+    recording.generation = header.generation;
+    recording.simulationStep = header.simulationStep;
+    recording.vehicleClass = header.vehicleClass;
+    recording.tickCount = 0;
+
+    // Reuse the per car buffers of the last recording, they keep their capacity
+    recording.cars.resize(cars.size());
+    recordedStates.resize(cars.size());
+    for (std::size_t i = 0; i < cars.size(); ++i)
+    {
+        ReplayCar &car = recording.cars[i];
+        car.carIndex = static_cast<int>(i);
+        car.fitness = 0.0;
+        car.activeTicks = 0;
+        car.startState = cars[i]->getVehicleState();
+        car.startSteering = cars[i]->getSteeringInput();
+        car.startThrottle = cars[i]->getThrottleInput();
+        car.steering.clear();
+        car.throttle.clear();
+        car.contacts.clear();
+        recordedStates[i] = car.startState;
+    }
+
+    recordingActive = true;
+}
+
+void ReplayRecorder::stop()
+{
+    recordingActive = false;
+}
+
+void ReplayRecorder::recordControls(std::size_t carIndex, const Car &car, bool active)
+{
+    if (!recordingActive || carIndex >= recording.cars.size())
+        return;
+
+    ReplayCar &recorded = recording.cars[carIndex];
+    recorded.steering.push_back(car.getSteeringInput());
+    recorded.throttle.push_back(car.getThrottleInput());
+    if (active)
+        recorded.activeTicks = recording.tickCount + 1;
+    recordedStates[carIndex] = car.getVehicleState();
+}
+
+void ReplayRecorder::endTick(const std::vector<std::unique_ptr<Car>> &cars)
+{
+    if (!recordingActive)
+        return;
+
+    for (std::size_t i = 0; i < recording.cars.size() && i < cars.size(); ++i)
+    {
+        ReplayCar &recorded = recording.cars[i];
+
+        // A car that wasn't recorded this tick keeps its inputs
+        if (recorded.steering.size() == recording.tickCount)
+        {
+            recorded.steering.push_back(cars[i]->getSteeringInput());
+            recorded.throttle.push_back(cars[i]->getThrottleInput());
+            recordedStates[i] = cars[i]->getVehicleState();
+        }
+
+        // Contacts are resolved after the inputs were recorded, store where they left the car
+        const VehicleState &state = cars[i]->getVehicleState();
+        if (!sameState(state, recordedStates[i]))
+        {
+            ReplayContact contact;
+            contact.tick = recording.tickCount;
+            contact.state = state;
+            recorded.contacts.push_back(contact);
+        }
+    }
+
+    recording.tickCount++;
+}
+
+ReplayData ReplayRecorder::extract(const std::vector<std::size_t> &carIndices) const
+{
+    ReplayData replay;
+    replay.trackId = recording.trackId;
+    replay.seed = recording.seed;
+    replay.generation = recording.generation;
+    replay.simulationStep = recording.simulationStep;
+    replay.vehicleClass = recording.vehicleClass;
+    replay.tickCount = recording.tickCount;
+
+    for (std::size_t index : carIndices)
+    {
+        if (index < recording.cars.size())
+            replay.cars.push_back(recording.cars[index]);
+    }
+    return replay;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "ReplayFile.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+class Car;
+
+// Records the control inputs of every car while the simulation runs, a selection of them is kept as a replay
+// Recording costs two floats per car and tick; the simulation thread calls recordControls() for every car
+// after its controller set the inputs and endTick() once the tick (including car-to-car contacts) is done.
+class ReplayRecorder
+{
+private:
+    ReplayData recording;                    // Holds every car, indexed like the simulation's cars
+    std::vector<VehicleState> recordedStates; // State when the inputs were recorded, a change by endTick() is a contact
+    bool recordingActive;
+
+public:
+    ReplayRecorder();
+
+    // Start a new recording from the cars' current state, header holds the track id, seed, generation, step and class
+    void begin(const ReplayData &header, const std::vector<std::unique_ptr<Car>> &cars);
+
+    // Drop the recording (the cars were reset or replaced)
+    void stop();
+
+    bool isRecording() const { return recordingActive; }
+    std::uint32_t getTickCount() const { return recording.tickCount; }
+
+    void recordControls(std::size_t carIndex, const Car &car, bool active);
+    void endTick(const std::vector<std::unique_ptr<Car>> &cars);
+
+    // Copy of the recording with only the given cars
+    ReplayData extract(const std::vector<std::size_t> &carIndices) const;
+};
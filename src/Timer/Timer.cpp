@@ -80,20 +80,20 @@ void Timer::update()
     }
 }
 
-void Timer::draw(sf::RenderWindow &window)
+void Timer::draw(sf::RenderTarget &target)
 {
     // Create a simple visual timer using rectangles
     // Draw a background rectangle for the timer
     sf::RectangleShape background;
     background.setSize(sf::Vector2f(200, 40));
     background.setPosition(sf::Vector2f(
-        (window.getSize().x - 200) / 2.0f,
+        (target.getSize().x - 200) / 2.0f,
         20.0f));
     background.setFillColor(sf::Color(0, 0, 0, 128)); // Semi-transparent black
     background.setOutlineColor(sf::Color::White);
     background.setOutlineThickness(2.0f);
 
-    window.draw(background);
+    target.draw(background);
 
     // Draw the text if available
     if (timerText)
@@ -102,20 +102,20 @@ void Timer::draw(sf::RenderWindow &window)
         {
             // Position the text in the center of the background
             timerText->setPosition(sf::Vector2f(
-                (window.getSize().x - 100) / 2.0f,
+                (target.getSize().x - 100) / 2.0f,
                 30.0f));
-            window.draw(*timerText);
+            target.draw(*timerText);
         }
         catch (...)
         {
             // If drawing text fails, fallback to visualization
-            drawTimeVisualization(window, timeString);
+            drawTimeVisualization(target, timeString);
         }
     }
     else
     {
         // Fallback to colored rectangles if text is not available
-        drawTimeVisualization(window, timeString);
+        drawTimeVisualization(target, timeString);
     }
 }
 
@@ -148,11 +148,11 @@ std::string Timer::getTimeString() const
     return formatTime(elapsedTime);
 }
 
-void Timer::drawTimeVisualization(sf::RenderWindow &window, const std::string &timeStr)
+void Timer::drawTimeVisualization(sf::RenderTarget &target, const std::string &timeStr)
 {
     // Create a simple visual representation using colored rectangles
     // Each digit will be represented by a colored rectangle
-    float startX = (window.getSize().x - 200) / 2.0f + 10.0f;
+    float startX = (target.getSize().x - 200) / 2.0f + 10.0f;
     float startY = 30.0f;
     float digitWidth = 15.0f;
     float digitHeight = 20.0f;
@@ -190,6 +190,6 @@ void Timer::drawTimeVisualization(sf::RenderWindow &window, const std::string &t
             digitRect.setFillColor(sf::Color::White);
         }
 
-        window.draw(digitRect);
+        target.draw(digitRect);
     }
 }
\ No newline at end of file
@@ -30,7 +30,7 @@ public:
     void update();
 
     // Draw the timer (called each frame) - simplified for now
-    void draw(sf::RenderWindow &window);
+    void draw(sf::RenderTarget &target);
 
     // Get the formatted time string
     std::string getTimeString() const;
@@ -46,5 +46,5 @@ public:
 
 private:
     // Draw a simple visual representation of the time
-    void drawTimeVisualization(sf::RenderWindow &window, const std::string &timeStr);
+    void drawTimeVisualization(sf::RenderTarget &target, const std::string &timeStr);
 };
\ No newline at end of file
@@ -1,76 +1,55 @@
 #include "TimerRenderer.h"
+#include "../UI/HudRenderer.h"
 
-TimerRenderer::TimerRenderer(TimerLogic &timer)
-    : timerLogic(timer), timerText(nullptr)
+TimerRenderer::TimerRenderer(HudRenderer &hudRenderer)
+    : hud(hudRenderer), timeString("00:00.000")
 {
-    // Load the font from the Fonts directory
-    if (!font.openFromFile("../../Fonts/ARIAL.TTF"))
-    {
-        // Fallback to colored rectangles if font loading fails
-        timerText = nullptr;
-    }
-    else
-    {
-        timerText = new sf::Text(font, "00:00.000", 24);
-        timerText->setFillColor(sf::Color::White);
-    }
+    // The time text is drawn by the batched HUD
+    timerLabel = hud.addLabel(24, sf::Color::White);
+    hud.setText(timerLabel, timeString);
 }
 
-TimerRenderer::~TimerRenderer()
+void TimerRenderer::setTimeString(const std::string &time)
 {
-    if (timerText)
-    {
-        delete timerText;
-    }
+    // The label is only laid out again when the time string changed
+    timeString = time;
+    hud.setText(timerLabel, timeString);
 }
 
-void TimerRenderer::draw(sf::RenderWindow &window) const
+void TimerRenderer::draw(sf::RenderTarget &target) const
 {
     // Create a simple visual timer using rectangles
     // Draw a background rectangle for the timer
     sf::RectangleShape background;
     background.setSize(sf::Vector2f(200, 40));
     background.setPosition(sf::Vector2f(
-        (window.getSize().x - 200) / 2.0f,
+        (target.getSize().x - 200) / 2.0f,
         20.0f));
     background.setFillColor(sf::Color(0, 0, 0, 128)); // Semi-transparent black
     background.setOutlineColor(sf::Color::White);
     background.setOutlineThickness(2.0f);
 
-    window.draw(background);
+    target.draw(background);
 
-    // Draw the text if available
-    if (timerText)
+    if (hud.isFontLoaded())
     {
-        try
-        {
-            // Update the text with current time
-            timerText->setString(timerLogic.getTimeString());
-
-            // Position the text in the center of the background
-            timerText->setPosition(sf::Vector2f(
-                (window.getSize().x - 100) / 2.0f,
-                30.0f));
-            window.draw(*timerText);
-        }
-        catch (...)
-        {
-            // If drawing text fails, fallback to visualization
-            drawTimeVisualization(window, timerLogic.getTimeString());
-        }
+        // Position the text in the center of the background
+        hud.setPosition(timerLabel, sf::Vector2f(
+                                        (target.getSize().x - 100) / 2.0f,
+                                        30.0f));
     }
     else
     {
         // Fallback to colored rectangles if text is not available
-        drawTimeVisualization(window, timerLogic.getTimeString());
+        drawTimeVisualization(target, timeString);
     }
 }
 
-void TimerRenderer::drawTimeVisualization(sf::RenderWindow &window, const std::string &timeStr) const
+void TimerRenderer::drawTimeVisualization(sf::RenderTarget &target, const std::string &timeStr) const
 {
     // Create a simple visual representation using colored rectangles
     // Each digit will be represented by a colored rectangle
-    float startX = (window.getSize().x - 200) / 2.0f + 10.0f;
+    float startX = (target.getSize().x - 200) / 2.0f + 10.0f;
     float startY = 30.0f;
     float digitWidth = 15.0f;
     float digitHeight = 20.0f;
@@ -108,6 +87,6 @@ void TimerRenderer::drawTimeVisualization(sf::RenderWindow &window, const std::s
             digitRect.setFillColor(sf::Color::White);
         }
 
-        window.draw(digitRect);
+        target.draw(digitRect);
     }
 }
\ No newline at end of file
@@ -1,23 +1,28 @@
 #pragma once
 #include "../Interfaces/IRenderable.h"
-#include "TimerLogic.h"
 #include <SFML/Graphics.hpp>
+#include <string>
+
+// Forward declaration
+class HudRenderer;
 
 // Timer renderer class - handles only timer rendering
 class TimerRenderer : public IRenderable
 {
 private:
-    TimerLogic& timerLogic;
-    sf::Font font;
-    sf::Text* timerText;
+    HudRenderer& hud;
+    int timerLabel;         // HUD label showing the time
+    std::string timeString; // Time currently shown
 
 public:
-    TimerRenderer(TimerLogic& timer);
-    ~TimerRenderer();
+    TimerRenderer(HudRenderer& hudRenderer);
     
+    // Set the time to show (taken from the simulation snapshot, not the live timer)
+    void setTimeString(const std::string& time);
+
     // IRenderable interface implementation
-    void draw(sf::RenderWindow& window) const override;
+    void draw(sf::RenderTarget& target) const override;
 
 private:
-    void drawTimeVisualization(sf::RenderWindow& window, const std::string& timeStr) const;
-}; 
\ No newline at end of file
+    void drawTimeVisualization(sf::RenderTarget& target, const std::string& timeStr) const;
+}; 
@@ -0,0 +1,112 @@
+#include "EdgeGrid.h"
+#include <algorithm>
+#include <cmath>
+
+EdgeGrid::EdgeGrid() : origin(0.0f, 0.0f), cellSize(1.0f), columns(0), rows(0)
+{
+}
+
+void EdgeGrid::build(const std::vector<sf::Vector2f> &points, float size)
+{
+    cellStart.clear();
+    pointIndices.clear();
+    columns = 0;
+    rows = 0;
+    cellSize = std::max(1.0f, size);
+    if (points.empty())
+        return;
+
+    sf::Vector2f minCorner = points[0];
+    sf::Vector2f maxCorner = points[0];
+    for (const auto &point : points)
+    {
+        minCorner.x = std::min(minCorner.x, point.x);
+        minCorner.y = std::min(minCorner.y, point.y);
+        maxCorner.x = std::max(maxCorner.x, point.x);
+        maxCorner.y = std::max(maxCorner.y, point.y);
+    }
+
+    origin = minCorner;
+    columns = static_cast<std::uint32_t>((maxCorner.x - minCorner.x) / cellSize) + 1;
+    rows = static_cast<std::uint32_t>((maxCorner.y - minCorner.y) / cellSize) + 1;
+
+    // Count the points per cell, turn the counts into start offsets, then fill (indices stay ascending per cell)
+    auto cellOf = [this](sf::Vector2f point)
+    {
+        std::uint32_t column = std::min(columns - 1, static_cast<std::uint32_t>((point.x - origin.x) / cellSize));
+        std::uint32_t row = std::min(rows - 1, static_cast<std::uint32_t>((point.y - origin.y) / cellSize));
+        return row * columns + column;
+    };
+
+    cellStart.assign(static_cast<std::size_t>(columns) * rows + 1, 0);
+    for (const auto &point : points)
+    {
+        cellStart[cellOf(point) + 1]++;
+    }
+    for (std::size_t i = 1; i < cellStart.size(); ++i)
+    {
+        cellStart[i] += cellStart[i - 1];
+    }
+
+    pointIndices.resize(points.size());
+    std::vector<std::uint32_t> fill(cellStart.begin(), cellStart.end() - 1);
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        pointIndices[fill[cellOf(points[i])]++] = static_cast<std::uint32_t>(i);
+    }
+}
+
+void EdgeGrid::query(sf::Vector2f center, float radius, std::vector<std::uint32_t> &indices) const
+{
+    indices.clear();
+    if (cellStart.empty())
+        return;
+
+    // Cells overlapping the circle's bounding box
+    float minX = std::floor((center.x - radius - origin.x) / cellSize);
+    float minY = std::floor((center.y - radius - origin.y) / cellSize);
+    float maxX = std::floor((center.x + radius - origin.x) / cellSize);
+    float maxY = std::floor((center.y + radius - origin.y) / cellSize);
+    if (maxX < 0.0f || maxY < 0.0f || minX >= columns || minY >= rows)
+        return;
+
+    std::uint32_t firstColumn = static_cast<std::uint32_t>(std::max(0.0f, minX));
+    std::uint32_t firstRow = static_cast<std::uint32_t>(std::max(0.0f, minY));
+    std::uint32_t lastColumn = static_cast<std::uint32_t>(std::min(static_cast<float>(columns - 1), maxX));
+    std::uint32_t lastRow = static_cast<std::uint32_t>(std::min(static_cast<float>(rows - 1), maxY));
+
+    for (std::uint32_t row = firstRow; row <= lastRow; ++row)
+    {
+        for (std::uint32_t column = firstColumn; column <= lastColumn; ++column)
+        {
+            std::uint32_t cell = row * columns + column;
+            indices.insert(indices.end(), pointIndices.begin() + cellStart[cell], pointIndices.begin() + cellStart[cell + 1]);
+        }
+    }
+
+    // Callers scan in index order, like a scan over all points would
+    std::sort(indices.begin(), indices.end());
+}
+
+bool EdgeGrid::isValid(std::size_t pointCount) const
+{
+    if (cellStart.empty())
+        return pointIndices.empty();
+
+    if (columns == 0 || rows == 0 || !(cellSize > 0.0f) ||
+        cellStart.size() != static_cast<std::size_t>(columns) * rows + 1 ||
+        cellStart.front() != 0 || cellStart.back() != pointIndices.size() || pointIndices.size() != pointCount)
+        return false;
+
+    for (std::size_t i = 1; i < cellStart.size(); ++i)
+    {
+        if (cellStart[i] < cellStart[i - 1])
+            return false;
+    }
+    for (std::uint32_t index : pointIndices)
+    {
+        if (index >= pointCount)
+            return false;
+    }
+    return true;
+}
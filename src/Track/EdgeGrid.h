@@ -0,0 +1,33 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+// Uniform grid over track edge points, to find the points near a car without scanning the whole track
+// Stored compactly: cellStart[cell]..cellStart[cell + 1] is the range of that cell's point indices in pointIndices
+class EdgeGrid
+{
+private:
+    sf::Vector2f origin;
+    float cellSize;
+    std::uint32_t columns;
+    std::uint32_t rows;
+    std::vector<std::uint32_t> cellStart;
+    std::vector<std::uint32_t> pointIndices; // Ascending within each cell
+
+    friend class TrackFile; // Reads and writes the arrays directly
+
+public:
+    EdgeGrid();
+
+    // Put every point into its cell
+    void build(const std::vector<sf::Vector2f> &points, float size);
+
+    // Indices of all points that can be within radius of center, sorted ascending (cleared first, keeps capacity)
+    void query(sf::Vector2f center, float radius, std::vector<std::uint32_t> &indices) const;
+
+    bool isEmpty() const { return cellStart.empty(); }
+
+    // Check the arrays agree with each other and with a point count (for loaded grids)
+    bool isValid(std::size_t pointCount) const;
+};
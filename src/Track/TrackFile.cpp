@@ -0,0 +1,275 @@
+#include "TrackFile.h"
+#include "../Persistence/BinaryIO.h"
+#include "../Persistence/CheckpointWriter.h"
+#include "../Persistence/MappedFile.h"
+#include "../Logging/Logger.h"
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    static_assert(sizeof(sf::Vector2f) == 2 * sizeof(float), "edge points are copied as float pairs");
+
+    // The file is little endian, on such hosts the large arrays are copied in one piece
+    bool hostIsLittleEndian()
+    {
+        const std::uint32_t probe = 1;
+        unsigned char firstByte;
+        std::memcpy(&firstByte, &probe, 1);
+        return firstByte == 1;
+    }
+
+    void writePoints(BinaryWriter &writer, const std::vector<sf::Vector2f> &points)
+    {
+        writer.writeU32(static_cast<std::uint32_t>(points.size()));
+        if (hostIsLittleEndian())
+        {
+            writer.writeBytes(points.data(), points.size() * sizeof(sf::Vector2f));
+            return;
+        }
+        for (const auto &point : points)
+        {
+            writer.writeF32(point.x);
+            writer.writeF32(point.y);
+        }
+    }
+
+    void readPoints(BinaryReader &reader, std::vector<sf::Vector2f> &points)
+    {
+        std::uint32_t count = reader.readCount(8);
+        points.resize(count);
+        if (count == 0)
+            return;
+        if (hostIsLittleEndian())
+        {
+            reader.readBytes(points.data(), count * sizeof(sf::Vector2f));
+            return;
+        }
+        for (auto &point : points)
+        {
+            point.x = reader.readF32();
+            point.y = reader.readF32();
+        }
+    }
+
+    void writeIndices(BinaryWriter &writer, const std::vector<std::uint32_t> &values)
+    {
+        writer.writeU32(static_cast<std::uint32_t>(values.size()));
+        if (hostIsLittleEndian())
+        {
+            writer.writeBytes(values.data(), values.size() * sizeof(std::uint32_t));
+            return;
+        }
+        for (std::uint32_t value : values)
+        {
+            writer.writeU32(value);
+        }
+    }
+
+    void readIndices(BinaryReader &reader, std::vector<std::uint32_t> &values)
+    {
+        std::uint32_t count = reader.readCount(4);
+        values.resize(count);
+        if (count == 0)
+            return;
+        if (hostIsLittleEndian())
+        {
+            reader.readBytes(values.data(), count * sizeof(std::uint32_t));
+            return;
+        }
+        for (auto &value : values)
+        {
+            value = reader.readU32();
+        }
+    }
+
+    void readPoint(BinaryReader &reader, sf::Vector2f &point)
+    {
+        point.x = reader.readF32();
+        point.y = reader.readF32();
+        if (!std::isfinite(point.x) || !std::isfinite(point.y))
+            reader.fail();
+    }
+}
+
+std::vector<char> TrackFile::encode(const std::vector<TrackCurve> &curves, float trackWidth, sf::Vector2f startPosition,
+                                    const TrackGeometry *geometry)
+{
+    std::vector<char> data;
+    BinaryWriter writer(data);
+
+    writer.writeU32(Magic);
+    writer.writeU32(Version);
+    writer.writeU32(geometry ? FlagBaked : 0);
+    writer.writeF32(trackWidth);
+    writer.writeF32(startPosition.x);
+    writer.writeF32(startPosition.y);
+
+    writer.writeU32(static_cast<std::uint32_t>(curves.size()));
+    for (const auto &curve : curves)
+    {
+        writer.writeF32(curve.start.x);
+        writer.writeF32(curve.start.y);
+        writer.writeF32(curve.control.x);
+        writer.writeF32(curve.control.y);
+        writer.writeF32(curve.end.x);
+        writer.writeF32(curve.end.y);
+        writer.writeF32(curve.width);
+        writer.writeU32(static_cast<std::uint32_t>(curve.numSegments));
+    }
+
+    if (geometry)
+    {
+        writePoints(writer, geometry->innerEdgePoints);
+        writePoints(writer, geometry->outerEdgePoints);
+
+        writer.writeU32(static_cast<std::uint32_t>(geometry->checkpointSegments.size()));
+        for (const auto &segment : geometry->checkpointSegments)
+        {
+            writer.writeF32(segment.position.x);
+            writer.writeF32(segment.position.y);
+            writer.writeF32(segment.size.x);
+            writer.writeF32(segment.size.y);
+            writer.writeF32(segment.rotation);
+            writer.writeI32(segment.segmentIndex);
+        }
+
+        for (const EdgeGrid *grid : {&geometry->innerGrid, &geometry->outerGrid})
+        {
+            writer.writeF32(grid->origin.x);
+            writer.writeF32(grid->origin.y);
+            writer.writeF32(grid->cellSize);
+            writer.writeU32(grid->columns);
+            writer.writeU32(grid->rows);
+            writeIndices(writer, grid->cellStart);
+            writeIndices(writer, grid->pointIndices);
+        }
+    }
+
+    writer.writeU32(fnv1a(data.data(), data.size()));
+    return data;
+}
+
+bool TrackFile::decode(const char *data, std::size_t size, TrackFileData &result)
+{
+    if (size < 8)
+    {
+        LOG_WARNING("Track file: file is too small");
+        return false;
+    }
+
+    // Verify the checksum before trusting any field
+    std::size_t payloadSize = size - 4;
+    BinaryReader checksumReader(data + payloadSize, 4);
+    if (checksumReader.readU32() != fnv1a(data, payloadSize))
+    {
+        LOG_WARNING("Track file: checksum mismatch, the file is damaged");
+        return false;
+    }
+
+    BinaryReader reader(data, payloadSize);
+    if (reader.readU32() != Magic)
+    {
+        LOG_WARNING("Track file: not a track file");
+        return false;
+    }
+
+    std::uint32_t version = reader.readU32();
+    if (version != Version)
+    {
+        LOG_WARNING("Track file: unsupported version " << version << " (expected " << Version << ")");
+        return false;
+    }
+
+    TrackFileData loaded;
+    std::uint32_t flags = reader.readU32();
+    loaded.trackWidth = reader.readF32();
+    readPoint(reader, loaded.startPosition);
+    if (!(loaded.trackWidth > 0.0f) || !std::isfinite(loaded.trackWidth))
+        reader.fail();
+
+    // A segment count this large would take minutes to build, the file is wrong
+    const std::uint32_t maxSegments = 1u << 20;
+
+    std::uint32_t curveCount = reader.readCount(32);
+    loaded.curves.resize(curveCount);
+    for (auto &curve : loaded.curves)
+    {
+        readPoint(reader, curve.start);
+        readPoint(reader, curve.control);
+        readPoint(reader, curve.end);
+        curve.width = reader.readF32();
+        std::uint32_t numSegments = reader.readU32();
+        if (!(curve.width > 0.0f) || !std::isfinite(curve.width) || numSegments == 0 || numSegments > maxSegments)
+            reader.fail();
+        curve.numSegments = static_cast<int>(numSegments);
+    }
+
+    loaded.hasGeometry = (flags & FlagBaked) != 0;
+    if (loaded.hasGeometry)
+    {
+        TrackGeometry &geometry = loaded.geometry;
+        readPoints(reader, geometry.innerEdgePoints);
+        readPoints(reader, geometry.outerEdgePoints);
+
+        std::uint32_t segmentCount = reader.readCount(24);
+        geometry.checkpointSegments.resize(segmentCount);
+        for (auto &segment : geometry.checkpointSegments)
+        {
+            readPoint(reader, segment.position);
+            readPoint(reader, segment.size);
+            segment.rotation = reader.readF32();
+            segment.segmentIndex = reader.readI32();
+        }
+
+        for (EdgeGrid *grid : {&geometry.innerGrid, &geometry.outerGrid})
+        {
+            readPoint(reader, grid->origin);
+            grid->cellSize = reader.readF32();
+            grid->columns = reader.readU32();
+            grid->rows = reader.readU32();
+            readIndices(reader, grid->cellStart);
+            readIndices(reader, grid->pointIndices);
+        }
+
+        // Collision queries index the edge points through the grids without checks
+        if (reader.ok() && (!geometry.innerGrid.isValid(geometry.innerEdgePoints.size()) ||
+                            !geometry.outerGrid.isValid(geometry.outerEdgePoints.size())))
+            reader.fail();
+    }
+
+    if (!reader.ok() || reader.getRemaining() != 0)
+    {
+        LOG_WARNING("Track file: invalid track data");
+        return false;
+    }
+
+    result = std::move(loaded);
+    return true;
+}
+
+bool TrackFile::save(const std::string &path, const std::vector<TrackCurve> &curves, float trackWidth,
+                     sf::Vector2f startPosition, const TrackGeometry *geometry)
+{
+    if (!CheckpointWriter::writeFileAtomically(path, encode(curves, trackWidth, startPosition, geometry)))
+        return false;
+
+    LOG_INFO("Track saved to " << path);
+    return true;
+}
+
+std::uint32_t TrackFile::computeLayoutId(const std::vector<TrackCurve> &curves, float trackWidth, sf::Vector2f startPosition)
+{
+    std::vector<char> data = encode(curves, trackWidth, startPosition, nullptr);
+    return fnv1a(data.data(), data.size());
+}
+
+bool TrackFile::load(const std::string &path, TrackFileData &result)
+{
+    // The arrays are copied straight out of the mapping, no intermediate read buffer
+    MappedFile file;
+    if (!file.open(path))
+        return false;
+
+    return decode(file.getData(), file.getSize(), result);
+}
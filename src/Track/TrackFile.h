@@ -0,0 +1,49 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "track.h"
+
+// Everything read from a track file
+struct TrackFileData
+{
+    float trackWidth;
+    sf::Vector2f startPosition;
+    std::vector<TrackCurve> curves;
+    bool hasGeometry; // The baked section was present, geometry is filled
+    TrackGeometry geometry;
+
+    TrackFileData() : trackWidth(100.0f), startPosition(0.0f, 0.0f), hasGeometry(false) {}
+};
+
+// Track file (.rctrack, little endian): the curves the track is made of, optionally followed by the geometry
+// derived from them, so loading a baked track skips generating thousands of segments.
+//
+// Layout: magic "RCTK", u32 version, u32 flags (bit 0: baked section present), f32 track width, f32 x2 start position,
+// u32 curve count, per curve: f32 x2 start, control, end, f32 width, u32 segment count.
+// Baked section: inner edge points, outer edge points (u32 count + f32 x2 each), checkpoint gates
+// (u32 count + f32 x5, i32 index each), inner then outer edge grid (f32 x2 origin, f32 cell size, u32 columns, u32 rows,
+// u32 count + u32 cell starts, u32 count + u32 point indices).
+// Ends with a u32 FNV-1a checksum of everything before it.
+class TrackFile
+{
+public:
+    static constexpr std::uint32_t Magic = 0x4B544352; // "RCTK" in file order
+    static constexpr std::uint32_t Version = 1;
+    static constexpr std::uint32_t FlagBaked = 1;
+
+    static std::vector<char> encode(const std::vector<TrackCurve> &curves, float trackWidth, sf::Vector2f startPosition,
+                                    const TrackGeometry *geometry);
+    static bool decode(const char *data, std::size_t size, TrackFileData &result);
+
+    // Written atomically; geometry may be null to write only the curves
+    static bool save(const std::string &path, const std::vector<TrackCurve> &curves, float trackWidth,
+                     sf::Vector2f startPosition, const TrackGeometry *geometry);
+
+    // Identifies a layout (checksum of the curves, width and start), the same whether or not a file is baked
+    static std::uint32_t computeLayoutId(const std::vector<TrackCurve> &curves, float trackWidth, sf::Vector2f startPosition);
+
+    // Maps the file and decodes it, result is only changed when the whole file is valid
+    static bool load(const std::string &path, TrackFileData &result);
+};
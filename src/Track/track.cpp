@@ -1,9 +1,17 @@
 #include "track.h"
-#include <fstream>
-#include <iostream>
+#include "TrackFile.h"
+#include "../Logging/Logger.h"
+#include <algorithm>
 
 Track::Track(unsigned int width, unsigned int height)
-    : windowWidth(width), windowHeight(height), trackWidth(100.0f)
+    : startPosition(350.0f, 220.0f), shapesDirty(false), windowWidth(width), windowHeight(height), trackWidth(100.0f),
+      bakedVertices(sf::PrimitiveType::Triangles),
+      bakedBuffer(sf::PrimitiveType::Triangles, sf::VertexBuffer::Usage::Static),
+      useVertexBuffer(false), bakeDirty(true), flagFirst(0), flagCount(0), drawnVertexCount(0)
+{
+}
+
+void Track::createDefaultLayout()
 {
     // Add the first curve
     addCurve(sf::Vector2f(350.0f, 230.0f), sf::Vector2f(600.0f, 200.0f), sf::Vector2f(700.0f, 350.0f), trackWidth, 400);
@@ -51,27 +59,273 @@ Track::Track(unsigned int width, unsigned int height)
     addLoopClosingCurve(trackWidth, 200);
 }
 
-void Track::draw(sf::RenderWindow &window) const
+void Track::draw(sf::RenderTarget &target) const
 {
-    // Draw all track shapes
-    for (const auto &shape : trackShapes)
+    if (bakeDirty)
     {
-        shape.draw(window);
+        bake();
     }
+
+    int lod = selectLod(target);
+
+    // Visible world area (views are never rotated)
+    const sf::View &view = target.getView();
+    sf::FloatRect visible(view.getCenter() - view.getSize() / 2.0f, view.getSize());
+
+    drawnVertexCount = 0;
+
+    // Surfaces of the visible curves, neighbouring curves are contiguous so they are merged into one draw
+    std::size_t runFirst = 0;
+    std::size_t runCount = 0;
+    for (const auto &chunk : chunks)
+    {
+        if (!chunk.bounds.findIntersection(visible))
+            continue;
+
+        if (runCount > 0 && runFirst + runCount == chunk.surfaceFirst[lod])
+        {
+            runCount += chunk.surfaceCount[lod];
+        }
+        else
+        {
+            drawRange(target, runFirst, runCount);
+            runFirst = chunk.surfaceFirst[lod];
+            runCount = chunk.surfaceCount[lod];
+        }
+    }
+    drawRange(target, runFirst, runCount);
+
+    drawRange(target, flagFirst, flagCount);
+
+    // Edge circles are only a few pixels wide, skip them once zoomed out
+    if (lod > 0)
+        return;
+
+    runCount = 0;
+    for (const auto &chunk : chunks)
+    {
+        if (!chunk.bounds.findIntersection(visible))
+            continue;
+
+        if (runCount > 0 && runFirst + runCount == chunk.edgeFirst)
+        {
+            runCount += chunk.edgeCount;
+        }
+        else
+        {
+            drawRange(target, runFirst, runCount);
+            runFirst = chunk.edgeFirst;
+            runCount = chunk.edgeCount;
+        }
+    }
+    drawRange(target, runFirst, runCount);
+}
+
+void Track::drawRange(sf::RenderTarget &target, std::size_t first, std::size_t count) const
+{
+    if (count == 0)
+        return;
+
+    if (useVertexBuffer)
+    {
+        target.draw(bakedBuffer, first, count);
+    }
+    else
+    {
+        target.draw(&bakedVertices[first], count, sf::PrimitiveType::Triangles);
+    }
+    drawnVertexCount += count;
+}
+
+int Track::selectLod(const sf::RenderTarget &target) const
+{
+    // World units per screen pixel
+    float zoom = target.getView().getSize().x / std::max(1.0f, static_cast<float>(target.getSize().x));
+
+    if (zoom < 2.0f)
+        return 0;
+    if (zoom < 6.0f)
+        return 1;
+    return 2;
+}
+
+void Track::bake() const
+{
+    buildShapes();
+
+    bakedVertices.clear();
+    chunks.assign(trackShapes.size(), TrackChunk());
+
+    // Segment step of the simplified strips at each detail level
+    const int lodSteps[LodLevels] = {1, 4, 16};
+
+    // Surfaces, level by level (each level's curves are contiguous so visible runs merge)
+    for (int lod = 0; lod < LodLevels; ++lod)
+    {
+        for (std::size_t i = 0; i < trackShapes.size(); ++i)
+        {
+            TrackChunk &chunk = chunks[i];
+            chunk.surfaceFirst[lod] = bakedVertices.getVertexCount();
+            if (lod == 0)
+            {
+                trackShapes[i].appendSegments(bakedVertices);
+                chunk.bounds = trackShapes[i].getBounds();
+            }
+            else
+            {
+                trackShapes[i].appendSimplifiedSegments(bakedVertices, lodSteps[lod]);
+            }
+            chunk.surfaceCount[lod] = bakedVertices.getVertexCount() - chunk.surfaceFirst[lod];
+        }
+    }
+
+    // Same layering as drawing the pieces one by one: surface, then flag, then edges
+    flagFirst = bakedVertices.getVertexCount();
+    appendCheckeredFlag(bakedVertices);
+    flagCount = bakedVertices.getVertexCount() - flagFirst;
+
+    for (std::size_t i = 0; i < trackShapes.size(); ++i)
+    {
+        chunks[i].edgeFirst = bakedVertices.getVertexCount();
+        trackShapes[i].appendEdgeCircles(bakedVertices);
+        chunks[i].edgeCount = bakedVertices.getVertexCount() - chunks[i].edgeFirst;
+    }
+
+    // Upload to the GPU once, fall back to the vertex array if that isn't possible
+    useVertexBuffer = false;
+    if (sf::VertexBuffer::isAvailable() && bakedVertices.getVertexCount() > 0)
+    {
+        if (bakedBuffer.create(bakedVertices.getVertexCount()) && bakedBuffer.update(&bakedVertices[0]))
+        {
+            useVertexBuffer = true;
+        }
+    }
+
+    bakeDirty = false;
+}
+
+std::size_t Track::getBakedVertexCount() const
+{
+    if (bakeDirty)
+    {
+        bake();
+    }
+    return bakedVertices.getVertexCount();
 }
 
 void Track::setWindowSize(unsigned int width, unsigned int height)
 {
     windowWidth = width;
     windowHeight = height;
-    // Note: You might want to regenerate track segments here if they need to scale with window
 }
 
 void Track::createCurvedSegment(sf::Vector2f start, sf::Vector2f control, sf::Vector2f end, float width, int numSegments)
 {
+    // Shapes of a loaded track are built first, so the new shape lines up with its curve
+    buildShapes();
+
     // Create a new BezierShape and add it to the track
-    BezierShape shape(start, control, end, width, numSegments, sf::Color(32, 32, 32));
-    trackShapes.push_back(shape);
+    curves.push_back(TrackCurve{start, control, end, width, numSegments});
+    trackShapes.emplace_back(start, control, end, width, numSegments, sf::Color(32, 32, 32));
+
+    // The collision geometry and the baked geometry need to include the new curve
+    appendGeometry(trackShapes.back());
+    buildEdgeGrids();
+    bakeDirty = true;
+}
+
+void Track::buildShapes() const
+{
+    if (!shapesDirty)
+        return;
+
+    trackShapes.clear();
+    trackShapes.reserve(curves.size());
+    for (const auto &curve : curves)
+    {
+        trackShapes.emplace_back(curve.start, curve.control, curve.end, curve.width, curve.numSegments, sf::Color(32, 32, 32));
+    }
+    shapesDirty = false;
+}
+
+void Track::computeGeometry()
+{
+    buildShapes();
+
+    geometry = TrackGeometry();
+    for (const auto &shape : trackShapes)
+    {
+        appendGeometry(shape);
+    }
+    buildEdgeGrids();
+}
+
+void Track::appendGeometry(const BezierShape &shape)
+{
+    std::vector<sf::Vector2f> innerPoints = shape.getInnerEdgePoints();
+    std::vector<sf::Vector2f> outerPoints = shape.getOuterEdgePoints();
+    const auto &shapeSegments = shape.getCheckpointSegments();
+
+    geometry.innerEdgePoints.insert(geometry.innerEdgePoints.end(), innerPoints.begin(), innerPoints.end());
+    geometry.outerEdgePoints.insert(geometry.outerEdgePoints.end(), outerPoints.begin(), outerPoints.end());
+    geometry.checkpointSegments.insert(geometry.checkpointSegments.end(), shapeSegments.begin(), shapeSegments.end());
+}
+
+void Track::buildEdgeGrids()
+{
+    geometry.innerGrid.build(geometry.innerEdgePoints, EdgeGridCellSize);
+    geometry.outerGrid.build(geometry.outerEdgePoints, EdgeGridCellSize);
+}
+
+bool Track::loadFromFile(const std::string &path)
+{
+    TrackFileData data;
+    if (!TrackFile::load(path, data))
+        return false;
+
+    curves = std::move(data.curves);
+    trackWidth = data.trackWidth;
+    startPosition = data.startPosition;
+
+    // The shapes are only needed for drawing, a baked file skips building them until then
+    trackShapes.clear();
+    shapesDirty = true;
+    bakeDirty = true;
+
+    if (data.hasGeometry)
+    {
+        geometry = std::move(data.geometry);
+    }
+    else
+    {
+        computeGeometry();
+    }
+
+    LOG_INFO("Track loaded from " << path << " (" << curves.size() << " curves"
+          << (data.hasGeometry ? ", baked geometry" : "") << ")");
+    return true;
+}
+
+bool Track::saveToFile(const std::string &path, bool includeBaked) const
+{
+    return TrackFile::save(path, curves, trackWidth, startPosition, includeBaked ? &geometry : nullptr);
+}
+
+std::uint32_t Track::getLayoutId() const
+{
+    return TrackFile::computeLayoutId(curves, trackWidth, startPosition);
+}
+
+sf::Vector2f Track::getCurveStartTangent(const TrackCurve &curve)
+{
+    BezierCurve bezier(curve.start, curve.control, curve.end);
+    return bezier.getTangent(0.0f);
+}
+
+sf::Vector2f Track::getCurveEndTangent(const TrackCurve &curve)
+{
+    BezierCurve bezier(curve.start, curve.control, curve.end);
+    return bezier.getTangent(1.0f);
 }
 
 void Track::addCurve(sf::Vector2f start, sf::Vector2f control, sf::Vector2f end, float width, int numSegments)
@@ -82,7 +336,7 @@ void Track::addCurve(sf::Vector2f start, sf::Vector2f control, sf::Vector2f end,
 
 void Track::addSmoothCurve(sf::Vector2f end, float width, int numSegments)
 {
-    if (trackShapes.empty())
+    if (curves.empty())
     {
         // If no previous curve, just create a straight line
         addCurve(sf::Vector2f(0.0f, 0.0f), sf::Vector2f(end.x / 2.0f, end.y / 2.0f), end, width, numSegments);
@@ -90,9 +344,9 @@ void Track::addSmoothCurve(sf::Vector2f end, float width, int numSegments)
     }
 
     // Get the last curve's end point and tangent
-    const BezierShape &lastCurve = trackShapes.back();
-    sf::Vector2f start = lastCurve.getEndPoint();
-    sf::Vector2f endTangent = lastCurve.getEndTangent();
+    const TrackCurve &lastCurve = curves.back();
+    sf::Vector2f start = lastCurve.end;
+    sf::Vector2f endTangent = getCurveEndTangent(lastCurve);
 
     // Calculate the control point to ensure smooth connection
     // The control point should be positioned along the end tangent direction
@@ -105,20 +359,20 @@ void Track::addSmoothCurve(sf::Vector2f end, float width, int numSegments)
 
 void Track::addLoopClosingCurve(float width, int numSegments)
 {
-    if (trackShapes.empty())
+    if (curves.empty())
     {
         return; // No curves to connect
     }
 
     // Get the first curve's start point and tangent
-    const BezierShape &firstCurve = trackShapes.front();
-    sf::Vector2f end = firstCurve.getStartPoint();
-    sf::Vector2f startTangent = firstCurve.getStartTangent();
+    const TrackCurve &firstCurve = curves.front();
+    sf::Vector2f end = firstCurve.start;
+    sf::Vector2f startTangent = getCurveStartTangent(firstCurve);
 
     // Get the last curve's end point and tangent
-    const BezierShape &lastCurve = trackShapes.back();
-    sf::Vector2f start = lastCurve.getEndPoint();
-    sf::Vector2f endTangent = lastCurve.getEndTangent();
+    const TrackCurve &lastCurve = curves.back();
+    sf::Vector2f start = lastCurve.end;
+    sf::Vector2f endTangent = getCurveEndTangent(lastCurve);
 
     // Calculate the control point to ensure smooth connection
     // The control point needs to create tangents that match at both ends
@@ -144,17 +398,17 @@ void Track::addLoopClosingCurve(float width, int numSegments)
 
 sf::Vector2f Track::getStartPosition() const
 {
-    // Return the specific spawn position
-    return sf::Vector2f(350.0f, 220.0f);
+    // The spawn position (stored in track files, the built-in track uses 350, 220)
+    return startPosition;
 }
 
 float Track::getStartRotation() const
 {
-    if (trackShapes.empty())
-        return 0.0f; // Default rotation if no track shapes
+    if (curves.empty())
+        return 0.0f; // Default rotation if no curves
     
     // Get the tangent direction at the start of the first curve
-    sf::Vector2f startTangent = trackShapes.front().getStartTangent();
+    sf::Vector2f startTangent = getCurveStartTangent(curves.front());
     
     // Convert tangent to rotation angle in degrees
     float angle = std::atan2(startTangent.y, startTangent.x) * 180.0f / 3.14159f;
@@ -163,20 +417,18 @@ float Track::getStartRotation() const
 
 sf::FloatRect Track::getTrackBounds() const
 {
-    if (trackShapes.empty())
+    if (geometry.innerEdgePoints.empty() && geometry.outerEdgePoints.empty())
         return sf::FloatRect(sf::Vector2f(0.0f, 0.0f), sf::Vector2f(static_cast<float>(windowWidth), static_cast<float>(windowHeight)));
     
-    // Calculate bounds by finding min/max coordinates of all track shapes
+    // Calculate bounds by finding min/max coordinates of all edge points (every segment corner)
     float minX = std::numeric_limits<float>::max();
     float minY = std::numeric_limits<float>::max();
     float maxX = std::numeric_limits<float>::lowest();
     float maxY = std::numeric_limits<float>::lowest();
     
-    for (const auto& shape : trackShapes)
+    for (const auto *edgePoints : {&geometry.innerEdgePoints, &geometry.outerEdgePoints})
     {
-        // Get edge points from the shape
-        auto edgePoints = shape.getEdgePoints();
-        for (const auto& point : edgePoints)
+        for (const auto& point : *edgePoints)
         {
             minX = std::min(minX, point.x);
             minY = std::min(minY, point.y);
@@ -191,14 +443,14 @@ sf::FloatRect Track::getTrackBounds() const
                         sf::Vector2f((maxX - minX) + 2 * padding, (maxY - minY) + 2 * padding));
 }
 
-void Track::drawCheckeredFlag(sf::RenderWindow &window) const
+void Track::appendCheckeredFlag(sf::VertexArray &vertices) const
 {
-    if (trackShapes.empty())
+    if (curves.empty())
         return;
 
     // Get the start position and tangent of the first curve
-    sf::Vector2f startPos = trackShapes.front().getStartPoint();
-    sf::Vector2f startTangent = trackShapes.front().getStartTangent();
+    sf::Vector2f startPos = curves.front().start;
+    sf::Vector2f startTangent = getCurveStartTangent(curves.front());
 
     // Calculate perpendicular direction for the flag width
     sf::Vector2f perpendicular(-startTangent.y, startTangent.x);
@@ -210,42 +462,45 @@ void Track::drawCheckeredFlag(sf::RenderWindow &window) const
     // The startPos is now properly at the center of the track
     sf::Vector2f trackCenter = startPos;
 
-    // Draw squares in a grid pattern aligned with the track direction
+    // The square edges in world space (a square rotated to the tangent direction)
+    float angle = std::atan2(startTangent.y, startTangent.x);
+    sf::Vector2f sideX(std::cos(angle) * squareSize, std::sin(angle) * squareSize);
+    sf::Vector2f sideY(-sideX.y, sideX.x);
+
+    // Add squares in a grid pattern aligned with the track direction
     // Only 2 squares wide in the track direction, centered on startPos
     for (float along = -squareSize / 2.0f; along < squareSize * 1.5f; along += squareSize)
     {
         for (float across = -flagWidth / 2; across < flagWidth / 2; across += squareSize)
         {
-            sf::RectangleShape square;
-            square.setSize({squareSize, squareSize});
-
             // Calculate position using tangent and perpendicular vectors
             sf::Vector2f pos = trackCenter + startTangent * along + perpendicular * across;
-            square.setPosition({pos.x, pos.y});
-
-            // Calculate rotation angle from tangent
-            float angle = std::atan2(startTangent.y, startTangent.x) * 180.0f / 3.14159f;
-            square.setRotation(sf::degrees(angle));
 
             // Alternate black and white squares based on grid position
             int alongIndex = (int)((along + squareSize / 2.0f) / squareSize);
             int acrossIndex = (int)((across + flagWidth / 2) / squareSize);
             bool isBlack = (alongIndex + acrossIndex) % 2 == 0;
-            square.setFillColor(isBlack ? sf::Color::Black : sf::Color::White);
-
-            window.draw(square);
+            sf::Color color = isBlack ? sf::Color::Black : sf::Color::White;
+
+            // Two triangles per square
+            vertices.append(sf::Vertex{pos, color});
+            vertices.append(sf::Vertex{pos + sideX, color});
+            vertices.append(sf::Vertex{pos + sideX + sideY, color});
+            vertices.append(sf::Vertex{pos, color});
+            vertices.append(sf::Vertex{pos + sideX + sideY, color});
+            vertices.append(sf::Vertex{pos + sideY, color});
         }
     }
 }
 
 sf::FloatRect Track::getCheckeredFlagBounds() const
 {
-    if (trackShapes.empty())
-        return sf::FloatRect(sf::Vector2f(350.0f, 220.0f), sf::Vector2f(40.0f, trackWidth));
+    if (curves.empty())
+        return sf::FloatRect(startPosition, sf::Vector2f(40.0f, trackWidth));
 
     // Get the start position and tangent of the first curve
-    sf::Vector2f startPos = trackShapes.front().getStartPoint();
-    sf::Vector2f startTangent = trackShapes.front().getStartTangent();
+    sf::Vector2f startPos = curves.front().start;
+    sf::Vector2f startTangent = getCurveStartTangent(curves.front());
 
     // Calculate perpendicular direction for the flag width
     sf::Vector2f perpendicular(-startTangent.y, startTangent.x);
@@ -271,102 +526,13 @@ sf::FloatRect Track::getCheckeredFlagBounds() const
 
 // void Track::drawBezierPoints(sf::RenderWindow &window)
 
-void Track::drawTrackEdges(sf::RenderWindow &window) const
-{
-    // Draw edge circles for each BezierShape
-    for (const auto &shape : trackShapes)
-    {
-        shape.drawEdgeCircles(window);
-    }
-}
-
 std::vector<sf::Vector2f> Track::getAllEdgePoints() const
 {
+    // Every segment corner: the inner edge points, then the outer edge points
     std::vector<sf::Vector2f> allEdgePoints;
-
-    // Collect edge points from all track shapes
-    for (const auto &shape : trackShapes)
-    {
-        std::vector<sf::Vector2f> shapeEdgePoints = shape.getEdgePoints();
-        allEdgePoints.insert(allEdgePoints.end(), shapeEdgePoints.begin(), shapeEdgePoints.end());
-    }
+    allEdgePoints.reserve(geometry.innerEdgePoints.size() + geometry.outerEdgePoints.size());
+    allEdgePoints.insert(allEdgePoints.end(), geometry.innerEdgePoints.begin(), geometry.innerEdgePoints.end());
+    allEdgePoints.insert(allEdgePoints.end(), geometry.outerEdgePoints.begin(), geometry.outerEdgePoints.end());
 
     return allEdgePoints;
 }
-
-std::vector<sf::Vector2f> Track::getInnerEdgePoints() const
-{
-    std::vector<sf::Vector2f> allInnerEdgePoints;
-
-    // Collect inner edge points from all track shapes
-    for (const auto &shape : trackShapes)
-    {
-        std::vector<sf::Vector2f> shapeInnerEdgePoints = shape.getInnerEdgePoints();
-        allInnerEdgePoints.insert(allInnerEdgePoints.end(), shapeInnerEdgePoints.begin(), shapeInnerEdgePoints.end());
-    }
-
-    return allInnerEdgePoints;
-}
-
-std::vector<sf::Vector2f> Track::getOuterEdgePoints() const
-{
-    std::vector<sf::Vector2f> allOuterEdgePoints;
-
-    // Collect outer edge points from all track shapes
-    for (const auto &shape : trackShapes)
-    {
-        std::vector<sf::Vector2f> shapeOuterEdgePoints = shape.getOuterEdgePoints();
-        allOuterEdgePoints.insert(allOuterEdgePoints.end(), shapeOuterEdgePoints.begin(), shapeOuterEdgePoints.end());
-    }
-
-    return allOuterEdgePoints;
-}
-
-std::vector<SegmentData> Track::getCheckpointSegments() const
-{
-    std::vector<SegmentData> allCheckpointSegments;
-
-    // Collect checkpoint segments from all track shapes
-    for (const auto &shape : trackShapes)
-    {
-        const auto &shapeSegments = shape.getCheckpointSegments();
-        allCheckpointSegments.insert(allCheckpointSegments.end(), shapeSegments.begin(), shapeSegments.end());
-    }
-
-    return allCheckpointSegments;
-}
-
-void Track::saveCheckpointSegmentsToBinaryFile(const std::string &filename) const
-{
-    std::ofstream file(filename, std::ios::binary);
-    if (!file.is_open())
-    {
-        // Failed to open binary file silently
-        return;
-    }
-
-    // Write number of track shapes
-    size_t numShapes = trackShapes.size();
-    file.write(reinterpret_cast<const char *>(&numShapes), sizeof(numShapes));
-
-    // Write segments from each track shape
-    for (const auto &shape : trackShapes)
-    {
-        const auto &checkpointSegments = shape.getCheckpointSegments();
-        size_t numSegments = checkpointSegments.size();
-        file.write(reinterpret_cast<const char *>(&numSegments), sizeof(numSegments));
-
-        for (const auto &segment : checkpointSegments)
-        {
-            file.write(reinterpret_cast<const char *>(&segment.position.x), sizeof(float));
-            file.write(reinterpret_cast<const char *>(&segment.position.y), sizeof(float));
-            file.write(reinterpret_cast<const char *>(&segment.size.x), sizeof(float));
-            file.write(reinterpret_cast<const char *>(&segment.size.y), sizeof(float));
-            file.write(reinterpret_cast<const char *>(&segment.rotation), sizeof(float));
-            file.write(reinterpret_cast<const char *>(&segment.segmentIndex), sizeof(int));
-        }
-    }
-
-    file.close();
-    std::cout << "Checkpoint segments saved to binary file: " << filename << std::endl;
-}
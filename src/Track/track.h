@@ -1,20 +1,121 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 #include <vector>
+#include <string>
 #include "../BezierShape/BezierShape.h"
 #include "../Interfaces/IRenderable.h"
+#include "EdgeGrid.h"
+
+// One quadratic Bezier curve of the track (what a track file stores)
+struct TrackCurve
+{
+    sf::Vector2f start;
+    sf::Vector2f control;
+    sf::Vector2f end;
+    float width;
+    int numSegments;
+};
+
+// Geometry the simulation needs, derived from the curves once (or loaded from a baked track file)
+struct TrackGeometry
+{
+    std::vector<sf::Vector2f> innerEdgePoints; // Pairs per segment, see BezierShape::getInnerEdgePoints
+    std::vector<sf::Vector2f> outerEdgePoints;
+    std::vector<SegmentData> checkpointSegments;
+    EdgeGrid innerGrid; // Over innerEdgePoints
+    EdgeGrid outerGrid; // Over outerEdgePoints
+};
 
 class Track : public IRenderable
 {
 private:
-    std::vector<BezierShape> trackShapes;
+    std::vector<TrackCurve> curves;
+    TrackGeometry geometry;
+    sf::Vector2f startPosition;
+
+    // Segment rectangles for drawing, only built when the track is first drawn
+    // (a track loaded with baked geometry never needs them for simulating)
+    mutable std::vector<BezierShape> trackShapes;
+    mutable bool shapesDirty;
     unsigned int windowWidth;
     unsigned int windowHeight;
     float trackWidth;
 
+    // Levels of detail: full segments with edge circles, then simplified strips for zoomed out views
+    static const int LodLevels = 3;
+
+    // Vertex ranges of one curve in the baked geometry, used to skip curves outside the view
+    struct TrackChunk
+    {
+        sf::FloatRect bounds;
+        std::size_t surfaceFirst[LodLevels];
+        std::size_t surfaceCount[LodLevels];
+        std::size_t edgeFirst; // Edge circles (full detail only)
+        std::size_t edgeCount;
+    };
+
+    // The static track (all detail levels, checkered flag, edge circles) baked into one triangle list
+    // Layout: [surfaces of every level][checkered flag][edge circles], rebuilt lazily when curves are added
+    mutable sf::VertexArray bakedVertices;
+    mutable sf::VertexBuffer bakedBuffer;
+    mutable bool useVertexBuffer;
+    mutable bool bakeDirty;
+    mutable std::vector<TrackChunk> chunks;
+    mutable std::size_t flagFirst;
+    mutable std::size_t flagCount;
+    mutable std::size_t drawnVertexCount; // Vertices drawn by the last draw call
+
+    // Build the baked geometry (and upload it to the GPU if vertex buffers are available)
+    void bake() const;
+
+    // Level of detail for the target's current zoom
+    int selectLod(const sf::RenderTarget &target) const;
+
+    // Draw a vertex range of the baked geometry
+    void drawRange(sf::RenderTarget &target, std::size_t first, std::size_t count) const;
+
+    // Append the checkered flag squares at the start line as triangles
+    void appendCheckeredFlag(sf::VertexArray &vertices) const;
+
+    // Build the segment rectangles of every curve (if the curves changed)
+    void buildShapes() const;
+
+    // Derive the edge points, checkpoint gates and edge grids from the shapes
+    void computeGeometry();
+
+    // Append one shape's edge points and checkpoint gates
+    void appendGeometry(const BezierShape &shape);
+
+    // Rebuild the edge grids after the edge points changed
+    void buildEdgeGrids();
+
+    // Cell size of the edge grids, a car's collision circle touches at most four cells
+    static constexpr float EdgeGridCellSize = 50.0f;
+
+    // Tangents of a curve at its ends
+    static sf::Vector2f getCurveStartTangent(const TrackCurve &curve);
+    static sf::Vector2f getCurveEndTangent(const TrackCurve &curve);
+
 public:
+    // Starts empty, add curves or call createDefaultLayout() or loadFromFile()
     Track(unsigned int width, unsigned int height);
-    void draw(sf::RenderWindow &window) const override;
+
+    // The built-in track
+    void createDefaultLayout();
+
+    // Replace the track with one from a track file (see TrackFile), uses its baked geometry if present
+    // Returns false and keeps the current track if the file can't be read
+    // Don't call while another thread draws the track
+    bool loadFromFile(const std::string &path);
+
+    // Write the track as a track file, with the baked geometry unless includeBaked is false
+    bool saveToFile(const std::string &path, bool includeBaked = true) const;
+
+    // Draw the curves inside the target's view, simplified when zoomed out
+    void draw(sf::RenderTarget &target) const override;
+
+    // The track is in world coordinates (the camera maps it to the window), the size is only the fallback bounds
     void setWindowSize(unsigned int width, unsigned int height);
 
     // Create a curved track segment using BezierShape
@@ -31,6 +132,7 @@ public:
 
     // Get the start position for the car (checkered flag position)
     sf::Vector2f getStartPosition() const;
+    void setStartPosition(sf::Vector2f position) { startPosition = position; }
 
     // Get the start rotation for the car (direction of the track at start)
     float getStartRotation() const;
@@ -38,31 +140,35 @@ public:
     // Get track bounds for collision detection
     sf::FloatRect getTrackBounds() const;
 
-    // Draw the checkered flag at the start line
-    void drawCheckeredFlag(sf::RenderWindow &window) const;
-
     // Draw red circles at Bezier curve points for debugging
-    void drawBezierPoints(sf::RenderWindow &window) const;
+    void drawBezierPoints(sf::RenderTarget &target) const;
+
+    // Number of vertices in the baked track (all detail levels)
+    std::size_t getBakedVertexCount() const;
 
-    // Draw black circles at track edges
-    void drawTrackEdges(sf::RenderWindow &window) const;
+    // Number of vertices drawn the last time the track was drawn (after culling and level of detail)
+    std::size_t getDrawnVertexCount() const { return drawnVertexCount; }
 
     // Get all edge points for collision detection
     std::vector<sf::Vector2f> getAllEdgePoints() const;
 
-    // Get inner and outer edge points separately
-    std::vector<sf::Vector2f> getInnerEdgePoints() const;
-    std::vector<sf::Vector2f> getOuterEdgePoints() const;
+    // Get inner and outer edge points separately (precomputed, no copies)
+    const std::vector<sf::Vector2f> &getInnerEdgePoints() const { return geometry.innerEdgePoints; }
+    const std::vector<sf::Vector2f> &getOuterEdgePoints() const { return geometry.outerEdgePoints; }
+
+    // Grids over the inner and outer edge points for nearby point queries
+    const EdgeGrid &getInnerEdgeGrid() const { return geometry.innerGrid; }
+    const EdgeGrid &getOuterEdgeGrid() const { return geometry.outerGrid; }
 
     // Get checkered flag bounds for collision detection
     sf::FloatRect getCheckeredFlagBounds() const;
 
-    // Get checkpoint segments data from all track shapes
-    std::vector<SegmentData> getCheckpointSegments() const;
+    // Get checkpoint segments data from all curves
+    const std::vector<SegmentData> &getCheckpointSegments() const { return geometry.checkpointSegments; }
 
-    // Save checkpoint segments to a text file
-    void saveCheckpointSegmentsToFile(const std::string &filename) const;
+    const std::vector<TrackCurve> &getCurves() const { return curves; }
+    const TrackGeometry &getGeometry() const { return geometry; }
 
-    // Save checkpoint segments to a binary file (more efficient)
-    void saveCheckpointSegmentsToBinaryFile(const std::string &filename) const;
+    // Identifies the layout, replays recorded on another layout can't be played back on this one
+    std::uint32_t getLayoutId() const;
 };
@@ -1,11 +1,11 @@
 #include "Button.h"
-#include <iostream>
+#include "../Logging/Logger.h"
 
 Button::Button(const std::string &label, float x, float y, float width, float height)
     : label(label), isHovered(false), isPressed(false),
       baseColor(100, 100, 100), hoverColor(120, 120, 120), pressedColor(80, 80, 80)
 {
-    std::cout << "Creating button: " << label << std::endl;
+    LOG_TRACE("Creating button: " << label);
 
     // Set up the button shape
     shape.setSize(sf::Vector2f(width, height));
@@ -14,7 +14,7 @@ Button::Button(const std::string &label, float x, float y, float width, float he
     shape.setOutlineColor(sf::Color::Black);
     shape.setOutlineThickness(2.0f);
 
-    std::cout << "Button constructor completed for: " << label << std::endl;
+    LOG_TRACE("Button constructor completed for: " << label);
 }
 
 void Button::handleEvent(const sf::Event &event, const sf::Vector2f &mousePos)
@@ -59,9 +59,9 @@ void Button::update(const sf::Vector2f &mousePos)
     }
 }
 
-void Button::draw(sf::RenderWindow &window) const
+void Button::draw(sf::RenderTarget &target) const
 {
-    window.draw(shape);
+    target.draw(shape);
 }
 
 void Button::setPosition(float x, float y)
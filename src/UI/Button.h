@@ -28,7 +28,7 @@ public:
     void update(const sf::Vector2f& mousePos);
     
     // Draw the button
-    void draw(sf::RenderWindow& window) const;
+    void draw(sf::RenderTarget& target) const;
     
     // Getters
     sf::FloatRect getBounds() const { return shape.getGlobalBounds(); }
@@ -0,0 +1,200 @@
+#include "HudRenderer.h"
+#include "../Logging/Logger.h"
+#include <algorithm>
+
+HudRenderer::HudRenderer(const std::string &fontPath, unsigned int atlasSize)
+    : fontLoaded(false), atlasSize(atlasSize), vertices(sf::PrimitiveType::Triangles), batchDirty(true)
+{
+    if (font.openFromFile(fontPath))
+    {
+        fontLoaded = true;
+    }
+    else
+    {
+        LOG_WARNING("Failed to load HUD font " << fontPath);
+    }
+}
+
+int HudRenderer::addLabel(unsigned int characterSize, sf::Color fillColor, sf::Color outlineColor, float outlineThickness)
+{
+    Label label;
+    label.position = sf::Vector2f(0.0f, 0.0f);
+    label.characterSize = characterSize;
+    label.fillColor = fillColor;
+    label.outlineColor = outlineColor;
+    label.outlineThickness = outlineThickness;
+    label.visible = true;
+    label.dirty = false;
+    labels.push_back(label);
+    return static_cast<int>(labels.size()) - 1;
+}
+
+void HudRenderer::setText(int id, const std::string &text)
+{
+    Label &label = labels[id];
+    if (label.text == text)
+        return;
+
+    label.text = text;
+    label.dirty = true;
+    batchDirty = true;
+}
+
+void HudRenderer::setPosition(int id, const sf::Vector2f &position)
+{
+    Label &label = labels[id];
+    if (label.position == position)
+        return;
+
+    label.position = position;
+    label.dirty = true;
+    batchDirty = true;
+}
+
+void HudRenderer::setVisible(int id, bool visible)
+{
+    Label &label = labels[id];
+    if (label.visible == visible)
+        return;
+
+    label.visible = visible;
+    batchDirty = true;
+}
+
+sf::Vector2f HudRenderer::getLabelSize(int id)
+{
+    Label &label = labels[id];
+    if (label.dirty)
+    {
+        layoutLabel(label);
+    }
+
+    if (label.quads.empty())
+        return sf::Vector2f(0.0f, 0.0f);
+
+    // Bounds of the cached quads
+    float minX = label.quads[0].position.x, maxX = minX;
+    float minY = label.quads[0].position.y, maxY = minY;
+    for (const auto &vertex : label.quads)
+    {
+        minX = std::min(minX, vertex.position.x);
+        maxX = std::max(maxX, vertex.position.x);
+        minY = std::min(minY, vertex.position.y);
+        maxY = std::max(maxY, vertex.position.y);
+    }
+    return sf::Vector2f(maxX - minX, maxY - minY);
+}
+
+void HudRenderer::layoutLabel(Label &label) const
+{
+    label.quads.clear();
+    label.dirty = false;
+
+    if (!fontLoaded || label.text.empty())
+        return;
+
+    // Outline glyphs go underneath the fill glyphs, like sf::Text
+    if (label.outlineThickness > 0.0f)
+    {
+        appendGlyphs(label, label.outlineThickness, label.outlineColor);
+    }
+    appendGlyphs(label, 0.0f, label.fillColor);
+}
+
+void HudRenderer::appendGlyphs(Label &label, float outlineThickness, sf::Color color) const
+{
+    // Glyphs are taken from the shared atlas size and scaled to the label size
+    float scale = static_cast<float>(label.characterSize) / atlasSize;
+    float atlasOutline = outlineThickness / scale;
+    float lineSpacing = font.getLineSpacing(atlasSize);
+
+    // Same layout rules as sf::Text: the first baseline is one character size down
+    float x = 0.0f;
+    float y = static_cast<float>(atlasSize);
+    char32_t previous = 0;
+
+    for (unsigned char c : label.text)
+    {
+        char32_t codePoint = c;
+
+        // Kerning between this and the previous character
+        if (previous != 0)
+        {
+            x += font.getKerning(previous, codePoint, atlasSize);
+        }
+        previous = codePoint;
+
+        // Whitespace only moves the pen
+        if (codePoint == '\n')
+        {
+            x = 0.0f;
+            y += lineSpacing;
+            previous = 0;
+            continue;
+        }
+        if (codePoint == ' ' || codePoint == '\t')
+        {
+            float spaceAdvance = font.getGlyph(U' ', atlasSize, false).advance;
+            x += codePoint == '\t' ? spaceAdvance * 4.0f : spaceAdvance;
+            continue;
+        }
+
+        const sf::Glyph &glyph = font.getGlyph(codePoint, atlasSize, false, atlasOutline);
+
+        float left = label.position.x + (x + glyph.bounds.position.x) * scale;
+        float top = label.position.y + (y + glyph.bounds.position.y) * scale;
+        float right = left + glyph.bounds.size.x * scale;
+        float bottom = top + glyph.bounds.size.y * scale;
+
+        float u1 = static_cast<float>(glyph.textureRect.position.x);
+        float v1 = static_cast<float>(glyph.textureRect.position.y);
+        float u2 = u1 + glyph.textureRect.size.x;
+        float v2 = v1 + glyph.textureRect.size.y;
+
+        // Two triangles per glyph
+        label.quads.push_back(sf::Vertex{{left, top}, color, {u1, v1}});
+        label.quads.push_back(sf::Vertex{{right, top}, color, {u2, v1}});
+        label.quads.push_back(sf::Vertex{{left, bottom}, color, {u1, v2}});
+        label.quads.push_back(sf::Vertex{{left, bottom}, color, {u1, v2}});
+        label.quads.push_back(sf::Vertex{{right, top}, color, {u2, v1}});
+        label.quads.push_back(sf::Vertex{{right, bottom}, color, {u2, v2}});
+
+        x += glyph.advance;
+    }
+}
+
+void HudRenderer::draw(sf::RenderTarget &target) const
+{
+    if (!fontLoaded)
+        return;
+
+    // Only changed labels are laid out again, then the batch is concatenated
+    if (batchDirty)
+    {
+        vertices.clear();
+        for (auto &label : labels)
+        {
+            if (label.dirty)
+            {
+                layoutLabel(label);
+            }
+            if (!label.visible)
+                continue;
+
+            for (const auto &vertex : label.quads)
+            {
+                vertices.append(vertex);
+            }
+        }
+        batchDirty = false;
+    }
+
+    if (vertices.getVertexCount() == 0)
+        return;
+
+    // All HUD text in one draw call, in screen coordinates
+    sf::View view = target.getView();
+    target.setView(sf::View(sf::FloatRect(sf::Vector2f(0.0f, 0.0f), sf::Vector2f(target.getSize()))));
+    target.draw(vertices, sf::RenderStates(&font.getTexture(atlasSize)));
+    target.setView(view);
+}
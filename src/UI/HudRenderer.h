@@ -0,0 +1,59 @@
+#pragma once
+#include "../Interfaces/IRenderable.h"
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+
+// Batched HUD text: all labels share one font and one glyph atlas and are drawn with a single draw call
+// A label is only laid out again when its text, position or style changes
+class HudRenderer : public IRenderable
+{
+private:
+    struct Label
+    {
+        std::string text;
+        sf::Vector2f position;
+        unsigned int characterSize;
+        sf::Color fillColor;
+        sf::Color outlineColor;
+        float outlineThickness;
+        bool visible;
+        bool dirty;                    // Needs a new layout
+        std::vector<sf::Vertex> quads; // Cached glyph triangles (outline first, then fill)
+    };
+
+    sf::Font font;
+    bool fontLoaded;
+    unsigned int atlasSize; // All glyphs come from this character size and are scaled per label
+
+    mutable std::vector<Label> labels; // Layouts are cached lazily in draw()
+    mutable sf::VertexArray vertices; // All visible labels, rebuilt only when a label changed
+    mutable bool batchDirty;
+
+    // Build the glyph triangles of one label
+    void layoutLabel(Label &label) const;
+
+    // Append the glyph quads of a string to the label, scaled from the atlas size
+    void appendGlyphs(Label &label, float outlineThickness, sf::Color color) const;
+
+public:
+    HudRenderer(const std::string &fontPath = "../../Fonts/ARIAL.TTF", unsigned int atlasSize = 24);
+
+    bool isFontLoaded() const { return fontLoaded; }
+    const sf::Font &getFont() const { return font; }
+
+    // Register a label and return its id
+    int addLabel(unsigned int characterSize, sf::Color fillColor,
+                 sf::Color outlineColor = sf::Color::Black, float outlineThickness = 0.0f);
+
+    // Change a label (no work if the value is the same as before)
+    void setText(int id, const std::string &text);
+    void setPosition(int id, const sf::Vector2f &position);
+    void setVisible(int id, bool visible);
+
+    // Size of the laid out text of a label (in pixels)
+    sf::Vector2f getLabelSize(int id);
+
+    // IRenderable interface implementation
+    void draw(sf::RenderTarget &target) const override;
+};
@@ -1,25 +1,25 @@
 #include "UIManager.h"
-#include <iostream>
+#include "../Logging/Logger.h"
 
 UIManager::UIManager() : fontLoaded(false)
 {
 }
 
-void UIManager::initialize()
+void UIManager::initialize(const std::string &fontPath)
 {
-    std::cout << "UIManager::initialize() started" << std::endl;
+    LOG_DEBUG("UIManager::initialize() started");
     
     // Load font
     if (!fontLoaded)
     {
-        if (font.openFromFile("../../Fonts/ARIAL.TTF"))
+        if (font.openFromFile(fontPath))
         {
             fontLoaded = true;
-            std::cout << "UIManager font loaded successfully" << std::endl;
+            LOG_TRACE("UIManager font loaded successfully");
         }
         else
         {
-            std::cout << "UIManager font loading failed" << std::endl;
+            LOG_WARNING("UIManager font loading failed");
             // Font loading failed silently
         }
     }
@@ -27,24 +27,24 @@ void UIManager::initialize()
     // Create buttons
     buttons.clear();
     buttonLabels.clear();
-    std::cout << "Creating buttons..." << std::endl;
+    LOG_TRACE("Creating buttons...");
 
     // Start button (Green)
-    std::cout << "Creating Start button..." << std::endl;
+    LOG_TRACE("Creating Start button...");
     buttons.emplace_back("", 10.0f, 10.0f, 80.0f, 30.0f); // Empty label since we'll use separate text
-    std::cout << "Start button created, setting colors..." << std::endl;
+    LOG_TRACE("Start button created, setting colors...");
     buttons[0].setColors(sf::Color(50, 150, 50), sf::Color(70, 170, 70), sf::Color(30, 130, 30));
 
     // Pause button (Red)
-    std::cout << "Creating Pause button..." << std::endl;
+    LOG_TRACE("Creating Pause button...");
     buttons.emplace_back("", 100.0f, 10.0f, 80.0f, 30.0f); // Empty label since we'll use separate text
-    std::cout << "Pause button created, setting colors..." << std::endl;
+    LOG_TRACE("Pause button created, setting colors...");
     buttons[1].setColors(sf::Color(150, 50, 50), sf::Color(170, 70, 70), sf::Color(130, 30, 30));
 
     // Save button (Blue)
-    std::cout << "Creating Save button..." << std::endl;
+    LOG_TRACE("Creating Save button...");
     buttons.emplace_back("", 190.0f, 10.0f, 80.0f, 30.0f); // Empty label since we'll use separate text
-    std::cout << "Save button created, setting colors..." << std::endl;
+    LOG_TRACE("Save button created, setting colors...");
     buttons[2].setColors(sf::Color(50, 50, 150), sf::Color(70, 70, 170), sf::Color(30, 30, 130));
 
     // Create button labels if font is loaded
@@ -74,18 +74,18 @@ void UIManager::initialize()
         saveLabel.setPosition(sf::Vector2f(205, 18)); // Position over the Save button
         buttonLabels.push_back(saveLabel);
         
-        std::cout << "Button labels created successfully" << std::endl;
+        LOG_TRACE("Button labels created successfully");
     }
     else
     {
-        std::cout << "No font loaded, buttons will have no labels" << std::endl;
+        LOG_WARNING("No font loaded, buttons will have no labels");
     }
 
     // Initially disable Pause and Save buttons
     setStopEnabled(false);
     setSaveEnabled(false);
     
-    std::cout << "UIManager::initialize() completed" << std::endl;
+    LOG_DEBUG("UIManager::initialize() completed");
 }
 
 void UIManager::handleEvent(const sf::Event &event, const sf::Vector2f &mousePos)
@@ -104,18 +104,18 @@ void UIManager::update(const sf::Vector2f &mousePos)
     }
 }
 
-void UIManager::draw(sf::RenderWindow &window) const
+void UIManager::draw(sf::RenderTarget &target) const
 {
     // Draw buttons
     for (const auto &button : buttons)
     {
-        button.draw(window);
+        button.draw(target);
     }
     
     // Draw button labels
     for (const auto &label : buttonLabels)
     {
-        window.draw(label);
+        target.draw(label);
     }
 }
 
@@ -3,6 +3,7 @@
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <functional>
+#include <string>
 
 class UIManager
 {
@@ -16,7 +17,7 @@ public:
     UIManager();
     
     // Initialize UI elements
-    void initialize();
+    void initialize(const std::string &fontPath = "../../Fonts/ARIAL.TTF");
     
     // Handle input events
     void handleEvent(const sf::Event& event, const sf::Vector2f& mousePos);
@@ -25,7 +26,7 @@ public:
     void update(const sf::Vector2f& mousePos);
     
     // Draw UI elements
-    void draw(sf::RenderWindow& window) const;
+    void draw(sf::RenderTarget& target) const;
     
     // Button callbacks
     void setStartCallback(std::function<void()> callback);
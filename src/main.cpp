@@ -1,26 +1,25 @@
-#include <SFML/Graphics.hpp>
 #include <iostream>
-#include "Game/Game.h"
+#include "Game/BatchRunner.h"
+#include "Game/CommandLine.h"
 
-using namespace sf;
-using namespace std;
-
-int main()
+int main(int argc, char *argv[])
 {
-    unsigned int windowWidth = 2560;
-    unsigned int windowHeight = 1440;
+    CommandLine commandLine;
+    if (!commandLine.parse(argc, argv))
+    {
+        std::cerr << "RaceCar --help lists the commands and options" << std::endl;
+        return 1;
+    }
 
     try
     {
-        // Create and run the game
-        Game game(windowWidth, windowHeight);
-        game.run();
+        // Create and run the game (or one batch command, see CommandLine::getUsage)
+        BatchRunner runner(commandLine);
+        return runner.run();
     }
     catch (const std::exception &e)
     {
         std::cerr << "Error: " << e.what() << std::endl;
         return 1;
     }
-
-    return 0;
-}
\ No newline at end of file
+}